@@ -87,9 +87,14 @@ recompute path. Also, it enables more complicated dependencies beyond trees.
 #include <unordered_set>
 #include <unordered_map>
 #include <random>
+#include <mutex>
+#include <condition_variable>
 
 #include <QCoreApplication>
 #include <QCryptographicHash>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
 
 #include "AutoTransaction.h"
 #include "Document.h"
@@ -162,6 +167,35 @@ namespace App {
 
 static bool _IsRestoring;
 static bool _IsRelabeling;
+
+// Property change notification issued inside a parallel recompute worker
+// thread. It is queued and signaled later by the calling thread, see
+// Document::_recomputeParallel().
+struct RecomputeNotification {
+    const TransactionalObject *obj;
+    const Property *prop;
+    bool before;
+
+    RecomputeNotification(const TransactionalObject *o, const Property *p, bool b)
+        :obj(o),prop(p),before(b)
+    {}
+};
+static thread_local std::vector<RecomputeNotification> *_RecomputeNotifications;
+
+// Change of the in-list of an object by a link property set in a parallel
+// recompute worker thread. The dependency graph is only changed by the
+// calling thread, see Document::_recomputeParallel().
+struct RecomputeBackLink {
+    DocumentObject *obj;
+    DocumentObject *link;
+    bool add;
+
+    RecomputeBackLink(DocumentObject *o, DocumentObject *l, bool a)
+        :obj(o),link(l),add(a)
+    {}
+};
+static thread_local std::vector<RecomputeBackLink> *_RecomputeBackLinks;
+
 // Pimpl class
 struct DocumentP
 {
@@ -184,6 +218,8 @@ struct DocumentP
     unsigned int UndoMemSize;
     unsigned int UndoMaxStackSize;
     std::string programVersion;
+    // data files of the project file that are restored on demand
+    std::shared_ptr<Base::DeferredFiles> deferredFiles;
 #ifdef USE_OLD_DAG
     DependencyList DepList;
     std::map<DocumentObject*,Vertex> VertexObjectList;
@@ -191,6 +227,8 @@ struct DocumentP
 #endif //USE_OLD_DAG
     std::multimap<const App::DocumentObject*, 
         std::unique_ptr<App::DocumentObjectExecReturn> > _RecomputeLog;
+    // guards the recompute log and undo transaction against parallel recompute workers
+    std::mutex recomputeMutex;
 
     DocumentP() {
         static std::random_device _RD;
@@ -228,6 +266,7 @@ struct DocumentP
             delete returnCode;
             return;
         }
+        std::lock_guard<std::mutex> guard(recomputeMutex);
         _RecomputeLog.emplace(returnCode->Which, std::unique_ptr<DocumentObjectExecReturn>(returnCode));
         returnCode->Which->setStatus(ObjectStatus::Error,true);
     }
@@ -973,6 +1012,7 @@ bool Document::undo(int id)
 
         // save the redo
         mRedoMap[d->activeUndoTransaction->getID()] = d->activeUndoTransaction;
+        d->activeUndoTransaction->commitMemSize();
         mRedoTransactions.push_back(d->activeUndoTransaction);
         d->activeUndoTransaction = 0;
 
@@ -1023,6 +1063,7 @@ bool Document::redo(int id)
         mRedoTransactions.back()->apply(*this,true);
 
         mUndoMap[d->activeUndoTransaction->getID()] = d->activeUndoTransaction;
+        d->activeUndoTransaction->commitMemSize();
         mUndoTransactions.push_back(d->activeUndoTransaction);
         d->activeUndoTransaction = 0;
 
@@ -1232,6 +1273,7 @@ void Document::_commitTransaction(bool notify)
         Base::FlagToggler<> flag(d->committing);
         Application::TransactionSignaller signaller(false,true);
         int id = d->activeUndoTransaction->getID();
+        d->activeUndoTransaction->commitMemSize();
         mUndoTransactions.push_back(d->activeUndoTransaction);
         d->activeUndoTransaction = 0;
         // check the stack for the limits
@@ -1240,6 +1282,19 @@ void Document::_commitTransaction(bool notify)
             delete mUndoTransactions.front();
             mUndoTransactions.pop_front();
         }
+        if(d->UndoMemSize) {
+            // drop the oldest transactions until the memory limit is kept,
+            // but never the one just committed
+            std::size_t total = 0;
+            for(auto transaction : mUndoTransactions)
+                total += transaction->getMemSize();
+            while(total > d->UndoMemSize && mUndoTransactions.size() > 1) {
+                total -= mUndoTransactions.front()->getMemSize();
+                mUndoMap.erase(mUndoTransactions.front()->getID());
+                delete mUndoTransactions.front();
+                mUndoTransactions.pop_front();
+            }
+        }
         signalCommitTransaction(*this);
 
         // closeActiveTransaction() may call again _commitTransaction()
@@ -1436,7 +1491,12 @@ int Document::getUndoMode(void) const
 
 unsigned int Document::getUndoMemSize (void) const
 {
-    return d->UndoMemSize;
+    unsigned int size = 0;
+    for (auto transaction : mUndoTransactions)
+        size += transaction->getMemSize();
+    for (auto transaction : mRedoTransactions)
+        size += transaction->getMemSize();
+    return size;
 }
 
 void Document::setUndoLimit(unsigned int UndoMemSize)
@@ -1507,18 +1567,37 @@ void Document::onChanged(const Property* prop)
 
 void Document::onBeforeChangeProperty(const TransactionalObject *Who, const Property *What)
 {
-    if(Who->isDerivedFrom(App::DocumentObject::getClassTypeId()))
+    if(_RecomputeNotifications)
+        _RecomputeNotifications->emplace_back(Who,What,true);
+    else if(Who->isDerivedFrom(App::DocumentObject::getClassTypeId()))
         signalBeforeChangeObject(*static_cast<const App::DocumentObject*>(Who), *What);
     if(!d->rollback && !_IsRelabeling) {
+        std::lock_guard<std::mutex> guard(d->recomputeMutex);
         _checkTransaction(0,What,__LINE__);
         if (d->activeUndoTransaction)
             d->activeUndoTransaction->addObjectChange(Who,What);
     }
 }
 
+bool Document::isRecomputeWorker()
+{
+    return _RecomputeNotifications != 0;
+}
+
+bool Document::queueBackLink(DocumentObject *obj, DocumentObject *link, bool add)
+{
+    if(!_RecomputeBackLinks)
+        return false;
+    _RecomputeBackLinks->emplace_back(obj,link,add);
+    return true;
+}
+
 void Document::onChangedProperty(const DocumentObject *Who, const Property *What)
 {
-    signalChangedObject(*Who, *What);
+    if(_RecomputeNotifications)
+        _RecomputeNotifications->emplace_back(Who,What,false);
+    else
+        signalChangedObject(*Who, *What);
 }
 
 void Document::setTransactionMode(int iMode)
@@ -2593,6 +2672,12 @@ bool Document::saveToFile(const char* filename) const
 {
     signalStartSave(*this, filename);
 
+    // the data must be restored before the project file may be overwritten
+    if (d->deferredFiles) {
+        d->deferredFiles->restoreAll();
+        d->deferredFiles.reset();
+    }
+
     auto hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
     int compression = hGrp->GetInt("CompressionLevel",3);
     compression = Base::clamp<int>(compression, Z_NO_COMPRESSION, Z_BEST_COMPRESSION);
@@ -2705,6 +2790,7 @@ void Document::restore (const char *filename,
     Base::FlagToggler<> flag(_IsRestoring,false);
 
     setStatus(Document::PartialDoc,false);
+    d->deferredFiles.reset();
 
     d->clearRecomputeLog();
     d->objectArray.clear();
@@ -2734,9 +2820,20 @@ void Document::restore (const char *filename,
     if (!reader.isValid())
         throw Base::FileException("Error reading compression file",filename);
 
+    // Shapes, meshes and point clouds may be restored when they are accessed.
+    // The Gui switches this off as it needs all data to display the document.
+    ParameterGrp::handle hGrp = GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Document");
+    setStatus(Document::LazyLoading, hGrp->GetBool("LazyLoading", false));
+
     GetApplication().signalStartRestoreDocument(*this);
     setStatus(Document::Restoring, true);
 
+    if (testStatus(Document::LazyLoading)) {
+        d->deferredFiles = std::make_shared<Base::DeferredFiles>(filename);
+        reader.setDeferredFiles(d->deferredFiles);
+    }
+
     d->partialLoadObjects.clear();
     for(auto &name : objNames)
         d->partialLoadObjects.emplace(name,true);
@@ -2757,6 +2854,10 @@ void Document::restore (const char *filename,
     signalRestoreDocument(reader);
     reader.readFiles(zipstream);
 
+    // don't keep the archive open if nothing has been deferred
+    if (d->deferredFiles && !d->deferredFiles->hasPending())
+        d->deferredFiles.reset();
+
     if (reader.testStatus(Base::XMLReader::ReaderStatus::PartialRestore)) {
         setStatus(Document::PartialRestore, true);
         Base::Console().Error("There were errors while loading the file. Some data might have been modified or not recovered at all. Look above for more specific information about the objects involved.\n");
@@ -3106,11 +3207,12 @@ std::vector<App::DocumentObject*> Document::getDependencyList(
     const std::vector<App::DocumentObject*>& objectArray, int options)
 {
     std::vector<App::DocumentObject*> ret;
-    if(!(options & DepSort)) {
-        _buildDependencyList(objectArray,options,&ret,0,0);
+    _buildDependencyList(objectArray,options,&ret,0,0);
+    if(!(options & DepSort) || DocumentObject::_sortByDependency(ret))
         return ret;
-    }
 
+    // Cyclic dependency, use the boost graph to report the cycle
+    ret.clear();
     DependencyList depList;
     std::map<DocumentObject*,Vertex> objectMap;
     std::map<Vertex,DocumentObject*> vertexMap;
@@ -3443,33 +3545,17 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
     Base::ObjectStatusLocker<Document::Status, Document> exe(Document::Recomputing, this);
     signalBeforeRecompute(*this);
 
-#if 0
-    //////////////////////////////////////////////////////////////////////////
-    // FIXME Comment by Realthunder: 
-    // the topologicalSrot() below cannot handle partial recompute, haven't got
-    // time to figure out the code yet, simply use back boost::topological_sort
-    // for now, that is, rely on getDependencyList() to do the sorting. The
-    // downside is, it didn't take advantage of the ready built InList, nor will
-    // it report for cyclic dependency.
-    //////////////////////////////////////////////////////////////////////////
-
-    // get the sorted vector of all dependent objects and go though it from the end
-    auto depObjs = getDependencyList(objs.empty()?d->objectArray:objs);
-    vector<DocumentObject*> topoSortedObjects = topologicalSort(depObjs);
-    if (topoSortedObjects.size() != depObjs.size()){
-        cerr << "App::Document::recompute(): cyclic dependency detected" << endl;
-        topoSortedObjects = d->partialTopologicalSort(depObjs);
-    }
-    std::reverse(topoSortedObjects.begin(),topoSortedObjects.end());
-#else
+    // getDependencyList() sorts using the incrementally maintained dependency
+    // order of the objects, and reports any cyclic dependency.
     auto topoSortedObjects = getDependencyList(objs.empty()?d->objectArray:objs,DepSort|options);
-#endif
     for(auto obj : topoSortedObjects)
         obj->setStatus(ObjectStatus::PendingRecompute,true);
 
     ParameterGrp::handle hGrp = GetApplication().GetParameterGroupByPath(
             "User parameter:BaseApp/Preferences/Document");
     bool canAbort = hGrp->GetBool("CanAbortRecompute",true);
+    bool parallel = hGrp->GetBool("ParallelRecompute",false)
+        && QThreadPool::globalInstance()->maxThreadCount() > 1;
 
     std::set<App::DocumentObject *> filter;
     size_t idx = 0;
@@ -3483,6 +3569,11 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
             if(canAbort)
                 seq.reset(new Base::SequencerLauncher("Recompute...", topoSortedObjects.size()));
             FC_LOG("Recompute pass " << passes);
+            if(parallel) {
+                if(_recomputeParallel(topoSortedObjects,idx,filter,seq.get(),objectCount,hasError) < 0)
+                    passes = 2;
+                idx = topoSortedObjects.size();
+            }
             for (;idx<topoSortedObjects.size();(seq?seq->next(true):true),++idx) {
                 auto obj = topoSortedObjects[idx];
                 if(!obj->getNameInDocument() || filter.find(obj)!=filter.end())
@@ -3788,6 +3879,255 @@ int Document::_recomputeFeature(DocumentObject* Feat)
     return 0;
 }
 
+namespace {
+// Runs a single object recompute inside QThreadPool
+class RecomputeTask : public QRunnable
+{
+public:
+    explicit RecomputeTask(std::function<void()> &&func)
+        :func(std::move(func))
+    {}
+
+    void run() override {
+        func();
+    }
+
+private:
+    std::function<void()> func;
+};
+}
+
+// Parallel version of the recompute loop in Document::recompute(). An object
+// is scheduled as soon as all its dependencies within the given range are
+// done. Objects that are not thread safe, all post processing (touch status,
+// filtering on error) and all signaling are done in the calling thread, so
+// that observers still see the notification in dependency order. This covers
+// the signals of the document and those of the objects. Console output of
+// the workers is posted to the event loop if there is one; without it, as in
+// command line mode, the console observers must be thread safe.
+int Document::_recomputeParallel(const std::vector<App::DocumentObject*> &objs, size_t start,
+        std::set<App::DocumentObject*> &filter, Base::SequencerLauncher *seq,
+        int &objectCount, bool *hasError)
+{
+    if(start >= objs.size())
+        return 0;
+
+    std::unordered_map<App::DocumentObject*, size_t> indices;
+    for(size_t i=start; i<objs.size(); ++i)
+        indices[objs[i]] = i;
+
+    // number of unfinished dependencies of each object
+    std::vector<int> pending(objs.size(),0);
+    std::vector<std::vector<size_t> > dependents(objs.size());
+    // ready objects ordered by their topological index
+    std::set<size_t> ready;
+    for(size_t i=start; i<objs.size(); ++i) {
+        auto obj = objs[i];
+        if(obj->getNameInDocument()) {
+            auto outList = obj->getOutList();
+            std::sort(outList.begin(), outList.end());
+            outList.erase(std::unique(outList.begin(), outList.end()), outList.end());
+            for(auto dep : outList) {
+                auto it = indices.find(dep);
+                if(it == indices.end() || it->second == i)
+                    continue;
+                ++pending[i];
+                dependents[it->second].push_back(i);
+            }
+        }
+        if(!pending[i])
+            ready.insert(i);
+    }
+
+    struct Result {
+        size_t index;
+        int res;
+        std::vector<RecomputeNotification> notifications;
+        std::vector<RecomputeBackLink> backLinks;
+    };
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<Result> results;
+
+    size_t total = objs.size() - start;
+    size_t finished = 0;
+    size_t running = 0;
+    int ret = 0;
+    bool aborted = false;
+    std::exception_ptr error;
+
+    // Release the GIL, so that the workers can evaluate expressions. It is
+    // grabbed again for anything done in this thread.
+    std::unique_ptr<Base::PyGILStateRelease> unlock;
+    if(Py_IsInitialized() && PyGILState_Check())
+        unlock.reset(new Base::PyGILStateRelease);
+
+    // The GUI console observers are not thread safe
+    bool queueConsole = QCoreApplication::instance()
+        && QThread::currentThread() == QCoreApplication::instance()->thread()
+        && Base::Console().GetConnectionMode() == Base::ConsoleSingleton::Direct;
+    if(queueConsole)
+        Base::Console().SetConnectionMode(Base::ConsoleSingleton::Queued);
+
+    auto postProcess = [&](size_t i, int res, bool doRecompute) {
+        auto obj = objs[i];
+        if(res) {
+            if(hasError)
+                *hasError = true;
+            if(res < 0) {
+                ret = -1;
+                aborted = true;
+                return;
+            }
+            // if something happened filter all object in its
+            // inListRecursive from the queue then proceed
+            obj->getInListEx(filter,true);
+            filter.insert(obj);
+            return;
+        }
+        if(obj->isTouched() || doRecompute) {
+            signalRecomputedObject(*obj);
+            obj->purgeTouched();
+            // set all dependent object touched to force recompute
+            for (auto inObjIt : obj->getInList())
+                inObjIt->enforceRecompute();
+        }
+    };
+
+    auto finish = [&](size_t i) {
+        ++finished;
+        for(auto dep : dependents[i]) {
+            if(--pending[dep] == 0)
+                ready.insert(dep);
+        }
+        if(seq)
+            seq->next(true);
+    };
+
+    while(finished < total) {
+        try {
+            while(!aborted && ready.size()) {
+                size_t i = *ready.begin();
+                ready.erase(ready.begin());
+                auto obj = objs[i];
+                if(!obj->getNameInDocument() || filter.find(obj)!=filter.end()) {
+                    finish(i);
+                    continue;
+                }
+
+                // ask the object if it should be recomputed
+                if(!obj->mustRecompute()) {
+                    Base::PyGILStateLocker lock;
+                    postProcess(i,0,false);
+                    finish(i);
+                    continue;
+                }
+
+                ++objectCount;
+                if(!obj->canRecomputeInThread()) {
+                    Base::PyGILStateLocker lock;
+                    postProcess(i,_recomputeFeature(obj),true);
+                    finish(i);
+                    continue;
+                }
+
+                ++running;
+                QThreadPool::globalInstance()->start(new RecomputeTask([&,i,obj]() {
+                    Result result;
+                    result.index = i;
+                    _RecomputeNotifications = &result.notifications;
+                    _RecomputeBackLinks = &result.backLinks;
+                    try {
+                        result.res = _recomputeFeature(obj);
+                    } catch (...) {
+                        FC_ERR("Unknown exception in " << obj->getFullName() << " thrown");
+                        d->addRecomputeLog("Unknown exception!",obj);
+                        result.res = 1;
+                    }
+                    _RecomputeNotifications = 0;
+                    _RecomputeBackLinks = 0;
+
+                    std::lock_guard<std::mutex> guard(mutex);
+                    results.push_back(std::move(result));
+                    cond.notify_one();
+                }));
+            }
+
+            if(!running) {
+                if(aborted)
+                    break;
+                // Nothing is running but there are unfinished objects, which
+                // means they form a dependency cycle. Continue with the first
+                // one in topological order, like the serial recompute does.
+                for(size_t i=start; i<objs.size(); ++i) {
+                    if(pending[i] > 0) {
+                        pending[i] = 0;
+                        ready.insert(i);
+                        break;
+                    }
+                }
+                continue;
+            }
+
+            std::deque<Result> done;
+            {
+                std::unique_lock<std::mutex> guard(mutex);
+                cond.wait(guard, [&]() {return !results.empty();});
+                done.swap(results);
+            }
+
+            // Account for all collected workers before running anything that
+            // may throw, the remaining results are handled nevertheless.
+            running -= done.size();
+
+            Base::PyGILStateLocker lock;
+            for(auto &result : done) {
+                try {
+                    for(auto &link : result.backLinks) {
+                        if(link.add)
+                            link.obj->_addBackLink(link.link);
+                        else
+                            link.obj->_removeBackLink(link.link);
+                    }
+                    for(auto &n : result.notifications) {
+                        if(n.before && !n.obj->isDerivedFrom(App::DocumentObject::getClassTypeId()))
+                            continue;
+                        auto obj = static_cast<App::DocumentObject*>(
+                                const_cast<App::TransactionalObject*>(n.obj));
+                        if(!n.before) {
+                            signalChangedObject(*obj, *n.prop);
+                            obj->signalChanged(*obj, *n.prop);
+                        } else {
+                            signalBeforeChangeObject(*obj, *n.prop);
+                            obj->signalBeforeChange(*obj, *n.prop);
+                        }
+                    }
+                    postProcess(result.index,result.res,true);
+                    finish(result.index);
+                } catch (...) {
+                    if(!error)
+                        error = std::current_exception();
+                    aborted = true;
+                }
+            }
+        } catch (...) {
+            // keep on collecting the running workers before passing on the exception
+            if(!error)
+                error = std::current_exception();
+            aborted = true;
+            if(!running)
+                break;
+        }
+    }
+
+    if(queueConsole)
+        Base::Console().SetConnectionMode(Base::ConsoleSingleton::Direct);
+
+    if(error)
+        std::rethrow_exception(error);
+    return ret;
+}
+
 bool Document::recomputeFeature(DocumentObject* Feat, bool recursive)
 {
     // delete recompute log
@@ -33,6 +33,7 @@
 #include "PropertyLinks.h"
 
 #include <map>
+#include <set>
 #include <vector>
 #include <stack>
 #include <functional>
@@ -41,6 +42,7 @@
 
 namespace Base {
     class Writer;
+    class SequencerLauncher;
 }
 
 namespace App
@@ -74,6 +76,7 @@ public:
         PartialDoc = 7,
         AllowPartialRecompute = 8, // allow recomputing editing object if SkipRecompute is set
         TempDoc = 9, // Mark as temporary document without prompt for save
+        LazyLoading = 10, // Restore the data files of geometric properties on first access
     };
 
     /** @name Properties */
@@ -401,7 +404,10 @@ public:
     /// Check if a transaction is open and its list is empty.
     /// If no transaction is open true is returned.
     bool isTransactionEmpty() const;
-    /// Set the Undo limit in Byte!
+    /** Set the Undo limit in Byte!
+     * When a transaction is committed the oldest transactions are removed
+     * until the memory of the Undo stack is below the limit. Zero means no limit.
+     */
     void setUndoLimit(unsigned int UndoMemSize=0);
     /// Returns the actual memory consumption of the Undo redo stuff.
     unsigned int getUndoMemSize (void) const;
@@ -533,9 +539,21 @@ protected:
     void onBeforeChangeProperty(const TransactionalObject *Who, const Property *What);
     /// callback from the Document objects after property was changed
     void onChangedProperty(const DocumentObject *Who, const Property *What);
+    /// true in a worker thread of a parallel recompute, whose change
+    /// notifications are queued and signaled later by the calling thread
+    static bool isRecomputeWorker();
+    /// queue a change of the in-list of \a obj if called in a worker thread of
+    /// a parallel recompute, the calling thread applies it later
+    static bool queueBackLink(DocumentObject *obj, DocumentObject *link, bool add);
     /// helper which Recompute only this feature
     /// @return 0 if succeeded, 1 if failed, -1 if aborted by user.
     int _recomputeFeature(DocumentObject* Feat);
+    /// helper which recomputes the sorted objects from index \a start on
+    /// using a pool of worker threads.
+    /// @return 0 if finished, -1 if aborted by user.
+    int _recomputeParallel(const std::vector<App::DocumentObject*> &objs, size_t start,
+            std::set<App::DocumentObject*> &filter, Base::SequencerLauncher *seq,
+            int &objectCount, bool *hasError);
     void _clearRedos();
 
     /// refresh the internal dependency graph
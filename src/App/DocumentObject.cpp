@@ -25,8 +25,14 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
+# include <deque>
 #endif
 
+#include <atomic>
+#include <unordered_set>
+#include <unordered_map>
+
 #include <Base/Writer.h>
 #include <Base/Tools.h>
 #include <Base/Console.h>
@@ -57,12 +63,15 @@ PROPERTY_SOURCE(App::DocumentObject, App::TransactionalObject)
 
 DocumentObjectExecReturn *DocumentObject::StdReturn = 0;
 
+// counter used to assign the initial dependency order to new objects
+static std::atomic<long> _DepOrderCounter;
+
 //===========================================================================
 // DocumentObject
 //===========================================================================
 
 DocumentObject::DocumentObject(void)
-    : ExpressionEngine(),_pDoc(0),pcNameInDocument(0),_Id(0)
+    : ExpressionEngine(),_pDoc(0),pcNameInDocument(0),_Id(0),_depOrder(++_DepOrderCounter)
 {
     // define Label of type 'Output' to avoid being marked as touched after relabeling
     ADD_PROPERTY_TYPE(Label,("Unnamed"),"Base",Prop_Output,"User name of the object (UTF8)");
@@ -694,7 +703,9 @@ void DocumentObject::onBeforeChange(const Property* prop)
     if (_pDoc)
         onBeforeChangeProperty(_pDoc, prop);
 
-    signalBeforeChange(*this,*prop);
+    // the document signals it later if recomputed in a worker thread
+    if (!Document::isRecomputeWorker())
+        signalBeforeChange(*this,*prop);
 }
 
 /// get called by the container when a Property was changed
@@ -745,7 +756,9 @@ void DocumentObject::onChanged(const Property* prop)
     if (_pDoc)
         _pDoc->onChangedProperty(this,prop);
 
-    signalChanged(*this,*prop);
+    // the document signals it later if recomputed in a worker thread
+    if (!Document::isRecomputeWorker())
+        signalChanged(*this,*prop);
 }
 
 void DocumentObject::clearOutListCache() const {
@@ -973,6 +986,10 @@ void DocumentObject::unsetupObject()
 void App::DocumentObject::_removeBackLink(DocumentObject* rmvObj)
 {
 #ifndef USE_OLD_DAG
+    // the dependency graph is only changed by the thread calling recompute()
+    if(Document::queueBackLink(this,rmvObj,false))
+        return;
+
     //do not use erase-remove idom, as this erases ALL entries that match. we only want to remove a
     //single one.
     auto it = std::find(_inList.begin(), _inList.end(), rmvObj);
@@ -986,16 +1003,163 @@ void App::DocumentObject::_removeBackLink(DocumentObject* rmvObj)
 void App::DocumentObject::_addBackLink(DocumentObject* newObj)
 {
 #ifndef USE_OLD_DAG
+    // the dependency graph is only changed by the thread calling recompute()
+    if(Document::queueBackLink(this,newObj,true))
+        return;
+
     //we need to add all links, even if they are available multiple times. The reason for this is the
     //removal: If a link loses this object it removes the backlink. If we would have added it only once
     //this removal would clear the object from the inlist, even though there may be other link properties 
     //from this object that link to us.
     _inList.push_back(newObj);
+
+    // Links are restored in no particular order, so let _sortByDependency()
+    // rebuild the order in one go after restore.
+    if(!_pDoc || !_pDoc->testStatus(Document::Restoring))
+        _updateDependencyOrder(this,newObj);
 #else
     (void)newObj;
 #endif //USE_OLD_DAG    
 }
 
+// Update the dependency order on adding a link from 'obj' to 'dep', using the
+// dynamic topological sort algorithm of Pearce and Kelly. Only objects whose
+// order lies between the two are visited and reordered. Return false if the
+// link creates a cycle, in which case the order is left untouched and gets
+// rebuilt by _sortByDependency() once the cycle is gone.
+bool DocumentObject::_updateDependencyOrder(DocumentObject *dep, DocumentObject *obj)
+{
+    long lower = obj->_depOrder;
+    long upper = dep->_depOrder;
+    if(upper < lower)
+        return true;
+    if(dep == obj)
+        return false;
+
+    // objects depending on 'obj' that are ordered before 'dep'
+    std::vector<DocumentObject*> forward;
+    std::unordered_set<DocumentObject*> visited;
+    std::vector<DocumentObject*> stack;
+    stack.push_back(obj);
+    visited.insert(obj);
+    while(stack.size()) {
+        auto o = stack.back();
+        stack.pop_back();
+        forward.push_back(o);
+        for(auto in : o->_inList) {
+            if(in == dep)
+                return false;
+            if(in->_depOrder < upper && visited.insert(in).second)
+                stack.push_back(in);
+        }
+    }
+
+    // dependencies of 'dep' that are ordered after 'obj'
+    std::vector<DocumentObject*> backward;
+    std::unordered_set<DocumentObject*> visitedBackward;
+    stack.push_back(dep);
+    visitedBackward.insert(dep);
+    while(stack.size()) {
+        auto o = stack.back();
+        stack.pop_back();
+        backward.push_back(o);
+        for(auto out : o->getOutList()) {
+            if(!out || out->_depOrder <= lower)
+                continue;
+            if(visited.count(out))
+                return false;
+            if(visitedBackward.insert(out).second)
+                stack.push_back(out);
+        }
+    }
+
+    // Reuse the order slots of both sets, with all backward objects placed
+    // before the forward ones.
+    auto cmp = [](const DocumentObject *a, const DocumentObject *b) {
+        return a->_depOrder < b->_depOrder;
+    };
+    std::sort(forward.begin(),forward.end(),cmp);
+    std::sort(backward.begin(),backward.end(),cmp);
+    std::vector<long> orders;
+    orders.reserve(forward.size()+backward.size());
+    for(auto o : backward)
+        orders.push_back(o->_depOrder);
+    for(auto o : forward)
+        orders.push_back(o->_depOrder);
+    std::sort(orders.begin(),orders.end());
+    auto it = orders.begin();
+    for(auto o : backward)
+        o->_depOrder = *it++;
+    for(auto o : forward)
+        o->_depOrder = *it++;
+    return true;
+}
+
+bool DocumentObject::_sortByDependency(std::vector<DocumentObject*> &objs)
+{
+    bool sorted = true;
+    for(auto it=objs.begin(); sorted && it!=objs.end(); ++it) {
+        for(auto dep : (*it)->getOutList()) {
+            if(dep && dep->getNameInDocument() && dep->_depOrder >= (*it)->_depOrder) {
+                sorted = false;
+                break;
+            }
+        }
+    }
+
+    if(sorted) {
+        std::sort(objs.begin(),objs.end(),
+            [](const DocumentObject *a, const DocumentObject *b) {
+                return a->_depOrder < b->_depOrder;
+            });
+        return true;
+    }
+
+    // The order is outdated, e.g. after restore. Rebuild it for the given
+    // objects using Kahn's algorithm. Because the objects include all their
+    // dependencies, the new order only violates links from objects outside,
+    // which will be fixed on their turn.
+    std::unordered_map<DocumentObject*, int> degrees;
+    for(auto obj : objs)
+        degrees[obj] = 0;
+    std::unordered_map<DocumentObject*, std::vector<DocumentObject*> > dependents;
+    for(auto obj : objs) {
+        auto outList = obj->getOutList();
+        std::sort(outList.begin(),outList.end());
+        outList.erase(std::unique(outList.begin(),outList.end()),outList.end());
+        for(auto dep : outList) {
+            if(dep == obj)
+                return false;
+            if(!degrees.count(dep))
+                continue;
+            ++degrees[obj];
+            dependents[dep].push_back(obj);
+        }
+    }
+
+    std::deque<DocumentObject*> queue;
+    for(auto obj : objs) {
+        if(!degrees[obj])
+            queue.push_back(obj);
+    }
+    std::vector<DocumentObject*> res;
+    res.reserve(objs.size());
+    while(queue.size()) {
+        auto obj = queue.front();
+        queue.pop_front();
+        res.push_back(obj);
+        obj->_depOrder = ++_DepOrderCounter;
+        for(auto o : dependents[obj]) {
+            if(--degrees[o] == 0)
+                queue.push_back(o);
+        }
+    }
+    if(res.size() != objs.size())
+        return false;
+    objs = std::move(res);
+    return true;
+}
+
 int DocumentObject::setElementVisible(const char *element, bool visible) {
     for(auto ext : getExtensionsDerivedFromType<DocumentObjectExtension>()) {
         int ret = ext->extensionSetElementVisible(element,visible);
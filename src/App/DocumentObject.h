@@ -268,6 +268,19 @@ public:
     void _removeBackLink(DocumentObject*);
     /// internal, used by PropertyLink to maintain DAG back links
     void _addBackLink(DocumentObject*);
+    /** internal, used by Document to sort objects with dependencies first
+     *
+     * The objects are sorted using a dependency order that is incrementally
+     * maintained together with the DAG back links. The order is rebuilt for
+     * the given objects only if it is found to be outdated.
+     *
+     * @param objs: input the objects with all their dependencies, output the
+     * sorted objects.
+     *
+     * @return false if the objects contain cyclic dependency, in which case
+     * \c objs is left untouched.
+     */
+    static bool _sortByDependency(std::vector<DocumentObject*> &objs);
     //@}
 
     /**
@@ -403,6 +416,16 @@ public:
     /* Return true to bypass duplicate label checking */
     virtual bool allowDuplicateLabel() const {return false;}
 
+    /** Return true if the object can be recomputed in a worker thread
+     *
+     * This is queried by Document::recompute() when parallel recompute is
+     * enabled. Objects returning false are always recomputed in the calling
+     * thread, once all their dependencies are done. Only features whose
+     * execute() doesn't touch anything but their own properties should
+     * return true, e.g. no signals handled by the GUI.
+     */
+    virtual bool canRecomputeInThread() const {return false;}
+
     /*** Called to let object itself control relabeling
      *
      * @param newLabel: input as the new label, which can be modified by object itself
@@ -636,6 +659,10 @@ private:
     mutable std::vector<App::DocumentObject *> _outList;
     mutable std::unordered_map<const char *, App::DocumentObject*, CStringHasher, CStringHasher> _outListMap;
     mutable bool _outListCached = false;
+
+    // position of this object in the application wide dependency order
+    long _depOrder;
+    static bool _updateDependencyOrder(DocumentObject *dep, DocumentObject *obj);
 };
 
 } //namespace App
@@ -566,6 +566,18 @@ Py::Object pyFromQuantity(const Quantity &quantity) {
     }
 }
 
+// Native counterpart of pyFromQuantity()
+static void nativeFromQuantity(const Quantity &quantity, Expression::NativeValue &value) {
+    value.quantity = quantity;
+    long l;
+    if(!quantity.getUnit().isEmpty())
+        value.type = Expression::NativeValue::TypeQuantity;
+    else if(essentiallyInteger(quantity.getValue(),l))
+        value.type = Expression::NativeValue::TypeInt;
+    else
+        value.type = Expression::NativeValue::TypeFloat;
+}
+
 Quantity anyToQuantity(const App::any &value, const char *msg) {
     if (is_type(value,typeid(Quantity))) {
         return cast<Quantity>(value);
@@ -1151,7 +1163,35 @@ ExpressionPtr Expression::replaceObject(const DocumentObject *parent,
     return ExpressionPtr(expr);
 }
 
+App::any Expression::NativeValue::toAny() const {
+    switch(type) {
+    case TypeQuantity:
+        return App::any(quantity);
+    case TypeFloat:
+        return App::any(quantity.getValue());
+    default:
+        return App::any(static_cast<long>(quantity.getValue()));
+    }
+}
+
+bool Expression::getNativeValue(NativeValue &value) const {
+    // Components (e.g. attribute or index access) are only accessible
+    // through Python
+    if(components.size())
+        return false;
+    try {
+        return _getNativeValue(value);
+    } catch (Base::Exception &) {
+        // Let the Python evaluation report the error
+        return false;
+    }
+}
+
 App::any Expression::getValueAsAny() const {
+    NativeValue value;
+    if(getNativeValue(value))
+        return value.toAny();
+
     Base::PyGILStateLocker lock;
     return pyObjectToAny(getPyValue());
 }
@@ -1183,6 +1223,15 @@ void Expression::visit(ExpressionVisitor &v) {
 }
 
 Expression* Expression::eval() const {
+    NativeValue value;
+    if(getNativeValue(value)) {
+        if(value.type != NativeValue::TypeBool)
+            return new NumberExpression(owner,value.quantity);
+        if(value.isTrue())
+            return new ConstantExpression(owner,"True",Quantity(1.0));
+        return new ConstantExpression(owner,"False",Quantity(0.0));
+    }
+
     Base::PyGILStateLocker lock;
     return expressionFromPy(owner,getPyValue());
 }
@@ -1315,6 +1364,11 @@ Py::Object UnitExpression::_getPyValue() const {
     return Py::Object(cache);
 }
 
+bool UnitExpression::_getNativeValue(NativeValue &value) const {
+    nativeFromQuantity(quantity, value);
+    return true;
+}
+
 //
 // NumberExpression class
 //
@@ -1555,6 +1609,171 @@ Py::Object OperatorExpression::_getPyValue() const {
     return calc(this,op,left,right,false);
 }
 
+bool OperatorExpression::_getNativeValue(NativeValue &value) const {
+    NativeValue l;
+    if(!left->getNativeValue(l))
+        return false;
+
+    switch(op) {
+    case POS:
+    case NEG:
+        value.type = l.type==NativeValue::TypeBool?NativeValue::TypeInt:l.type;
+        value.quantity = op==NEG ? l.quantity * -1.0 : l.quantity;
+        return true;
+    default:
+        break;
+    }
+
+    NativeValue r;
+    if(!right->getNativeValue(r))
+        return false;
+
+    const Quantity &a = l.quantity;
+    const Quantity &b = r.quantity;
+    bool isQuantity = l.type==NativeValue::TypeQuantity || r.type==NativeValue::TypeQuantity;
+
+    switch(op) {
+    case EQ:
+    case NEQ:
+    case LT:
+    case LTE:
+    case GT:
+    case GTE: {
+        bool res;
+        if(l.type==NativeValue::TypeQuantity && r.type==NativeValue::TypeQuantity) {
+            // Same as QuantityPy::richCompare()
+            switch(op) {
+            case EQ:
+                res = a == b;
+                break;
+            case NEQ:
+                res = !(a == b);
+                break;
+            case LT:
+                res = a < b;
+                break;
+            case LTE:
+                res = a < b || a == b;
+                break;
+            case GT:
+                res = !(a < b) && !(a == b);
+                break;
+            default:
+                res = !(a < b);
+                break;
+            }
+        } else {
+            double va = a.getValue();
+            double vb = b.getValue();
+            switch(op) {
+            case EQ:
+                res = va == vb;
+                break;
+            case NEQ:
+                res = va != vb;
+                break;
+            case LT:
+                res = va < vb;
+                break;
+            case LTE:
+                res = va <= vb;
+                break;
+            case GT:
+                res = va > vb;
+                break;
+            default:
+                res = va >= vb;
+                break;
+            }
+        }
+        value.type = NativeValue::TypeBool;
+        value.quantity = Quantity(res?1.0:0.0);
+        return true;
+    }
+    default:
+        break;
+    }
+
+    if(isQuantity) {
+        switch(op) {
+        case ADD:
+            value.quantity = a + b;
+            break;
+        case SUB:
+            value.quantity = a - b;
+            break;
+        case MUL:
+        case UNIT:
+            value.quantity = a * b;
+            break;
+        case DIV:
+            value.quantity = a / b;
+            break;
+        default:
+            // Leave the rest (e.g. MOD, POW) to QuantityPy
+            return false;
+        }
+        value.type = NativeValue::TypeQuantity;
+        return true;
+    }
+
+    // Plain numbers, follow Python's int/float arithmetic
+    bool isInt = l.type!=NativeValue::TypeFloat && r.type!=NativeValue::TypeFloat;
+    double va = a.getValue();
+    double vb = b.getValue();
+    double v;
+    switch(op) {
+    case ADD:
+        v = va + vb;
+        break;
+    case SUB:
+        v = va - vb;
+        break;
+    case MUL:
+    case UNIT:
+        v = va * vb;
+        break;
+    case DIV:
+        if(vb == 0.0)
+            return false;
+        v = va / vb;
+        isInt = false;
+        break;
+    case MOD:
+        if(vb == 0.0)
+            return false;
+        // Python's modulo takes the sign of the divisor
+        v = std::fmod(va,vb);
+        if(v == 0.0)
+            v = std::copysign(0.0,vb);
+        else if((vb < 0.0) != (v < 0.0))
+            v += vb;
+        break;
+    case POW:
+        if(va == 0.0 && vb < 0.0)
+            return false;
+        if(va < 0.0 && vb != std::floor(vb))
+            return false;
+        if(vb < 0.0)
+            isInt = false;
+        v = std::pow(va,vb);
+        if(std::isinf(v))
+            return false;
+        break;
+    default:
+        return false;
+    }
+
+    if(!isInt)
+        value.type = NativeValue::TypeFloat;
+    else if(std::fabs(v) <= 9007199254740992.0) // 2^53
+        value.type = NativeValue::TypeInt;
+    else // beyond the exact integer range of double
+        return false;
+    value.quantity = Quantity(v);
+    return true;
+}
+
 /**
   * Simplify the expression. For OperatorExpressions, we return a NumberExpression if
   * both the left and right side can be simplified to NumberExpressions. In this case
@@ -1928,187 +2147,9 @@ public:
     }
 };
 
-Py::Object FunctionExpression::evalAggregate(
-        const Expression *owner, int f, const std::vector<Expression*> &args)
-{
-    std::unique_ptr<Collector> c;
-
-    switch (f) {
-    case SUM:
-        c.reset(new SumCollector);
-        break;
-    case AVERAGE:
-        c.reset(new AverageCollector);
-        break;
-    case STDDEV:
-        c.reset(new StdDevCollector);
-        break;
-    case COUNT:
-        c.reset(new CountCollector);
-        break;
-    case MIN:
-        c.reset(new MinCollector);
-        break;
-    case MAX:
-        c.reset(new MaxCollector);
-        break;
-    default:
-        assert(false);
-    }
-
-    for (auto &arg : args) {
-        if (arg->isDerivedFrom(RangeExpression::getClassTypeId())) {
-            Range range(static_cast<const RangeExpression&>(*arg).getRange());
-
-            do {
-                Property * p = owner->getOwner()->getPropertyByName(range.address().c_str());
-                PropertyQuantity * qp;
-                PropertyFloat * fp;
-                PropertyInteger * ip;
-
-                if (!p)
-                    continue;
-
-                if ((qp = freecad_dynamic_cast<PropertyQuantity>(p)) != 0)
-                    c->collect(qp->getQuantityValue());
-                else if ((fp = freecad_dynamic_cast<PropertyFloat>(p)) != 0)
-                    c->collect(Quantity(fp->getValue()));
-                else if ((ip = freecad_dynamic_cast<PropertyInteger>(p)) != 0)
-                    c->collect(Quantity(ip->getValue()));
-                else
-                    _EXPR_THROW("Invalid property type for aggregate.", owner);
-            } while (range.next());
-        }
-        else {
-            Quantity q;
-            if(pyToQuantity(q,arg->getPyValue()))
-                c->collect(q);
-        }
-    }
-
-    return pyFromQuantity(c->getQuantity());
-}
-
-Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std::vector<Expression*> &args)
+Quantity FunctionExpression::evalMath(const Expression *expr, int f,
+        const Quantity &v1, const Quantity *v2, const Quantity *v3)
 {
-    if(!expr || !expr->getOwner())
-        _EXPR_THROW("Invalid owner.", expr);
-
-    // Handle aggregate functions
-    if (f > AGGREGATES)
-        return evalAggregate(expr, f, args);
-
-    if(f == LIST) {
-        if(args.size() == 1 && args[0]->isDerivedFrom(RangeExpression::getClassTypeId()))
-            return args[0]->getPyValue();
-        Py::List list(args.size());
-        int i=0;
-        for(auto &arg : args)
-            list.setItem(i++,arg->getPyValue());
-        return list;
-    } else if (f == TUPLE) {
-        if(args.size() == 1 && args[0]->isDerivedFrom(RangeExpression::getClassTypeId()))
-            return Py::Tuple(args[0]->getPyValue());
-        Py::Tuple tuple(args.size());
-        int i=0;
-        for(auto &arg : args)
-            tuple.setItem(i++,arg->getPyValue());
-        return tuple;
-    } else if (f == MSCALE) {
-        if(args.size() < 2)
-            _EXPR_THROW("Function requires at least two arguments.",expr);
-        Py::Object pymat = args[0]->getPyValue();
-        Py::Object pyscale;
-        if(PyObject_TypeCheck(pymat.ptr(),&Base::MatrixPy::Type)) {
-            if(args.size() == 2) {
-                Py::Object obj = args[1]->getPyValue();
-                if(obj.isSequence() && PySequence_Size(obj.ptr())==3)
-                    pyscale = Py::Tuple(Py::Sequence(obj));
-            } else if(args.size() == 4) {
-                Py::Tuple tuple(3);
-                tuple.setItem(0,args[1]->getPyValue());
-                tuple.setItem(1,args[2]->getPyValue());
-                tuple.setItem(2,args[3]->getPyValue());
-                pyscale = tuple;
-            }
-        }
-        if(!pyscale.isNone()) {
-            Base::Vector3d vec;
-            if (!PyArg_ParseTuple(pyscale.ptr(), "ddd", &vec.x,&vec.y,&vec.z))
-                PyErr_Clear();
-            else {
-                auto mat = static_cast<Base::MatrixPy*>(pymat.ptr())->value();
-                mat.scale(vec);
-                return Py::asObject(new Base::MatrixPy(mat));
-            }
-        }
-        _EXPR_THROW("Function requires arguments to be either "
-                "(matrix,vector) or (matrix,number,number,number).", expr);
-    }
-
-    if(args.empty())
-        _EXPR_THROW("Function requires at least one argument.",expr);
-
-    if (f == MINVERT) {
-        Py::Object pyobj = args[0]->getPyValue();
-        if (PyObject_TypeCheck(pyobj.ptr(),&Base::MatrixPy::Type)) {
-            auto m = static_cast<Base::MatrixPy*>(pyobj.ptr())->value();
-            if (fabs(m.determinant()) <= DBL_EPSILON)
-                _EXPR_THROW("Cannot invert singular matrix.",expr);
-            m.inverseGauss();
-            return Py::asObject(new Base::MatrixPy(m));
-
-        } else if (PyObject_TypeCheck(pyobj.ptr(),&Base::PlacementPy::Type)) {
-            const auto &pla = *static_cast<Base::PlacementPy*>(pyobj.ptr())->getPlacementPtr();
-            return Py::asObject(new Base::PlacementPy(pla.inverse()));
-
-        } else if (PyObject_TypeCheck(pyobj.ptr(),&Base::RotationPy::Type)) {
-            const auto &rot = *static_cast<Base::RotationPy*>(pyobj.ptr())->getRotationPtr();
-            return Py::asObject(new Base::RotationPy(rot.inverse()));
-        }
-         _EXPR_THROW("Function requires the first argument to be either Matrix, Placement or Rotation.",expr);
-
-    } else if (f == CREATE) {
-        Py::Object pytype = args[0]->getPyValue();
-        if(!pytype.isString())
-            _EXPR_THROW("Function requires the first argument to be a string.",expr);
-        std::string type(pytype.as_string());
-        Py::Object res;
-        if(boost::iequals(type,"matrix"))
-            res = Py::asObject(new Base::MatrixPy(Base::Matrix4D()));
-        else if(boost::iequals(type,"vector"))
-            res = Py::asObject(new Base::VectorPy(Base::Vector3d()));
-        else if(boost::iequals(type,"placement"))
-            res = Py::asObject(new Base::PlacementPy(Base::Placement()));
-        else if(boost::iequals(type,"rotation"))
-            res = Py::asObject(new Base::RotationPy(Base::Rotation()));
-        else
-            _EXPR_THROW("Unknown type '" << type << "'.",expr);
-        if(args.size()>1) {
-            Py::Tuple tuple(args.size()-1);
-            for(unsigned i=1;i<args.size();++i)
-                tuple.setItem(i-1,args[i]->getPyValue());
-            Py::Dict dict;
-            PyObjectBase::__PyInit(res.ptr(),tuple.ptr(),dict.ptr());
-        }
-        return res;
-    }
-
-    Py::Object e1 = args[0]->getPyValue();
-    Quantity v1 = pyToQuantity(e1,expr,"Invalid first argument.");
-    Py::Object e2;
-    Quantity v2;
-    if(args.size()>1) {
-        e2 = args[1]->getPyValue();
-        v2 = pyToQuantity(e2,expr,"Invalid second argument.");
-    }
-    Py::Object e3;
-    Quantity v3;
-    if(args.size()>2) {
-        e3 = args[2]->getPyValue();
-        v3 = pyToQuantity(e3,expr,"Invalid third argument.");
-    }
-
     double output;
     Unit unit;
     double scaler = 1;
@@ -2178,28 +2219,28 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         break;
     }
     case ATAN2:
-        if (e2.isNone())
+        if (!v2)
             _EXPR_THROW("Invalid second argument.",expr);
 
-        if (v1.getUnit() != v2.getUnit())
+        if (v1.getUnit() != v2->getUnit())
             _EXPR_THROW("Units must be equal.",expr);
         unit = Unit::Angle;
         scaler = 180.0 / M_PI;
         break;
     case MOD:
-        if (e2.isNone())
+        if (!v2)
             _EXPR_THROW("Invalid second argument.",expr);
-        unit = v1.getUnit() / v2.getUnit();
+        unit = v1.getUnit() / v2->getUnit();
         break;
     case POW: {
-        if (e2.isNone())
+        if (!v2)
             _EXPR_THROW("Invalid second argument.",expr);
 
-        if (!v2.getUnit().isEmpty())
+        if (!v2->getUnit().isEmpty())
             _EXPR_THROW("Exponent is not allowed to have a unit.",expr);
 
         // Compute new unit for exponentiation
-        double exponent = v2.getValue();
+        double exponent = v2->getValue();
         if (!v1.getUnit().isEmpty()) {
             if (exponent - boost::math::round(exponent) < 1e-9)
                 unit = v1.getUnit().pow(exponent);
@@ -2210,17 +2251,13 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
     }
     case HYPOT:
     case CATH:
-        if (e2.isNone())
+        if (!v2)
             _EXPR_THROW("Invalid second argument.",expr);
-        if (v1.getUnit() != v2.getUnit())
+        if (v1.getUnit() != v2->getUnit())
             _EXPR_THROW("Units must be equal.",expr);
 
-        if (args.size() > 2) {
-            if (e3.isNone())
-                _EXPR_THROW("Invalid second argument.",expr);
-            if (v2.getUnit() != v3.getUnit())
-                _EXPR_THROW("Units must be equal.",expr);
-        }
+        if (v3 && v2->getUnit() != v3->getUnit())
+            _EXPR_THROW("Units must be equal.",expr);
         unit = v1.getUnit();
         break;
     default:
@@ -2272,23 +2309,23 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         output = cosh(value);
         break;
     case MOD: {
-        output = fmod(value, v2.getValue());
+        output = fmod(value, v2->getValue());
         break;
     }
     case ATAN2: {
-        output = atan2(value, v2.getValue());
+        output = atan2(value, v2->getValue());
         break;
     }
     case POW: {
-        output = pow(value, v2.getValue());
+        output = pow(value, v2->getValue());
         break;
     }
     case HYPOT: {
-        output = sqrt(pow(v1.getValue(), 2) + pow(v2.getValue(), 2) + (!e3.isNone() ? pow(v3.getValue(), 2) : 0));
+        output = sqrt(pow(v1.getValue(), 2) + pow(v2->getValue(), 2) + (v3 ? pow(v3->getValue(), 2) : 0));
         break;
     }
     case CATH: {
-        output = sqrt(pow(v1.getValue(), 2) - pow(v2.getValue(), 2) - (!e3.isNone() ? pow(v3.getValue(), 2) : 0));
+        output = sqrt(pow(v1.getValue(), 2) - pow(v2->getValue(), 2) - (v3 ? pow(v3->getValue(), 2) : 0));
         break;
     }
     case ROUND:
@@ -2307,13 +2344,246 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         _EXPR_THROW("Unknown function: " << f,expr);
     }
 
-    return Py::asObject(new QuantityPy(new Quantity(scaler * output, unit)));
+    return Quantity(scaler * output, unit);
+}
+
+static Collector *createCollector(int f)
+{
+    switch (f) {
+    case FunctionExpression::SUM:
+        return new SumCollector;
+    case FunctionExpression::AVERAGE:
+        return new AverageCollector;
+    case FunctionExpression::STDDEV:
+        return new StdDevCollector;
+    case FunctionExpression::COUNT:
+        return new CountCollector;
+    case FunctionExpression::MIN:
+        return new MinCollector;
+    case FunctionExpression::MAX:
+        return new MaxCollector;
+    default:
+        assert(false);
+        return new Collector;
+    }
+}
+
+static void collectRange(const Expression *owner, Collector &c, const RangeExpression &expr)
+{
+    Range range(expr.getRange());
+
+    do {
+        Property * p = owner->getOwner()->getPropertyByName(range.address().c_str());
+        PropertyQuantity * qp;
+        PropertyFloat * fp;
+        PropertyInteger * ip;
+
+        if (!p)
+            continue;
+
+        if ((qp = freecad_dynamic_cast<PropertyQuantity>(p)) != 0)
+            c.collect(qp->getQuantityValue());
+        else if ((fp = freecad_dynamic_cast<PropertyFloat>(p)) != 0)
+            c.collect(Quantity(fp->getValue()));
+        else if ((ip = freecad_dynamic_cast<PropertyInteger>(p)) != 0)
+            c.collect(Quantity(ip->getValue()));
+        else
+            _EXPR_THROW("Invalid property type for aggregate.", owner);
+    } while (range.next());
+}
+
+Py::Object FunctionExpression::evalAggregate(
+        const Expression *owner, int f, const std::vector<Expression*> &args)
+{
+    std::unique_ptr<Collector> c(createCollector(f));
+
+    for (auto &arg : args) {
+        if (arg->isDerivedFrom(RangeExpression::getClassTypeId()))
+            collectRange(owner, *c, static_cast<const RangeExpression&>(*arg));
+        else {
+            Quantity q;
+            if(pyToQuantity(q,arg->getPyValue()))
+                c->collect(q);
+        }
+    }
+
+    return pyFromQuantity(c->getQuantity());
+}
+
+bool FunctionExpression::evalAggregate(const Expression *owner,
+        int f, const std::vector<Expression*> &args, NativeValue &value)
+{
+    std::unique_ptr<Collector> c(createCollector(f));
+
+    for (auto &arg : args) {
+        if (arg->isDerivedFrom(RangeExpression::getClassTypeId()))
+            collectRange(owner, *c, static_cast<const RangeExpression&>(*arg));
+        else {
+            NativeValue v;
+            if (!arg->getNativeValue(v))
+                return false;
+            c->collect(v.quantity);
+        }
+    }
+
+    nativeFromQuantity(c->getQuantity(), value);
+    return true;
+}
+
+Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std::vector<Expression*> &args)
+{
+    if(!expr || !expr->getOwner())
+        _EXPR_THROW("Invalid owner.", expr);
+
+    // Handle aggregate functions
+    if (f > AGGREGATES)
+        return evalAggregate(expr, f, args);
+
+    if(f == LIST) {
+        if(args.size() == 1 && args[0]->isDerivedFrom(RangeExpression::getClassTypeId()))
+            return args[0]->getPyValue();
+        Py::List list(args.size());
+        int i=0;
+        for(auto &arg : args)
+            list.setItem(i++,arg->getPyValue());
+        return list;
+    } else if (f == TUPLE) {
+        if(args.size() == 1 && args[0]->isDerivedFrom(RangeExpression::getClassTypeId()))
+            return Py::Tuple(args[0]->getPyValue());
+        Py::Tuple tuple(args.size());
+        int i=0;
+        for(auto &arg : args)
+            tuple.setItem(i++,arg->getPyValue());
+        return tuple;
+    } else if (f == MSCALE) {
+        if(args.size() < 2)
+            _EXPR_THROW("Function requires at least two arguments.",expr);
+        Py::Object pymat = args[0]->getPyValue();
+        Py::Object pyscale;
+        if(PyObject_TypeCheck(pymat.ptr(),&Base::MatrixPy::Type)) {
+            if(args.size() == 2) {
+                Py::Object obj = args[1]->getPyValue();
+                if(obj.isSequence() && PySequence_Size(obj.ptr())==3)
+                    pyscale = Py::Tuple(Py::Sequence(obj));
+            } else if(args.size() == 4) {
+                Py::Tuple tuple(3);
+                tuple.setItem(0,args[1]->getPyValue());
+                tuple.setItem(1,args[2]->getPyValue());
+                tuple.setItem(2,args[3]->getPyValue());
+                pyscale = tuple;
+            }
+        }
+        if(!pyscale.isNone()) {
+            Base::Vector3d vec;
+            if (!PyArg_ParseTuple(pyscale.ptr(), "ddd", &vec.x,&vec.y,&vec.z))
+                PyErr_Clear();
+            else {
+                auto mat = static_cast<Base::MatrixPy*>(pymat.ptr())->value();
+                mat.scale(vec);
+                return Py::asObject(new Base::MatrixPy(mat));
+            }
+        }
+        _EXPR_THROW("Function requires arguments to be either "
+                "(matrix,vector) or (matrix,number,number,number).", expr);
+    }
+
+    if(args.empty())
+        _EXPR_THROW("Function requires at least one argument.",expr);
+
+    if (f == MINVERT) {
+        Py::Object pyobj = args[0]->getPyValue();
+        if (PyObject_TypeCheck(pyobj.ptr(),&Base::MatrixPy::Type)) {
+            auto m = static_cast<Base::MatrixPy*>(pyobj.ptr())->value();
+            if (fabs(m.determinant()) <= DBL_EPSILON)
+                _EXPR_THROW("Cannot invert singular matrix.",expr);
+            m.inverseGauss();
+            return Py::asObject(new Base::MatrixPy(m));
+
+        } else if (PyObject_TypeCheck(pyobj.ptr(),&Base::PlacementPy::Type)) {
+            const auto &pla = *static_cast<Base::PlacementPy*>(pyobj.ptr())->getPlacementPtr();
+            return Py::asObject(new Base::PlacementPy(pla.inverse()));
+
+        } else if (PyObject_TypeCheck(pyobj.ptr(),&Base::RotationPy::Type)) {
+            const auto &rot = *static_cast<Base::RotationPy*>(pyobj.ptr())->getRotationPtr();
+            return Py::asObject(new Base::RotationPy(rot.inverse()));
+        }
+         _EXPR_THROW("Function requires the first argument to be either Matrix, Placement or Rotation.",expr);
+
+    } else if (f == CREATE) {
+        Py::Object pytype = args[0]->getPyValue();
+        if(!pytype.isString())
+            _EXPR_THROW("Function requires the first argument to be a string.",expr);
+        std::string type(pytype.as_string());
+        Py::Object res;
+        if(boost::iequals(type,"matrix"))
+            res = Py::asObject(new Base::MatrixPy(Base::Matrix4D()));
+        else if(boost::iequals(type,"vector"))
+            res = Py::asObject(new Base::VectorPy(Base::Vector3d()));
+        else if(boost::iequals(type,"placement"))
+            res = Py::asObject(new Base::PlacementPy(Base::Placement()));
+        else if(boost::iequals(type,"rotation"))
+            res = Py::asObject(new Base::RotationPy(Base::Rotation()));
+        else
+            _EXPR_THROW("Unknown type '" << type << "'.",expr);
+        if(args.size()>1) {
+            Py::Tuple tuple(args.size()-1);
+            for(unsigned i=1;i<args.size();++i)
+                tuple.setItem(i-1,args[i]->getPyValue());
+            Py::Dict dict;
+            PyObjectBase::__PyInit(res.ptr(),tuple.ptr(),dict.ptr());
+        }
+        return res;
+    }
+
+    Quantity v1 = pyToQuantity(args[0]->getPyValue(),expr,"Invalid first argument.");
+    Quantity v2;
+    if(args.size()>1)
+        v2 = pyToQuantity(args[1]->getPyValue(),expr,"Invalid second argument.");
+    Quantity v3;
+    if(args.size()>2)
+        v3 = pyToQuantity(args[2]->getPyValue(),expr,"Invalid third argument.");
+
+    return Py::asObject(new QuantityPy(new Quantity(
+                    evalMath(expr, f, v1, args.size()>1?&v2:0, args.size()>2?&v3:0))));
 }
 
 Py::Object FunctionExpression::_getPyValue() const {
     return evaluate(this,f,args);
 }
 
+bool FunctionExpression::_getNativeValue(NativeValue &value) const {
+    if(!getOwner())
+        return false;
+
+    if (f > AGGREGATES)
+        return evalAggregate(this, f, args, value);
+
+    switch(f) {
+    case LIST:
+    case TUPLE:
+    case MSCALE:
+    case MINVERT:
+    case CREATE:
+        return false;
+    default:
+        break;
+    }
+
+    if(args.empty() || args.size()>3)
+        return false;
+
+    Quantity v[3];
+    for(size_t i=0;i<args.size();++i) {
+        NativeValue arg;
+        if(!args[i]->getNativeValue(arg))
+            return false;
+        v[i] = arg.quantity;
+    }
+    value.type = NativeValue::TypeQuantity;
+    value.quantity = evalMath(this, f, v[0], args.size()>1?&v[1]:0, args.size()>2?&v[2]:0);
+    return true;
+}
+
 /**
   * Try to simplify the expression, i.e calculate all constant expressions.
   *
@@ -2567,6 +2837,33 @@ Py::Object VariableExpression::_getPyValue() const {
     return var.getPyValue(true);
 }
 
+bool VariableExpression::_getNativeValue(NativeValue &value) const {
+    // Only plain property access, no pseudo property, sub-object or
+    // attribute path, which needs Python
+    if(var.getSubObjectName().size() || var.numSubComponents()!=1)
+        return false;
+    int ptype;
+    Property *prop = var.getProperty(&ptype);
+    if(!prop || ptype)
+        return false;
+
+    if(prop->isDerivedFrom(PropertyQuantity::getClassTypeId())) {
+        value.type = NativeValue::TypeQuantity;
+        value.quantity = static_cast<PropertyQuantity*>(prop)->getQuantityValue();
+    } else if(prop->isDerivedFrom(PropertyFloat::getClassTypeId())) {
+        value.type = NativeValue::TypeFloat;
+        value.quantity = Quantity(static_cast<PropertyFloat*>(prop)->getValue());
+    } else if(prop->isDerivedFrom(PropertyInteger::getClassTypeId())) {
+        value.type = NativeValue::TypeInt;
+        value.quantity = Quantity(static_cast<PropertyInteger*>(prop)->getValue());
+    } else if(prop->isDerivedFrom(PropertyBool::getClassTypeId())) {
+        value.type = NativeValue::TypeBool;
+        value.quantity = Quantity(static_cast<PropertyBool*>(prop)->getValue()?1.0:0.0);
+    } else
+        return false;
+    return true;
+}
+
 void VariableExpression::_toString(std::ostream &ss, bool persistent,int) const {
     if(persistent)
         ss << var.toPersistentString();
@@ -2841,6 +3138,16 @@ Py::Object ConditionalExpression::_getPyValue() const {
         return falseExpr->getPyValue();
 }
 
+bool ConditionalExpression::_getNativeValue(NativeValue &value) const {
+    NativeValue cond;
+    if(!condition->getNativeValue(cond))
+        return false;
+    if(cond.isTrue())
+        return trueExpr->getNativeValue(value);
+    else
+        return falseExpr->getNativeValue(value);
+}
+
 Expression *ConditionalExpression::simplify() const
 {
     std::unique_ptr<Expression> e(condition->simplify());
@@ -2927,6 +3234,17 @@ Py::Object ConstantExpression::_getPyValue() const {
     return Py::Object(cache);
 }
 
+bool ConstantExpression::_getNativeValue(NativeValue &value) const {
+    if(strcmp(name,"None")==0)
+        return false;
+    if(strcmp(name,"True")==0 || strcmp(name,"False")==0) {
+        value.type = NativeValue::TypeBool;
+        value.quantity = Quantity(strcmp(name,"True")==0?1.0:0.0);
+        return true;
+    }
+    return NumberExpression::_getNativeValue(value);
+}
+
 bool ConstantExpression::isNumber() const {
     return strcmp(name,"None")
         && strcmp(name,"True")
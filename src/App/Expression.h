@@ -180,6 +180,36 @@ public:
 
     Py::Object getPyValue() const;
 
+    /** Value of the native expression evaluation
+     *
+     * The type follows the Python object that getPyValue() would return, so
+     * that both ways of evaluation give the same result.
+     */
+    struct NativeValue {
+        enum ValueType {
+            TypeBool,
+            TypeInt,
+            TypeFloat,
+            TypeQuantity,
+        };
+        ValueType type = TypeInt;
+        /// holds the value of any type, with unit only for TypeQuantity
+        Base::Quantity quantity;
+
+        bool isTrue() const { return quantity.getValue() != 0.0; }
+        App::any toAny() const;
+    };
+
+    /** Evaluate the expression without the Python interpreter
+     *
+     * @param value: output the evaluated value
+     *
+     * @return Return false if the expression is not purely numeric, or if
+     * the evaluation fails. The caller shall then use getPyValue(), which
+     * also reports any error.
+     */
+    bool getNativeValue(NativeValue &value) const;
+
     bool isSame(const Expression &other) const;
 
     friend ExpressionVisitor;
@@ -208,6 +238,7 @@ protected:
     virtual void _moveCells(const CellAddress &, int, int, ExpressionVisitor &) {}
     virtual void _offsetCells(int, int, ExpressionVisitor &) {}
     virtual Py::Object _getPyValue() const = 0;
+    virtual bool _getNativeValue(NativeValue &) const {return false;}
     virtual void _visit(ExpressionVisitor &) {}
 
 protected:
@@ -95,6 +95,7 @@ protected:
     virtual Expression * _copy() const override;
     virtual void _toString(std::ostream &ss, bool persistent, int indent) const override;
     virtual Py::Object _getPyValue() const override;
+    virtual bool _getNativeValue(NativeValue &value) const override;
 
 protected:
     mutable PyObject *cache = 0;
@@ -137,6 +138,7 @@ public:
 
 protected:
     virtual Py::Object _getPyValue() const override;
+    virtual bool _getNativeValue(NativeValue &value) const override;
     virtual void _toString(std::ostream &ss, bool persistent, int indent) const override;
     virtual Expression* _copy() const override;
 
@@ -191,6 +193,8 @@ protected:
 
     virtual Py::Object _getPyValue() const override;
 
+    virtual bool _getNativeValue(NativeValue &value) const override;
+
     virtual void _toString(std::ostream &ss, bool persistent, int indent) const override;
 
     virtual void _visit(ExpressionVisitor & v) override;
@@ -224,6 +228,7 @@ protected:
     virtual void _visit(ExpressionVisitor & v) override;
     virtual void _toString(std::ostream &ss, bool persistent, int indent) const override;
     virtual Py::Object _getPyValue() const override;
+    virtual bool _getNativeValue(NativeValue &value) const override;
 
 protected:
 
@@ -300,7 +305,12 @@ public:
 
 protected:
     static Py::Object evalAggregate(const Expression *owner, int type, const std::vector<Expression*> &args);
+    static bool evalAggregate(const Expression *owner, int type,
+            const std::vector<Expression*> &args, NativeValue &value);
+    static Base::Quantity evalMath(const Expression *owner, int type, const Base::Quantity &v1,
+            const Base::Quantity *v2, const Base::Quantity *v3);
     virtual Py::Object _getPyValue() const override;
+    virtual bool _getNativeValue(NativeValue &value) const override;
     virtual Expression * _copy() const override;
     virtual void _visit(ExpressionVisitor & v) override;
     virtual void _toString(std::ostream &ss, bool persistent, int indent) const override;
@@ -342,6 +352,7 @@ public:
 protected:
     virtual Expression * _copy() const override;
     virtual Py::Object _getPyValue() const override;
+    virtual bool _getNativeValue(NativeValue &value) const override;
     virtual void _toString(std::ostream &ss, bool persistent, int indent) const override;
     virtual bool _isIndexable() const override;
     virtual void _getDeps(ExpressionDeps &) const override;
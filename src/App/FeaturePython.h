@@ -284,6 +284,11 @@ public:
         }
     }
 
+    /// Python features are never recomputed in a worker thread
+    virtual bool canRecomputeInThread() const override {
+        return false;
+    }
+
     virtual bool redirectSubName(std::ostringstream &ss,
             App::DocumentObject *topParent, App::DocumentObject *child) const override 
     {
@@ -108,6 +108,8 @@ public:
   virtual short mustExecute(void) const;
   /// recalculate the Feature
   virtual DocumentObjectExecReturn *execute(void);
+  /// the test feature only changes its own properties
+  virtual bool canRecomputeInThread() const {return true;}
   /// returns the type name of the ViewProvider
   //FIXME: Probably it makes sense to have a view provider for unittests (e.g. Gui::ViewProviderTest)
   virtual const char* getViewProviderName(void) const {
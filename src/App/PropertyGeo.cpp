@@ -977,11 +977,53 @@ PropertyGeometry::~PropertyGeometry()
 TYPESYSTEM_SOURCE_ABSTRACT(App::PropertyComplexGeoData , App::PropertyGeometry)
 
 PropertyComplexGeoData::PropertyComplexGeoData()
+  : deferredPending(false)
 {
 
 }
 
 PropertyComplexGeoData::~PropertyComplexGeoData()
 {
+    discardDeferred();
+}
 
+void PropertyComplexGeoData::addDeferredFile(Base::XMLReader &reader, const char* file)
+{
+    discardDeferred();
+    deferredFiles = reader.addDeferredFile(file, this);
+    deferredPending = deferredFiles != nullptr;
+}
+
+void PropertyComplexGeoData::restoreDeferred() const
+{
+    // The pointer to the pending files is only changed by the modifying methods
+    // while several threads may read the data. DeferredFiles restores the data
+    // once and lets the other threads wait for it.
+    if (deferredPending) {
+        // the data is not modified but only completed
+        PropertyComplexGeoData* self = const_cast<PropertyComplexGeoData*>(this);
+        if (deferredFiles->restore(self))
+            deferredPending = false;
+    }
+}
+
+void PropertyComplexGeoData::discardDeferred()
+{
+    deferredPending = false;
+    if (deferredFiles) {
+        deferredFiles->remove(this);
+        deferredFiles.reset();
+    }
+}
+
+bool PropertyComplexGeoData::isDeferred() const
+{
+    return deferredPending;
+}
+
+unsigned int PropertyComplexGeoData::getDeferredSize() const
+{
+    if (!deferredPending)
+        return 0;
+    return deferredFiles->getSize(const_cast<PropertyComplexGeoData*>(this));
 }
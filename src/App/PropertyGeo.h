@@ -26,6 +26,8 @@
 
 // Std. configurations
 
+#include <atomic>
+#include <memory>
 #include <Base/Vector3D.h>
 #include <Base/Matrix.h>
 #include <Base/BoundBox.h>
@@ -38,6 +40,8 @@
 
 namespace Base {
 class Writer;
+class XMLReader;
+class DeferredFiles;
 }
 
 namespace Data {
@@ -450,6 +454,29 @@ public:
     virtual const Data::ComplexGeoData* getComplexData() const = 0;
     virtual Base::BoundBox3d getBoundingBox() const = 0;
     //@}
+
+protected:
+    /** @name Deferred restore
+     * The data file of a property can be restored when the data is accessed
+     * the first time instead of while restoring the document.
+     * \see Base::XMLReader::addDeferredFile()
+     */
+    //@{
+    /// register the data file with the reader, either to read it now or later
+    void addDeferredFile(Base::XMLReader &reader, const char* file);
+    /// restore the data if its file is still pending, thread-safe
+    void restoreDeferred() const;
+    /// forget a pending file because the data gets replaced
+    void discardDeferred();
+    /// true if the data file is still pending
+    bool isDeferred() const;
+    /// the uncompressed size of the pending data file
+    unsigned int getDeferredSize() const;
+    //@}
+
+private:
+    std::shared_ptr<Base::DeferredFiles> deferredFiles;
+    mutable std::atomic<bool> deferredPending;
 };
 
 } // namespace App
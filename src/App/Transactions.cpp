@@ -52,6 +52,8 @@ TYPESYSTEM_SOURCE(App::Transaction, Base::Persistence)
 // Construction/Destruction
 
 Transaction::Transaction(int id)
+  : memSizeCommitted(false)
+  , memSize(0)
 {
     if(!id) id = getNewID();
     transID = id;
@@ -112,7 +114,19 @@ int Transaction::getLastID() {
 
 unsigned int Transaction::getMemSize (void) const
 {
-    return 0;
+    if (memSizeCommitted)
+        return memSize;
+    unsigned int size = 0;
+    for (auto &v : _Objects)
+        size += v.second->getMemSize();
+    return size;
+}
+
+void Transaction::commitMemSize()
+{
+    memSizeCommitted = false;
+    memSize = getMemSize();
+    memSizeCommitted = true;
 }
 
 void Transaction::Save (Base::Writer &/*writer*/) const
@@ -406,7 +420,15 @@ void TransactionObject::addOrRemoveProperty(const Property* pcProp, bool add)
 
 unsigned int TransactionObject::getMemSize (void) const
 {
-    return 0;
+    // Copies of properties with heavy data may share it with the live
+    // property until either of them is modified. Such properties only
+    // report their part of the shared data.
+    unsigned int size = 0;
+    for (auto &v : _PropChangeMap) {
+        if (v.second.property)
+            size += v.second.property->getMemSize();
+    }
+    return size;
 }
 
 void TransactionObject::Save (Base::Writer &/*writer*/) const
@@ -65,7 +65,12 @@ public:
     // the utf-8 name of the transaction
     std::string Name;
 
+    /** Returns the memory size stored by commitMemSize(), or computes it
+     * for a transaction that is still being recorded.
+     */
     virtual unsigned int getMemSize (void) const;
+    /// Computes and stores the memory size once the transaction is complete
+    void commitMemSize();
     virtual void Save (Base::Writer &writer) const;
     /// This method is used to restore properties from an XML document.
     virtual void Restore(Base::XMLReader &reader);
@@ -89,6 +94,8 @@ public:
 
 private:
     int transID;
+    bool memSizeCommitted;
+    unsigned int memSize;
     typedef std::pair<const TransactionalObject*, TransactionObject*> Info;
     bmi::multi_index_container<
         Info,
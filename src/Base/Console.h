@@ -564,6 +564,9 @@ namespace Base {
             /// Enables or disables message types of a certain console observer
             bool IsMsgTypeEnabled(const char* sObs, FreeCAD_ConsoleMsgType type) const;
             void SetConnectionMode(ConnectionMode mode);
+            ConnectionMode GetConnectionMode() const {
+                return connectionMode;
+            }
 
             int *GetLogLevel(const char *tag, bool create=true);
 
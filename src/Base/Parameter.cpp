@@ -427,15 +427,12 @@ bool ParameterGrp::HasGroup(const char* Name) const
 
 bool ParameterGrp::GetBool(const char* Name, bool bPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCBool",Name);
+    std::lock_guard<std::mutex> lock(_CacheMutex);
+    const auto &values = GetValueCache().Bools;
+    auto it = values.find(Name);
     // if not return preset
-    if (!pcElem) return bPreset;
-    // if yes check the value and return
-    if (strcmp(StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),"1"))
-        return false;
-    else
-        return true;
+    if (it == values.end()) return bPreset;
+    return it->second;
 }
 
 void  ParameterGrp::SetBool(const char* Name, bool bValue)
@@ -445,6 +442,11 @@ void  ParameterGrp::SetBool(const char* Name, bool bValue)
     if (pcElem) {
         // and set the value
         pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(bValue?"1":"0").unicodeForm());
+        {
+            std::lock_guard<std::mutex> lock(_CacheMutex);
+            if (_Cache)
+                _Cache->Bools[Name] = bValue;
+        }
         // trigger observer
         Notify(Name);
     }
@@ -496,12 +498,12 @@ std::vector<std::pair<std::string,bool> > ParameterGrp::GetBoolMap(const char *
 
 long ParameterGrp::GetInt(const char* Name, long lPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCInt",Name);
+    std::lock_guard<std::mutex> lock(_CacheMutex);
+    const auto &values = GetValueCache().Ints;
+    auto it = values.find(Name);
     // if not return preset
-    if (!pcElem) return lPreset;
-    // if yes check the value and return
-    return atol (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str());
+    if (it == values.end()) return lPreset;
+    return it->second;
 }
 
 void  ParameterGrp::SetInt(const char* Name, long lValue)
@@ -513,6 +515,11 @@ void  ParameterGrp::SetInt(const char* Name, long lValue)
         // and set the value
         sprintf(cBuf,"%li",lValue);
         pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+        {
+            std::lock_guard<std::mutex> lock(_CacheMutex);
+            if (_Cache)
+                _Cache->Ints[Name] = lValue;
+        }
         // trigger observer
         Notify(Name);
     }
@@ -559,12 +566,12 @@ std::vector<std::pair<std::string,long> > ParameterGrp::GetIntMap(const char * s
 
 unsigned long ParameterGrp::GetUnsigned(const char* Name, unsigned long lPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCUInt",Name);
+    std::lock_guard<std::mutex> lock(_CacheMutex);
+    const auto &values = GetValueCache().Unsigneds;
+    auto it = values.find(Name);
     // if not return preset
-    if (!pcElem) return lPreset;
-    // if yes check the value and return
-    return strtoul (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),0,10);
+    if (it == values.end()) return lPreset;
+    return it->second;
 }
 
 void  ParameterGrp::SetUnsigned(const char* Name, unsigned long lValue)
@@ -576,6 +583,11 @@ void  ParameterGrp::SetUnsigned(const char* Name, unsigned long lValue)
         // and set the value
         sprintf(cBuf,"%lu",lValue);
         pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+        {
+            std::lock_guard<std::mutex> lock(_CacheMutex);
+            if (_Cache)
+                _Cache->Unsigneds[Name] = lValue;
+        }
         // trigger observer
         Notify(Name);
     }
@@ -622,12 +634,12 @@ std::vector<std::pair<std::string,unsigned long> > ParameterGrp::GetUnsignedMap(
 
 double ParameterGrp::GetFloat(const char* Name, double dPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCFloat",Name);
+    std::lock_guard<std::mutex> lock(_CacheMutex);
+    const auto &values = GetValueCache().Floats;
+    auto it = values.find(Name);
     // if not return preset
-    if (!pcElem) return dPreset;
-    // if yes check the value and return
-    return atof (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str());
+    if (it == values.end()) return dPreset;
+    return it->second;
 }
 
 void  ParameterGrp::SetFloat(const char* Name, double dValue)
@@ -639,6 +651,12 @@ void  ParameterGrp::SetFloat(const char* Name, double dValue)
         // and set the value
         sprintf(cBuf,"%.12f",dValue); // use %.12f instead of %f to handle values < 1.0e-6
         pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+        {
+            // keep the value that is read back from the DOM
+            std::lock_guard<std::mutex> lock(_CacheMutex);
+            if (_Cache)
+                _Cache->Floats[Name] = atof(cBuf);
+        }
         // trigger observer
         Notify(Name);
     }
@@ -712,6 +730,11 @@ void  ParameterGrp::SetASCII(const char* Name, const char *sValue)
         else {
             pcElem2->setNodeValue(XUTF8Str(sValue).unicodeForm());
         }
+        {
+            std::lock_guard<std::mutex> lock(_CacheMutex);
+            if (_Cache)
+                _Cache->ASCIIs[Name] = sValue;
+        }
         // trigger observer
         Notify(Name);
     }
@@ -719,22 +742,14 @@ void  ParameterGrp::SetASCII(const char* Name, const char *sValue)
 
 std::string ParameterGrp::GetASCII(const char* Name, const char * pPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCText",Name);
+    std::lock_guard<std::mutex> lock(_CacheMutex);
+    const auto &values = GetValueCache().ASCIIs;
+    auto it = values.find(Name);
+    if (it != values.end())
+        return it->second;
     // if not return preset
-    if (!pcElem) {
-        if (pPreset==0)
-            return std::string("");
-        else
-            return std::string(pPreset);
-    }
-    // if yes check the value and return
-    DOMNode *pcElem2 = pcElem->getFirstChild();
-    if (pcElem2)
-        return std::string(StrXUTF8(pcElem2->getNodeValue()).c_str());
     else if (pPreset==0)
         return std::string("");
-
     else
         return std::string(pPreset);
 }
@@ -796,6 +811,8 @@ void ParameterGrp::RemoveASCII(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    // the cache is rebuilt in case there is another element of that name
+    ClearValueCache();
 
     // trigger observer
     Notify(Name);
@@ -811,6 +828,8 @@ void ParameterGrp::RemoveBool(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    // the cache is rebuilt in case there is another element of that name
+    ClearValueCache();
 
     // trigger observer
     Notify(Name);
@@ -839,6 +858,8 @@ void ParameterGrp::RemoveFloat(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    // the cache is rebuilt in case there is another element of that name
+    ClearValueCache();
 
     // trigger observer
     Notify(Name);
@@ -854,6 +875,8 @@ void ParameterGrp::RemoveInt(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    // the cache is rebuilt in case there is another element of that name
+    ClearValueCache();
 
     // trigger observer
     Notify(Name);
@@ -869,6 +892,8 @@ void ParameterGrp::RemoveUnsigned(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    // the cache is rebuilt in case there is another element of that name
+    ClearValueCache();
 
     // trigger observer
     Notify(Name);
@@ -964,6 +989,7 @@ void ParameterGrp::Clear(void)
         DOMNode *child = _pGroupNode->removeChild(*it);
         child->release();
     }
+    ClearValueCache();
 
     // trigger observer
     Notify("");
@@ -984,6 +1010,58 @@ bool ParameterGrp::ShouldRemove() const
     return true;
 }
 
+ParameterGrp::ValueCache& ParameterGrp::GetValueCache() const
+{
+    if (_Cache)
+        return *_Cache;
+
+    // Walk the DOM once and keep the first element of every type and name
+    // like FindElement() would find it
+    _Cache.reset(new ValueCache);
+    if (!_pGroupNode)
+        return *_Cache;
+
+    XStr nameAttr("Name");
+    XStr valueAttr("Value");
+    for (DOMNode *clChild = _pGroupNode->getFirstChild(); clChild != 0;  clChild = clChild->getNextSibling()) {
+        if (clChild->getNodeType() != DOMNode::ELEMENT_NODE)
+            continue;
+        DOMElement *pcElem = static_cast<DOMElement*>(clChild);
+        DOMNode *pcName = pcElem->getAttributes()->getNamedItem(nameAttr.unicodeForm());
+        if (!pcName)
+            continue;
+
+        std::string Type = StrX(pcElem->getNodeName()).c_str();
+        std::string Name = StrX(pcName->getNodeValue()).c_str();
+        if (Type == "FCBool") {
+            _Cache->Bools.emplace(Name, !strcmp(StrX(pcElem->getAttribute(valueAttr.unicodeForm())).c_str(),"1"));
+        }
+        else if (Type == "FCInt") {
+            _Cache->Ints.emplace(Name, atol(StrX(pcElem->getAttribute(valueAttr.unicodeForm())).c_str()));
+        }
+        else if (Type == "FCUInt") {
+            _Cache->Unsigneds.emplace(Name, strtoul(StrX(pcElem->getAttribute(valueAttr.unicodeForm())).c_str(),0,10));
+        }
+        else if (Type == "FCFloat") {
+            _Cache->Floats.emplace(Name, atof(StrX(pcElem->getAttribute(valueAttr.unicodeForm())).c_str()));
+        }
+        else if (Type == "FCText") {
+            // an element without text is handled like a missing element
+            DOMNode *pcText = pcElem->getFirstChild();
+            if (pcText)
+                _Cache->ASCIIs.emplace(Name, std::string(StrXUTF8(pcText->getNodeValue()).c_str()));
+        }
+    }
+
+    return *_Cache;
+}
+
+void ParameterGrp::ClearValueCache()
+{
+    std::lock_guard<std::mutex> lock(_CacheMutex);
+    _Cache.reset();
+}
+
 XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *ParameterGrp::FindElement(XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *Start, const char* Type, const char* Name) const
 {
     if (XMLString::compareString(Start->getNodeName(), XStr("FCParamGroup").unicodeForm()) != 0 &&
@@ -1357,6 +1435,7 @@ int ParameterManager::LoadDocument(const XERCES_CPP_NAMESPACE_QUALIFIER InputSou
 
     if (!_pGroupNode)
         throw XMLBaseException("Malformed Parameter document: Root group not found");
+    ClearValueCache();
 
     return 1;
 }
@@ -1533,6 +1612,7 @@ void  ParameterManager::CreateDocument(void)
     _pGroupNode = _pDocument->createElement(XStr("FCParamGroup").unicodeForm());
     static_cast<DOMElement*>(_pGroupNode)->setAttribute(XStr("Name").unicodeForm(), XStr("Root").unicodeForm());
     rootElem->appendChild(_pGroupNode);
+    ClearValueCache();
 }
 
 void  ParameterManager::CheckDocument() const
@@ -58,6 +58,10 @@
 #endif
 
 #include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <xercesc/util/XercesDefs.hpp>
 
@@ -263,6 +267,22 @@ protected:
      */
     XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *FindOrCreateElement(XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *Start, const char* Type, const char* Name) const;
 
+    /** The values of the group by type and name
+     *  It is built from the DOM on the first access of a single value and then
+     *  kept up to date by the methods that set or remove values, before the
+     *  observers are notified.
+     */
+    struct ValueCache {
+        std::unordered_map<std::string, bool> Bools;
+        std::unordered_map<std::string, long> Ints;
+        std::unordered_map<std::string, unsigned long> Unsigneds;
+        std::unordered_map<std::string, double> Floats;
+        std::unordered_map<std::string, std::string> ASCIIs;
+    };
+    /// returns the value cache, _CacheMutex must be locked
+    ValueCache& GetValueCache() const;
+    /// drops the value cache, e.g. after the DOM has been replaced
+    void ClearValueCache();
 
     /// DOM Node of the Base node of this group
     XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *_pGroupNode;
@@ -270,6 +290,9 @@ protected:
     std::string _cName;
     /// map of already exported groups
     std::map <std::string ,Base::Reference<ParameterGrp> > _GroupMap;
+    /// cache of the values of this group
+    mutable std::unique_ptr<ValueCache> _Cache;
+    mutable std::mutex _CacheMutex;
 
 };
 
@@ -61,6 +61,7 @@
 #include <set>
 #include <stack>
 #include <queue>
+#include <deque>
 #include <memory>
 #include <bitset>
 
@@ -120,6 +121,10 @@
 #include <QReadWriteLock>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
 #include <QTime>
 #include <QUuid>
 
@@ -380,6 +380,22 @@ const char *Base::XMLReader::addFile(const char* Name, Base::Persistence *Object
     return Name;
 }
 
+std::shared_ptr<Base::DeferredFiles> Base::XMLReader::addDeferredFile(const char* Name, Base::Persistence *Object)
+{
+    if (!Deferred) {
+        addFile(Name, Object);
+        return std::shared_ptr<DeferredFiles>();
+    }
+
+    Deferred->add(Name, FileVersion, Object);
+    return Deferred;
+}
+
+void Base::XMLReader::setDeferredFiles(const std::shared_ptr<DeferredFiles>& files)
+{
+    Deferred = files;
+}
+
 const std::vector<std::string>& Base::XMLReader::getFilenames() const
 {
     return FileNames;
@@ -563,8 +579,8 @@ void Base::XMLReader::clearPartialRestoreObject(void)
 
 // ----------------------------------------------------------
 
-Base::Reader::Reader(std::istream& str, const std::string& name, int version)
-  : std::istream(str.rdbuf()), _str(str), _name(name), fileVersion(version)
+Base::Reader::Reader(std::istream& str, const std::string& name, int version, bool deferred)
+  : std::istream(str.rdbuf()), _str(str), _name(name), fileVersion(version), deferred(deferred)
 {
 }
 
@@ -582,6 +598,11 @@ int Base::Reader::getFileVersion() const
     return fileVersion;
 }
 
+bool Base::Reader::isDeferred() const
+{
+    return deferred;
+}
+
 std::istream& Base::Reader::getStream()
 {
     return this->_str;
@@ -596,3 +617,139 @@ std::shared_ptr<Base::XMLReader> Base::Reader::getLocalReader() const
 {
     return(this->localreader);
 }
+
+// ----------------------------------------------------------
+
+Base::DeferredFiles::DeferredFiles(const std::string& archive)
+  : Archive(archive)
+{
+    // the central directory of the archive is read only once and the archive
+    // is kept open until the last pending file is restored
+    try {
+        Zip.reset(new zipios::ZipFile(Archive));
+    }
+    catch (...) {
+        // restore() reports the missing archive
+    }
+}
+
+Base::DeferredFiles::~DeferredFiles()
+{
+}
+
+void Base::DeferredFiles::add(const std::string& FileName, int FileVersion, Base::Persistence *Object)
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    FileEntry entry;
+    entry.FileName = FileName;
+    entry.FileVersion = FileVersion;
+    Files[Object] = entry;
+}
+
+void Base::DeferredFiles::remove(Base::Persistence *Object)
+{
+    std::unique_lock<std::mutex> lock(Mutex);
+    std::map<Base::Persistence*, FileEntry>::iterator it = Files.find(Object);
+    // let a restore by another thread finish first
+    while (it != Files.end() && it->second.Restoring != std::thread::id()) {
+        if (it->second.Restoring == std::this_thread::get_id())
+            return;
+        Restored.wait(lock);
+        it = Files.find(Object);
+    }
+    if (it != Files.end())
+        Files.erase(it);
+    if (Files.empty())
+        Zip.reset();
+}
+
+bool Base::DeferredFiles::restore(Base::Persistence *Object)
+{
+    std::unique_lock<std::mutex> lock(Mutex);
+    std::map<Base::Persistence*, FileEntry>::iterator it = Files.find(Object);
+    // another thread is restoring the object, wait until its data is complete
+    while (it != Files.end() && it->second.Restoring != std::thread::id()) {
+        if (it->second.Restoring == std::this_thread::get_id())
+            return false;
+        Restored.wait(lock);
+        it = Files.find(Object);
+    }
+    if (it == Files.end())
+        return true;
+
+    it->second.Restoring = std::this_thread::get_id();
+    FileEntry entry = it->second;
+
+    // Like XMLReader::readFiles() report the failure and continue
+    try {
+        if (!Zip)
+            throw Base::FileException("Cannot open project archive", Archive);
+        // the stream reads the archive on its own so that the lock isn't needed for it
+        std::unique_ptr<std::istream> str(Zip->getInputStream(entry.FileName));
+        lock.unlock();
+        if (!str)
+            throw Base::FileException("Embedded file not found in project archive", entry.FileName);
+#ifdef _MSC_VER
+        str->imbue(std::locale::empty());
+#else
+        str->imbue(std::locale::classic());
+#endif
+        Base::Reader reader(*str, entry.FileName, entry.FileVersion, true);
+        Object->RestoreDocFile(reader);
+    }
+    catch (const Base::Exception& e) {
+        Base::Console().Error("Reading failed from embedded file: %s (%s)\n", entry.FileName.c_str(), e.what());
+    }
+    catch (const std::exception& e) {
+        Base::Console().Error("Reading failed from embedded file: %s (%s)\n", entry.FileName.c_str(), e.what());
+    }
+    catch (...) {
+        Base::Console().Error("Reading failed from embedded file: %s\n", entry.FileName.c_str());
+    }
+
+    if (!lock.owns_lock())
+        lock.lock();
+    Files.erase(Object);
+    // nothing holds the archive open any more once all files are restored
+    if (Files.empty())
+        Zip.reset();
+    lock.unlock();
+    Restored.notify_all();
+    return true;
+}
+
+bool Base::DeferredFiles::hasPending()
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    return !Files.empty();
+}
+
+void Base::DeferredFiles::restoreAll()
+{
+    for (;;) {
+        Base::Persistence* object = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+            if (Files.empty())
+                break;
+            object = Files.begin()->first;
+        }
+        restore(object);
+    }
+}
+
+unsigned int Base::DeferredFiles::getSize(Base::Persistence *Object)
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    std::map<Base::Persistence*, FileEntry>::iterator it = Files.find(Object);
+    if (it == Files.end() || !Zip)
+        return 0;
+
+    try {
+        zipios::ConstEntryPointer entry = Zip->getEntry(it->second.FileName);
+        return entry ? entry->getSize() : 0;
+    }
+    catch (...) {
+        return 0;
+    }
+}
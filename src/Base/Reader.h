@@ -28,6 +28,9 @@
 #include <map>
 #include <bitset>
 #include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 
 #include <xercesc/framework/XMLPScanToken.hpp>
 #include <xercesc/sax2/Attributes.hpp>
@@ -37,6 +40,7 @@
 #include "Writer.h"
 
 namespace zipios {
+class ZipFile;
 class ZipInputStream;
 }
 
@@ -48,6 +52,7 @@ XERCES_CPP_NAMESPACE_END
 namespace Base
 {
 
+class DeferredFiles;
 
 /** The XML reader class
  * This is an important helper class for the store and retrieval system
@@ -180,6 +185,14 @@ public:
     //@{
     /// add a read request of a persistent object
     const char *addFile(const char* Name, Base::Persistence *Object);
+    /** Add a read request of a persistent object whose data may be restored later on.
+     * If deferring is enabled with setDeferredFiles() the file is not read by readFiles()
+     * and the object must restore it with the returned DeferredFiles once it needs its data.
+     * Otherwise the file is added with addFile() and null is returned.
+     */
+    std::shared_ptr<DeferredFiles> addDeferredFile(const char* Name, Base::Persistence *Object);
+    /// enable deferring of files added with addDeferredFile()
+    void setDeferredFiles(const std::shared_ptr<DeferredFiles>&);
     /// process the requested file writes
     void readFiles(zipios::ZipInputStream &zipstream) const;
     /// get all registered file names
@@ -288,6 +301,7 @@ protected:
     bool _verbose;
 
     std::vector<std::string> FileNames;
+    std::shared_ptr<DeferredFiles> Deferred;
 
     std::bitset<32> StatusBits;
 };
@@ -295,11 +309,13 @@ protected:
 class BaseExport Reader : public std::istream
 {
 public:
-    Reader(std::istream&, const std::string&, int version);
+    Reader(std::istream&, const std::string&, int version, bool deferred = false);
     ~Reader();
     std::istream& getStream();
     std::string getFileName() const;
     int getFileVersion() const;
+    /// true if the file is restored by DeferredFiles after the document has been restored
+    bool isDeferred() const;
     void initLocalReader(std::shared_ptr<Base::XMLReader>);
     std::shared_ptr<Base::XMLReader> getLocalReader() const;
 
@@ -307,9 +323,54 @@ private:
     std::istream& _str;
     std::string _name;
     int fileVersion;
+    bool deferred;
     std::shared_ptr<Base::XMLReader> localreader;
 };
 
+/** The DeferredFiles class keeps track of the files of a project archive
+ * whose restore has been postponed until the data of their objects is needed.
+ * The archive is opened once and must not change as long as files are pending.
+ * The data of an object may be needed by several threads at once, e.g. by a
+ * parallel recompute. Its file is restored only once and the other threads
+ * wait until the data is complete.
+ * \see XMLReader::addDeferredFile()
+ */
+class BaseExport DeferredFiles
+{
+public:
+    explicit DeferredFiles(const std::string& archive);
+    ~DeferredFiles();
+
+    /// register the file of a persistent object
+    void add(const std::string& FileName, int FileVersion, Base::Persistence *Object);
+    /// forget the file of an object, e.g. because its data has been replaced
+    void remove(Base::Persistence *Object);
+    /** Restore the file of an object if it is still pending.
+     * Returns false if the calling thread is restoring the object already, i.e.
+     * if the object accesses its own data while it's restored.
+     */
+    bool restore(Base::Persistence *Object);
+    /// true as long as a file is not restored yet
+    bool hasPending();
+    /// restore the files of all objects
+    void restoreAll();
+    /// the uncompressed size of the pending file of an object, 0 if there is none
+    unsigned int getSize(Base::Persistence *Object);
+
+private:
+    struct FileEntry {
+        std::string FileName;
+        int FileVersion;
+        /// the thread that is restoring the file, if any
+        std::thread::id Restoring;
+    };
+    std::string Archive;
+    std::map<Base::Persistence*, FileEntry> Files;
+    std::unique_ptr<zipios::ZipFile> Zip;
+    std::mutex Mutex;
+    std::condition_variable Restored;
+};
+
 }
 
 
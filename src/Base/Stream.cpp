@@ -492,7 +492,8 @@ IODeviceIStreambuf::seekoff(std::streambuf::off_type off,
                             std::ios_base::openmode /*mode*/)
 {
     off_type endpos = 0;
-    off_type curpos = device->pos();
+    // the device is ahead of the read position by the buffered characters
+    off_type curpos = device->pos() - (egptr() - gptr());
     switch (way) {
         case std::ios_base::beg:
             endpos = off;
@@ -501,16 +502,19 @@ IODeviceIStreambuf::seekoff(std::streambuf::off_type off,
             endpos = curpos + off;
             break;
         case std::ios_base::end:
-            endpos = device->size();
+            endpos = device->size() + off;
             break;
         default:
             return pos_type(off_type(-1));
     }
 
-    if (endpos != curpos) {
-        if (!device->seek(endpos))
-            endpos = -1;
-    }
+    if (!device->seek(endpos))
+        return pos_type(off_type(-1));
+
+    // discard the buffered characters
+    setg (buffer+pbSize,
+          buffer+pbSize,
+          buffer+pbSize);
 
     return pos_type(endpos);
 }
@@ -24,6 +24,12 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <deque>
+# include <memory>
+# include <QRunnable>
+# include <QSemaphore>
+# include <QThread>
+# include <QThreadPool>
 #endif
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
@@ -38,6 +44,7 @@
 #include <algorithm>
 #include <locale>
 #include <limits>
+#include <zlib.h>
 
 using namespace Base;
 using namespace std;
@@ -241,7 +248,7 @@ void Writer::decInd(void)
 // ----------------------------------------------------------------------------
 
 ZipWriter::ZipWriter(const char* FileName) 
-  : ZipStream(FileName)
+  : ZipStream(FileName), FileStream(nullptr), Level(Z_DEFAULT_COMPRESSION)
 {
 #ifdef _MSC_VER
     ZipStream.imbue(std::locale::empty());
@@ -253,7 +260,7 @@ ZipWriter::ZipWriter(const char* FileName)
 }
 
 ZipWriter::ZipWriter(std::ostream& os) 
-  : ZipStream(os)
+  : ZipStream(os), FileStream(nullptr), Level(Z_DEFAULT_COMPRESSION)
 {
 #ifdef _MSC_VER
     ZipStream.imbue(std::locale::empty());
@@ -264,7 +271,166 @@ ZipWriter::ZipWriter(std::ostream& os)
     ZipStream.setf(ios::fixed,ios::floatfield);
 }
 
+namespace {
+
+/// The memory the buffers of the files compressed in parallel may hold
+const std::size_t maxPendingBytes = 256 * 1024 * 1024;
+
+/// A file of the archive whose data is compressed in a worker thread
+struct DeflatedFile
+{
+    std::string FileName;
+    std::string Data;
+    std::vector<char> Compressed;
+    uLong Crc = 0;
+    bool Ok = false;
+    QSemaphore Done;
+};
+
+class DeflateRunnable : public QRunnable
+{
+public:
+    DeflateRunnable(const std::shared_ptr<DeflatedFile>& file, int level)
+        : file(file), level(level)
+    {
+    }
+
+    void run()
+    {
+        file->Ok = deflateData();
+        file->Done.release();
+    }
+
+private:
+    // Compresses the data the same way as zipios::DeflateOutputStreambuf,
+    // i.e. as raw deflate stream without zlib header
+    bool deflateData()
+    {
+        const std::string& data = file->Data;
+        // the sizes are stored as 32-bit values in the zip headers
+        if (data.size() >= std::numeric_limits<uInt>::max())
+            return false;
+
+        z_stream zs;
+        zs.zalloc = Z_NULL;
+        zs.zfree  = Z_NULL;
+        zs.opaque = Z_NULL;
+        if (deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            return false;
+
+        const Bytef* input = reinterpret_cast<const Bytef*>(data.c_str());
+        uInt size = static_cast<uInt>(data.size());
+        file->Crc = crc32(crc32(0, Z_NULL, 0), input, size);
+
+        file->Compressed.resize(deflateBound(&zs, size));
+        zs.next_in = const_cast<Bytef*>(input);
+        zs.avail_in = size;
+        zs.next_out = reinterpret_cast<Bytef*>(&file->Compressed[0]);
+        zs.avail_out = static_cast<uInt>(file->Compressed.size());
+
+        int err = deflate(&zs, Z_FINISH);
+        file->Compressed.resize(zs.total_out);
+        deflateEnd(&zs);
+        return err == Z_STREAM_END && zs.total_out < std::numeric_limits<uInt>::max();
+    }
+
+private:
+    std::shared_ptr<DeflatedFile> file;
+    int level;
+};
+
+}
+
+std::ostream &ZipWriter::Stream(void)
+{
+    if (FileStream)
+        return *FileStream;
+    return ZipStream;
+}
+
+void ZipWriter::setLevel(int level)
+{
+    Level = level;
+    ZipStream.setLevel(level);
+}
+
 void ZipWriter::writeFiles(void)
+{
+    int numThreads = QThread::idealThreadCount();
+    if (numThreads < 2) {
+        writeFilesSequential();
+        return;
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(numThreads);
+    std::deque<std::shared_ptr<DeflatedFile> > pending;
+    std::size_t pendingBytes = 0;
+
+    // the uncompressed data plus the compressed data of at most the same size
+    auto bufferSize = [](const DeflatedFile& file) {
+        return 2 * file.Data.size();
+    };
+
+    // Writes the oldest pending file once its compression has finished
+    auto writePending = [this, &pending, &pendingBytes, &bufferSize]() {
+        std::shared_ptr<DeflatedFile> file = pending.front();
+        pending.pop_front();
+        file->Done.acquire();
+        pendingBytes -= bufferSize(*file);
+        if (file->Ok) {
+            ZipStream.putDeflatedEntry(file->FileName, &file->Compressed[0],
+                static_cast<zipios::uint32>(file->Compressed.size()),
+                static_cast<zipios::uint32>(file->Crc),
+                static_cast<zipios::uint32>(file->Data.size()));
+        }
+        else {
+            ZipStream.putNextEntry(file->FileName);
+            ZipStream.write(file->Data.c_str(), file->Data.size());
+        }
+    };
+
+    // use a while loop because it is possible that while
+    // processing the files new ones can be added
+    size_t index = 0;
+    while (index < FileList.size()) {
+        FileEntry entry = FileList.begin()[index];
+        std::shared_ptr<DeflatedFile> file = std::make_shared<DeflatedFile>();
+        file->FileName = entry.FileName;
+
+        // The objects are not thread-safe so that only the compression runs in parallel
+        std::ostringstream str;
+        str.copyfmt(ZipStream);
+        FileStream = &str;
+        try {
+            entry.Object->SaveDocFile(*this);
+        }
+        catch (...) {
+            FileStream = nullptr;
+            throw;
+        }
+        FileStream = nullptr;
+        file->Data = str.str();
+        // don't hold the data twice while waiting for pending files
+        str.str(std::string());
+
+        pool.start(new DeflateRunnable(file, Level));
+        pending.push_back(file);
+        pendingBytes += bufferSize(*file);
+
+        // Limit the memory held by the buffers. A file above the limit on its own
+        // is written as soon as it's compressed so that only its buffers are held.
+        while (!pending.empty() && (pending.size() > static_cast<size_t>(numThreads) ||
+                                    pendingBytes > maxPendingBytes))
+            writePending();
+        index++;
+    }
+
+    while (!pending.empty())
+        writePending();
+}
+
+void ZipWriter::writeFilesSequential()
 {
     // use a while loop because it is possible that while
     // processing the files new ones can be added
@@ -26,8 +26,8 @@
 
 #include <set>
 #include <string>
-#include <sstream>
-#include <vector>
+#include <sstream>
+#include <vector>
 #include <cassert>
 
 #ifdef _MSC_VER
@@ -150,16 +150,27 @@ public:
     ZipWriter(std::ostream&);
     virtual ~ZipWriter();
 
+    /** Writes the files added with addFile().
+     * The objects save their data one after another into memory buffers that are
+     * compressed by a pool of worker threads. The entries are written to the
+     * archive in the order the files were added.
+     */
     virtual void writeFiles(void);
 
-    virtual std::ostream &Stream(void){return ZipStream;}
+    virtual std::ostream &Stream(void);
 
     void setComment(const char* str){ZipStream.setComment(str);}
-    void setLevel(int level){ZipStream.setLevel( level );}
+    void setLevel(int level);
     void putNextEntry(const char* str){ZipStream.putNextEntry(str);}
 
+private:
+    void writeFilesSequential();
+
 private:
     zipios::ZipOutputStream ZipStream;
+    /// buffer of the file being saved by writeFiles(), null otherwise
+    std::ostringstream* FileStream;
+    int Level;
 };
 
 /** The StringWriter class 
@@ -195,7 +206,7 @@ public:
     virtual void writeFiles(void);
 
     virtual std::ostream &Stream(void){return FileStream;}
-    void close() {FileStream.close();}
+    void close() {FileStream.close();}
     /*!
      This method can be re-implemented in sub-classes to avoid
      to write out certain objects. The default implementation
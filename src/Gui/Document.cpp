@@ -1426,6 +1426,8 @@ void Document::slotStartRestoreDocument(const App::Document& doc)
         return;
     // disable this signal while loading a document
     d->connectActObjectBlocker.block();
+    // the view providers need all data to display the document
+    d->_pcDocument->setStatus(App::Document::LazyLoading, false);
 }
 
 void Document::slotFinishRestoreObject(const App::DocumentObject &obj) {
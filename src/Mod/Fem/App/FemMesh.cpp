@@ -24,6 +24,8 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
+# include <cmath>
 # include <cstdlib>
 # include <memory>
 # include <Python.h>
@@ -38,6 +40,18 @@
 # include <TopoDS_Solid.hxx>
 # include <TopoDS_Shape.hxx>
 # include <ShapeAnalysis_ShapeTolerance.hxx>
+# include <BRepClass3d_SolidClassifier.hxx>
+# include <BRepTools.hxx>
+# include <BRepTopAdaptor_FClass2d.hxx>
+# include <GeomAPI_ProjectPointOnCurve.hxx>
+# include <GeomAPI_ProjectPointOnSurf.hxx>
+# include <gp_Pnt2d.hxx>
+# include <Precision.hxx>
+# include <Standard_Failure.hxx>
+# include <TopExp.hxx>
+# include <TopoDS.hxx>
+# include <TopoDS_Edge.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
 
 # include <boost/assign/list_of.hpp>
 # include <boost/tokenizer.hpp> //to simplify parsing input files we use the boost lib
@@ -65,6 +79,8 @@
 
 #endif
 
+#include <QtConcurrentMap>
+
 #include <Base/Writer.h>
 #include <Base/Reader.h>
 #include <Base/Stream.h>
@@ -139,6 +155,7 @@ FemMesh &FemMesh::operator=(const FemMesh& mesh)
 void FemMesh::copyMeshData(const FemMesh& mesh)
 {
     _Mtrx = mesh._Mtrx;
+    nodeIndex.reset();
 
     // See file SMESH_I/SMESH_Gen_i.cxx in the git repo of smesh at https://git.salome-platform.org
 #if 1
@@ -554,6 +571,7 @@ void FemMesh::setStandardHypotheses()
 void FemMesh::compute()
 {
     getGenerator()->Compute(*myMesh, myMesh->GetShapeToMesh());
+    nodeIndex.reset();
 }
 
 std::set<long> FemMesh::getSurfaceNodes(long /*ElemId*/, short /*FaceId*/, float /*Angle*/) const
@@ -748,120 +766,368 @@ std::map<int, int> FemMesh::getccxVolumesByFace(const TopoDS_Face &face) const
     return result;
 }
 
-std::set<int> FemMesh::getNodesBySolid(const TopoDS_Solid &solid) const
+/* A uniform grid over the nodes of the mesh, in the space given by the
+ * placement of the mesh. The nodes are sorted by grid cell, so that the nodes
+ * of a cell are stored next to each other.
+ */
+class FemMesh::NodeIndex
 {
-    std::set<int> result;
+public:
+    NodeIndex(const SMESHDS_Mesh *data, const Base::Matrix4D &matrix);
 
-    Bnd_Box box;
-    BRepBndLib::Add(solid, box);
+    /// true if the index was built for this node count and transformation
+    bool isValid(int count, const Base::Matrix4D &matrix) const
+    {
+        return nodeCount == count && transform == matrix;
+    }
+    /// appends the indices of the nodes inside the box
+    void findNodes(const Bnd_Box &box, std::vector<std::size_t> &indices) const;
 
-    // limit where the mesh node belongs to the solid
-    TopAbs_ShapeEnum shapetype = TopAbs_SHAPE;
-    ShapeAnalysis_ShapeTolerance analysis;
-    double limit = analysis.Tolerance(solid, 1, shapetype);
-    Base::Console().Log("The limit if a node is in or out: %.12lf in scientific: %.4e \n", limit, limit);
+    std::vector<Base::Vector3d> points;
+    std::vector<int> ids;
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
+private:
+    int cellIndex(int axis, double value) const
+    {
+        double i = (value - origin[axis]) / cellSize;
+        if (!(i > 0.0))
+            return 0;
+        return i < cells[axis] - 1 ? static_cast<int>(i) : cells[axis] - 1;
+    }
+
+    int nodeCount;
+    Base::Matrix4D transform;
+    double origin[3];
+    double cellSize;
+    int cells[3];
+    std::vector<std::size_t> cellStart;
+};
+
+FemMesh::NodeIndex::NodeIndex(const SMESHDS_Mesh *data, const Base::Matrix4D &matrix)
+    : nodeCount(data->NbNodes())
+    , transform(matrix)
+    , cellSize(1.0)
+{
+    std::vector<Base::Vector3d> vertexes;
+    std::vector<int> nodeIds;
+    vertexes.reserve(nodeCount);
+    nodeIds.reserve(nodeCount);
 
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
+    Base::BoundBox3d bounds;
+    SMDS_NodeIteratorPtr aNodeIter = data->nodesIterator();
     while (aNodeIter->more()) {
         const SMDS_MeshNode* aNode = aNodeIter->next();
         Base::Vector3d vec(aNode->X(),aNode->Y(),aNode->Z());
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x,vec.y,vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x,vec.y,vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(solid,s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1)
+        vec = matrix * vec;
+        bounds.Add(vec);
+        vertexes.push_back(vec);
+        nodeIds.push_back(aNode->GetID());
+    }
+
+    cells[0] = cells[1] = cells[2] = 1;
+    origin[0] = origin[1] = origin[2] = 0.0;
+    if (!vertexes.empty()) {
+        origin[0] = bounds.MinX;
+        origin[1] = bounds.MinY;
+        origin[2] = bounds.MinZ;
+
+        // about four nodes per cell, only counting the dimensions the mesh extends to
+        double length[3] = {bounds.LengthX(), bounds.LengthY(), bounds.LengthZ()};
+        double maxLength = std::max(length[0], std::max(length[1], length[2]));
+        double measure = 1.0;
+        int dimension = 0;
+        for (double l : length) {
+            if (l > maxLength * 1e-6) {
+                measure *= l;
+                ++dimension;
+            }
+        }
+        if (dimension > 0) {
+            double cellCount = std::max(1.0, vertexes.size() / 4.0);
+            cellSize = std::pow(measure / cellCount, 1.0 / dimension);
+            for (int i = 0; i < 3; i++)
+                cells[i] = std::max(1, std::min(1024, static_cast<int>(length[i] / cellSize) + 1));
+        }
+    }
+
+    // counting sort of the nodes by cell
+    std::vector<std::size_t> nodeCells(vertexes.size());
+    cellStart.assign(static_cast<std::size_t>(cells[0]) * cells[1] * cells[2] + 1, 0);
+    for (std::size_t i = 0; i < vertexes.size(); i++) {
+        const Base::Vector3d &v = vertexes[i];
+        nodeCells[i] = (static_cast<std::size_t>(cellIndex(2, v.z)) * cells[1]
+                     + cellIndex(1, v.y)) * cells[0] + cellIndex(0, v.x);
+        cellStart[nodeCells[i] + 1]++;
+    }
+    for (std::size_t i = 1; i < cellStart.size(); i++)
+        cellStart[i] += cellStart[i - 1];
+
+    std::vector<std::size_t> next(cellStart.begin(), cellStart.end() - 1);
+    points.resize(vertexes.size());
+    ids.resize(vertexes.size());
+    for (std::size_t i = 0; i < vertexes.size(); i++) {
+        std::size_t pos = next[nodeCells[i]]++;
+        points[pos] = vertexes[i];
+        ids[pos] = nodeIds[i];
+    }
+}
+
+void FemMesh::NodeIndex::findNodes(const Bnd_Box &box, std::vector<std::size_t> &indices) const
+{
+    if (box.IsVoid() || points.empty())
+        return;
+
+    Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+    box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+    int x1 = cellIndex(0, xMin), x2 = cellIndex(0, xMax);
+    int y1 = cellIndex(1, yMin), y2 = cellIndex(1, yMax);
+    int z1 = cellIndex(2, zMin), z2 = cellIndex(2, zMax);
+
+    for (int z = z1; z <= z2; z++) {
+        for (int y = y1; y <= y2; y++) {
+            std::size_t cell = (static_cast<std::size_t>(z) * cells[1] + y) * cells[0];
+            for (std::size_t i = cellStart[cell + x1]; i < cellStart[cell + x2 + 1]; i++) {
+                const Base::Vector3d &v = points[i];
+                if (!box.IsOut(gp_Pnt(v.x,v.y,v.z)))
+                    indices.push_back(i);
+            }
+        }
+    }
+}
+
+const FemMesh::NodeIndex& FemMesh::getNodeIndex() const
+{
+    const SMESHDS_Mesh* data = myMesh->GetMeshDS();
+    if (!nodeIndex || !nodeIndex->isValid(data->NbNodes(), _Mtrx))
+        nodeIndex = std::make_shared<NodeIndex>(data, _Mtrx);
+    return *nodeIndex;
+}
+
+namespace {
+
+// the check done for every node before there was the NodeProjector
+bool isNodeWithin(const TopoDS_Shape &shape, const gp_Pnt &pnt, double limit)
+{
+    BRepBuilderAPI_MakeVertex aBuilder(pnt);
+    TopoDS_Shape s = aBuilder.Vertex();
+    BRepExtrema_DistShapeShape measure(shape,s);
+    measure.Perform();
+    if (!measure.IsDone() || measure.NbSolution() < 1)
+        return false;
+    return measure.Value() < limit;
+}
+
+/* Checks if a point is closer to a shape than the limit, with the same result
+ * as measuring the distance with BRepExtrema_DistShapeShape. The point is
+ * projected onto the faces, edges and vertexes of the shape like
+ * BRepExtrema does, but the projection and classification tools are only set
+ * up once for all the points.
+ */
+class NodeProjector
+{
+public:
+    NodeProjector(const TopoDS_Shape &shape, double limit)
+        : limit(limit)
+        , complete(true)
+    {
+        if (shape.ShapeType() == TopAbs_SOLID)
+            solid.reset(new BRepClass3d_SolidClassifier(shape));
+
+        TopTools_IndexedMapOfShape map;
+        TopExp::MapShapes(shape, TopAbs_FACE, map);
+        for (int i = 1; i <= map.Extent(); i++) {
+            const TopoDS_Face &face = TopoDS::Face(map(i));
+            Handle(Geom_Surface) surface = BRep_Tool::Surface(face);
+            if (surface.IsNull()) {
+                complete = false;
                 continue;
+            }
+            Standard_Real u1, u2, v1, v2;
+            BRepTools::UVBounds(face, u1, u2, v1, v2);
+            faces.emplace_back();
+            faces.back().projector.reset(new GeomAPI_ProjectPointOnSurf());
+            faces.back().projector->Init(surface, u1, u2, v1, v2);
+            faces.back().classifier.reset(new BRepTopAdaptor_FClass2d(face, BRep_Tool::Tolerance(face)));
+        }
+
+        map.Clear();
+        TopExp::MapShapes(shape, TopAbs_EDGE, map);
+        for (int i = 1; i <= map.Extent(); i++) {
+            const TopoDS_Edge &edge = TopoDS::Edge(map(i));
+            if (BRep_Tool::Degenerated(edge))
+                continue;
+            Standard_Real first, last;
+            Handle(Geom_Curve) curve = BRep_Tool::Curve(edge, first, last);
+            if (curve.IsNull()) {
+                complete = false;
+                continue;
+            }
+            edges.emplace_back(new GeomAPI_ProjectPointOnCurve());
+            edges.back()->Init(curve, first, last);
+        }
 
-            if (measure.Value() < limit)
-                result.insert(aNode->GetID());
+        map.Clear();
+        TopExp::MapShapes(shape, TopAbs_VERTEX, map);
+        for (int i = 1; i <= map.Extent(); i++)
+            vertexes.push_back(BRep_Tool::Pnt(TopoDS::Vertex(map(i))));
+    }
+
+    /// false if the shape has parts without 3D geometry that can't be projected on
+    bool isComplete() const
+    {
+        return complete;
+    }
+
+    bool isWithin(const gp_Pnt &pnt)
+    {
+        if (solid) {
+            solid->Perform(pnt, Precision::Confusion());
+            if (solid->State() == TopAbs_IN || solid->State() == TopAbs_ON)
+                return true;
+        }
+        for (const gp_Pnt &v : vertexes) {
+            if (v.Distance(pnt) < limit)
+                return true;
+        }
+        for (auto &edge : edges) {
+            edge->Perform(pnt);
+            for (int i = 1; i <= edge->NbPoints(); i++) {
+                if (edge->Distance(i) < limit)
+                    return true;
+            }
+        }
+        for (auto &face : faces) {
+            face.projector->Perform(pnt);
+            for (int i = 1; i <= face.projector->NbPoints(); i++) {
+                if (face.projector->Distance(i) >= limit)
+                    continue;
+                Standard_Real u, v;
+                face.projector->Parameters(i, u, v);
+                TopAbs_State state = face.classifier->Perform(gp_Pnt2d(u, v));
+                if (state == TopAbs_IN || state == TopAbs_ON)
+                    return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    struct FaceProjector {
+        std::unique_ptr<GeomAPI_ProjectPointOnSurf> projector;
+        std::unique_ptr<BRepTopAdaptor_FClass2d> classifier;
+    };
+
+    double limit;
+    bool complete;
+    std::unique_ptr<BRepClass3d_SolidClassifier> solid;
+    std::vector<FaceProjector> faces;
+    std::vector<std::unique_ptr<GeomAPI_ProjectPointOnCurve> > edges;
+    std::vector<gp_Pnt> vertexes;
+};
+
+/* Returns the IDs of the candidate nodes closer to the shape than the limit.
+ * The candidates are checked in parallel in chunks, every chunk with its own
+ * NodeProjector because the OCC tools can't be shared between threads.
+ */
+std::set<int> getNodesWithin(const TopoDS_Shape &shape, double limit,
+                             const std::vector<Base::Vector3d> &points, const std::vector<int> &ids,
+                             const std::vector<std::size_t> &candidates)
+{
+    const std::size_t chunkSize = 1024;
+    std::vector<std::pair<std::size_t, std::size_t> > chunks;
+    for (std::size_t i = 0; i < candidates.size(); i += chunkSize)
+        chunks.emplace_back(i, std::min(candidates.size(), i + chunkSize));
+
+    std::vector<char> within(candidates.size(), 0);
+    std::vector<std::string> errors(chunks.size());
+    QtConcurrent::blockingMap(chunks, [&](const std::pair<std::size_t, std::size_t> &chunk) {
+        try {
+            NodeProjector projector(shape, limit);
+            for (std::size_t i = chunk.first; i < chunk.second; i++) {
+                const Base::Vector3d &v = points[candidates[i]];
+                gp_Pnt pnt(v.x,v.y,v.z);
+                if (!projector.isComplete()) {
+                    within[i] = isNodeWithin(shape, pnt, limit);
+                    continue;
+                }
+                // a projection that fails is left to BRepExtrema, like before
+                try {
+                    within[i] = projector.isWithin(pnt);
+                }
+                catch (Standard_Failure&) {
+                    within[i] = isNodeWithin(shape, pnt, limit);
+                }
+            }
+        }
+        catch (Standard_Failure& e) {
+            errors[chunk.first / chunkSize] = e.GetMessageString() ? e.GetMessageString() : "unknown error";
         }
+    });
+
+    for (const std::string &error : errors) {
+        if (!error.empty())
+            throw Base::CADKernelError(error);
+    }
+
+    std::set<int> result;
+    for (std::size_t i = 0; i < candidates.size(); i++) {
+        if (within[i])
+            result.insert(ids[candidates[i]]);
     }
     return result;
 }
 
-std::set<int> FemMesh::getNodesByFace(const TopoDS_Face &face) const
+}
+
+std::set<int> FemMesh::getNodesBySolid(const TopoDS_Solid &solid) const
 {
-    std::set<int> result;
+    Bnd_Box box;
+    BRepBndLib::Add(solid, box);
 
+    // limit where the mesh node belongs to the solid
+    TopAbs_ShapeEnum shapetype = TopAbs_SHAPE;
+    ShapeAnalysis_ShapeTolerance analysis;
+    double limit = analysis.Tolerance(solid, 1, shapetype);
+    Base::Console().Log("The limit if a node is in or out: %.12lf in scientific: %.4e \n", limit, limit);
+
+    // the index holds the nodes in absolute space, like the BoundBox
+    const NodeIndex &index = getNodeIndex();
+    std::vector<std::size_t> candidates;
+    index.findNodes(box, candidates);
+
+    return getNodesWithin(solid, limit, index.points, index.ids, candidates);
+}
+
+std::set<int> FemMesh::getNodesByFace(const TopoDS_Face &face) const
+{
     Bnd_Box box;
     BRepBndLib::Add(face, box, Standard_False);  // https://forum.freecadweb.org/viewtopic.php?f=18&t=21571&start=70#p221591
     // limit where the mesh node belongs to the face:
     double limit = BRep_Tool::Tolerance(face);
     box.Enlarge(limit);
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
-
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        Base::Vector3d vec(aNode->X(),aNode->Y(),aNode->Z());
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x,vec.y,vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x,vec.y,vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(face,s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1)
-                continue;
-
-            if (measure.Value() < limit)
-                result.insert(aNode->GetID());
-        }
-    }
+    // the index holds the nodes in absolute space, like the BoundBox
+    const NodeIndex &index = getNodeIndex();
+    std::vector<std::size_t> candidates;
+    index.findNodes(box, candidates);
 
-    return result;
+    return getNodesWithin(face, limit, index.points, index.ids, candidates);
 }
 
 std::set<int> FemMesh::getNodesByEdge(const TopoDS_Edge &edge) const
 {
-    std::set<int> result;
-
     Bnd_Box box;
     BRepBndLib::Add(edge, box);
     // limit where the mesh node belongs to the edge:
     double limit = BRep_Tool::Tolerance(edge);
     box.Enlarge(limit);
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
-
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        Base::Vector3d vec(aNode->X(),aNode->Y(),aNode->Z());
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x,vec.y,vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x,vec.y,vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(edge,s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1)
-                continue;
-
-            if (measure.Value() < limit)
-                result.insert(aNode->GetID());
-        }
-    }
+    // the index holds the nodes in absolute space, like the BoundBox
+    const NodeIndex &index = getNodeIndex();
+    std::vector<std::size_t> candidates;
+    index.findNodes(box, candidates);
 
-    return result;
+    return getNodesWithin(edge, limit, index.points, index.ids, candidates);
 }
 
 std::set<int> FemMesh::getNodesByVertex(const TopoDS_Vertex &vertex) const
@@ -869,21 +1135,21 @@ std::set<int> FemMesh::getNodesByVertex(const TopoDS_Vertex &vertex) const
     std::set<int> result;
 
     double limit = BRep_Tool::Tolerance(vertex);
-    limit *= limit; // use square to improve speed
     gp_Pnt pnt = BRep_Tool::Pnt(vertex);
     Base::Vector3d node(pnt.X(), pnt.Y(), pnt.Z());
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
+    Bnd_Box box;
+    box.Add(pnt);
+    box.Enlarge(limit);
 
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        Base::Vector3d vec(aNode->X(),aNode->Y(),aNode->Z());
-        vec = Mtrx * vec;
+    const NodeIndex &index = getNodeIndex();
+    std::vector<std::size_t> candidates;
+    index.findNodes(box, candidates);
 
-        if (Base::DistanceP2(node, vec) <= limit) {
-            result.insert(aNode->GetID());
+    limit *= limit; // use square to improve speed
+    for (std::size_t i : candidates) {
+        if (Base::DistanceP2(node, index.points[i]) <= limit) {
+            result.insert(index.ids[i]);
         }
     }
 
@@ -1248,6 +1514,7 @@ void FemMesh::read(const char *FileName)
 {
     Base::FileInfo File(FileName);
     _Mtrx = Base::Matrix4D();
+    nodeIndex.reset();
 
     // checking on the file
     if (!File.isReadable())
@@ -1776,7 +2043,7 @@ void FemMesh::Save (Base::Writer &writer) const
     if (!writer.isForceXML()) {
         //See SaveDocFile(), RestoreDocFile()
         writer.Stream() << writer.ind() << "<FemMesh file=\"" ;
-        writer.Stream() << writer.addFile("FemMesh.unv", this) << "\"";
+        writer.Stream() << writer.addFile("FemMesh.bin", this) << "\"";
         writer.Stream() << " a11=\"" <<  _Mtrx[0][0] << "\" a12=\"" <<  _Mtrx[0][1] << "\" a13=\"" <<  _Mtrx[0][2] << "\" a14=\"" <<  _Mtrx[0][3] << "\"";
         writer.Stream() << " a21=\"" <<  _Mtrx[1][0] << "\" a22=\"" <<  _Mtrx[1][1] << "\" a23=\"" <<  _Mtrx[1][2] << "\" a24=\"" <<  _Mtrx[1][3] << "\"";
         writer.Stream() << " a31=\"" <<  _Mtrx[2][0] << "\" a32=\"" <<  _Mtrx[2][1] << "\" a33=\"" <<  _Mtrx[2][2] << "\" a34=\"" <<  _Mtrx[2][3] << "\"";
@@ -1827,24 +2094,18 @@ void FemMesh::Restore(Base::XMLReader &reader)
 
 void FemMesh::SaveDocFile (Base::Writer &writer) const
 {
-    // create a temporary file and copy the content to the zip stream
-    Base::FileInfo fi(App::Application::getTempFileName().c_str());
-
-    myMesh->ExportUNV(fi.filePath().c_str());
-
-    Base::ifstream file(fi, std::ios::in | std::ios::binary);
-    if (file){
-        std::streambuf* buf = file.rdbuf();
-        writer.Stream() << buf;
-    }
-
-    file.close();
-    // remove temp file
-    fi.deleteFile();
+    writeBinary(writer.Stream());
 }
 
 void FemMesh::RestoreDocFile(Base::Reader &reader)
 {
+    if (Base::FileInfo(reader.getFileName()).hasExtension("bin")) {
+        readBinary(reader);
+        nodeIndex.reset();
+        return;
+    }
+
+    // projects of older versions store the mesh in the UNV format
     // create a temporary file and copy the content from the zip stream
     Base::FileInfo fi(App::Application::getTempFileName().c_str());
 
@@ -1856,11 +2117,211 @@ void FemMesh::RestoreDocFile(Base::Reader &reader)
 
     // read the shape from the temp file
     myMesh->UNVToMesh(fi.filePath().c_str());
+    nodeIndex.reset();
 
     // delete the temp file
     fi.deleteFile();
 }
 
+namespace {
+
+// the element types in the order they are stored in the binary format
+const SMDSAbs_ElementType binaryElementTypes[] = {
+    SMDSAbs_0DElement, SMDSAbs_Edge, SMDSAbs_Face, SMDSAbs_Volume, SMDSAbs_Ball
+};
+
+void writeString(Base::OutputStream &str, std::ostream &out, const std::string &s)
+{
+    str << static_cast<uint32_t>(s.size());
+    out.write(s.c_str(), s.size());
+}
+
+std::string readString(Base::InputStream &str, std::istream &in)
+{
+    uint32_t size = 0;
+    str >> size;
+    std::string s(size, '\0');
+    if (size > 0)
+        in.read(&s[0], size);
+    return s;
+}
+
+}
+
+/* The binary format holds the same data as the UNV file, i.e. the nodes, the
+ * elements and the groups, with their IDs:
+ *   uint32 magic number, uint32 version
+ *   uint32 number of nodes, then for every node: int32 ID, double x, y, z
+ *   for every type of binaryElementTypes:
+ *     uint32 type, uint32 number of elements, then for every element:
+ *     int32 ID, bool poly, uint32 number of nodes, int32 node IDs,
+ *     for polyhedra: uint32 number of faces, int32 number of nodes per face,
+ *     for balls: double diameter
+ *   uint32 number of groups, then for every group:
+ *     uint32 length and the characters of the name, uint32 type,
+ *     uint32 number of members, int32 member IDs
+ */
+void FemMesh::writeBinary(std::ostream &out) const
+{
+    Base::OutputStream str(out);
+    SMESHDS_Mesh* meshDS = myMesh->GetMeshDS();
+
+    str << static_cast<uint32_t>(0xFE0DA7A0);
+    str << static_cast<uint32_t>(0x010000);
+
+    str << static_cast<uint32_t>(meshDS->NbNodes());
+    SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
+    while (aNodeIter->more()) {
+        const SMDS_MeshNode* aNode = aNodeIter->next();
+        str << static_cast<int32_t>(aNode->GetID()) << aNode->X() << aNode->Y() << aNode->Z();
+    }
+
+    std::vector<int> nodeIds;
+    for (SMDSAbs_ElementType type : binaryElementTypes) {
+        str << static_cast<uint32_t>(type);
+        str << static_cast<uint32_t>(meshDS->GetMeshInfo().NbElements(type));
+        SMDS_ElemIteratorPtr aElemIter = meshDS->elementsIterator(type);
+        while (aElemIter->more()) {
+            const SMDS_MeshElement* aElem = aElemIter->next();
+            // for polyhedra the nodes of every face, the same as copyMeshData() uses
+            nodeIds.clear();
+            SMDS_ElemIteratorPtr aNodeIter = aElem->nodesIterator();
+            while (aNodeIter->more())
+                nodeIds.push_back(aNodeIter->next()->GetID());
+
+            str << static_cast<int32_t>(aElem->GetID()) << aElem->IsPoly();
+            str << static_cast<uint32_t>(nodeIds.size());
+            for (int it : nodeIds)
+                str << static_cast<int32_t>(it);
+
+            if (aElem->GetEntityType() == SMDSEntity_Polyhedra) {
+                std::vector<int> quantities = static_cast<const SMDS_VtkVolume*>(aElem)->GetQuantities();
+                str << static_cast<uint32_t>(quantities.size());
+                for (int it : quantities)
+                    str << static_cast<int32_t>(it);
+            }
+            else if (type == SMDSAbs_Ball) {
+                str << static_cast<const SMDS_BallElement*>(aElem)->GetDiameter();
+            }
+        }
+    }
+
+    std::vector<SMESH_Group*> groups;
+    SMESH_Mesh::GroupIteratorPtr aGroupIter = myMesh->GetGroups();
+    while (aGroupIter->more())
+        groups.push_back(aGroupIter->next());
+
+    str << static_cast<uint32_t>(groups.size());
+    for (SMESH_Group* group : groups) {
+        const SMESHDS_GroupBase* groupDS = group->GetGroupDS();
+        writeString(str, out, group->GetName());
+        str << static_cast<uint32_t>(groupDS->GetType());
+        str << static_cast<uint32_t>(groupDS->Extent());
+        SMDS_ElemIteratorPtr aElemIter = groupDS->GetElements();
+        while (aElemIter->more())
+            str << static_cast<int32_t>(aElemIter->next()->GetID());
+    }
+}
+
+void FemMesh::readBinary(std::istream &in)
+{
+    Base::InputStream str(in);
+    SMESHDS_Mesh* meshDS = myMesh->GetMeshDS();
+    SMESH_MeshEditor editor(myMesh);
+
+    uint32_t magic = 0, version = 0;
+    str >> magic >> version;
+    if (magic != 0xFE0DA7A0 || version > 0x010000)
+        throw Base::BadFormatError("Unknown format of FEM mesh data");
+
+    uint32_t count = 0;
+    str >> count;
+    for (uint32_t i = 0; i < count && in; i++) {
+        int32_t id;
+        double x, y, z;
+        str >> id >> x >> y >> z;
+        meshDS->AddNodeWithID(x, y, z, id);
+    }
+
+    std::vector<const SMDS_MeshNode*> nodes;
+    std::vector<int> quantities;
+    for (std::size_t t = 0; t < sizeof(binaryElementTypes) / sizeof(binaryElementTypes[0]); t++) {
+        uint32_t type = 0;
+        str >> type >> count;
+        if (type != static_cast<uint32_t>(binaryElementTypes[t]))
+            throw Base::BadFormatError("Unknown element type in FEM mesh data");
+
+        for (uint32_t i = 0; i < count && in; i++) {
+            int32_t id;
+            bool poly;
+            uint32_t nbNodes;
+            str >> id >> poly >> nbNodes;
+            nodes.resize(nbNodes);
+            for (uint32_t j = 0; j < nbNodes; j++) {
+                int32_t nodeId;
+                str >> nodeId;
+                nodes[j] = meshDS->FindNode(nodeId);
+                if (!nodes[j])
+                    throw Base::BadFormatError("Element refers to a missing node in FEM mesh data");
+            }
+
+            if (type == SMDSAbs_Volume && poly) {
+                uint32_t nbFaces;
+                str >> nbFaces;
+                quantities.resize(nbFaces);
+                for (uint32_t j = 0; j < nbFaces; j++) {
+                    int32_t quantity;
+                    str >> quantity;
+                    quantities[j] = quantity;
+                }
+                meshDS->AddPolyhedralVolumeWithID(nodes, quantities, id);
+            }
+            else if (type == SMDSAbs_Ball) {
+                double diameter;
+                str >> diameter;
+                SMESH_MeshEditor::ElemFeatures elemFeat;
+                elemFeat.Init(diameter);
+                elemFeat.SetID(id);
+                editor.AddElement(nodes, elemFeat);
+            }
+            else {
+                SMESH_MeshEditor::ElemFeatures elemFeat(binaryElementTypes[t], poly);
+                elemFeat.SetID(id);
+                editor.AddElement(nodes, elemFeat);
+            }
+        }
+    }
+
+    str >> count;
+    for (uint32_t i = 0; i < count && in; i++) {
+        std::string name = readString(str, in);
+        uint32_t type = 0, size = 0;
+        str >> type >> size;
+
+        int aId;
+        SMESH_Group* group = myMesh->AddGroup(static_cast<SMDSAbs_ElementType>(type), name.c_str(), aId);
+        SMESHDS_Group* groupDS = dynamic_cast<SMESHDS_Group*>(group->GetGroupDS());
+        for (uint32_t j = 0; j < size; j++) {
+            int32_t id;
+            str >> id;
+            const SMDS_MeshElement* elem = (type == SMDSAbs_Node)
+                ? static_cast<const SMDS_MeshElement*>(meshDS->FindNode(id))
+                : meshDS->FindElement(id);
+            if (groupDS && elem)
+                groupDS->SMDSGroup().Add(elem);
+        }
+        if (groupDS) {
+            groupDS->SetStoreName(name.c_str());
+            groupDS->SetType(static_cast<SMDSAbs_ElementType>(type));
+        }
+    }
+
+    if (!in)
+        throw Base::BadFormatError("Unexpected end of FEM mesh data");
+
+    meshDS->Modified();
+}
+
 void FemMesh::transformGeometry(const Base::Matrix4D& rclTrf)
 {
     //We perform a translation and rotation of the current active Mesh object
@@ -1873,6 +2334,7 @@ void FemMesh::transformGeometry(const Base::Matrix4D& rclTrf)
         current_node = clMatrix * current_node;
         myMesh->GetMeshDS()->MoveNode(aNode,current_node.x,current_node.y,current_node.z);
     }
+    nodeIndex.reset();
 }
 
 void FemMesh::setTransform(const Base::Matrix4D& rclTrf)
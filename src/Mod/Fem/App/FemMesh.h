@@ -30,6 +30,7 @@
 
 #include <vector>
 #include <list>
+#include <memory>
 #include <boost/shared_ptr.hpp>
 #include <SMESH_Version.h>
 #include <SMDSAbs_ElementType.hxx>
@@ -171,11 +172,18 @@ private:
     void readNastran(const std::string &Filename);
     void readZ88(const std::string &Filename);
     void readAbaqus(const std::string &Filename);
+    void writeBinary(std::ostream &) const;
+    void readBinary(std::istream &);
+
+    class NodeIndex;
+    /// spatial index of the placed nodes, built on demand
+    const NodeIndex& getNodeIndex() const;
 
 private:
     /// positioning matrix
     Base::Matrix4D _Mtrx;
     SMESH_Mesh *myMesh;
+    mutable std::shared_ptr<NodeIndex> nodeIndex;
 
     std::list<SMESH_HypothesisPtr> hypoth;
     static SMESH_Gen *_mesh_gen;
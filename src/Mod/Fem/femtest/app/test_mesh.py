@@ -179,6 +179,47 @@ class TestMeshCommon(unittest.TestCase):
             "Nodes order of quadratic volume element is unexpected"
         )
 
+    # ********************************************************************************************
+    def test_document_save_load(
+        self
+    ):
+        from femexamples.meshes.mesh_canticcx_tetra10 import create_elements
+        from femexamples.meshes.mesh_canticcx_tetra10 import create_nodes
+
+        fm = Fem.FemMesh()
+        create_nodes(fm)
+        create_elements(fm)
+        node_group = fm.addGroup("MyNodeGroup", "Node")
+        fm.addGroupElements(node_group, [1, 2, 3, 4])
+        volume_group = fm.addGroup("MyVolumeGroup", "Volume")
+        fm.addGroupElements(volume_group, list(fm.Volumes[:3]))
+
+        mesh_obj = self.document.addObject("Fem::FemMeshObject", "Mesh")
+        mesh_obj.FemMesh = fm
+
+        # the mesh is stored in the binary format
+        file_path = join(
+            testtools.get_fem_test_tmp_dir("mesh_common_document_save"),
+            "mesh_save_load.FCStd"
+        )
+        self.document.saveAs(file_path)
+        FreeCAD.closeDocument(self.document.Name)
+        self.document = FreeCAD.open(file_path)
+        newmesh = self.document.Mesh.FemMesh
+
+        self.assertEqual(fm.Nodes, newmesh.Nodes)
+        self.assertEqual(fm.Volumes, newmesh.Volumes)
+        for vol in fm.Volumes:
+            self.assertEqual(fm.getElementNodes(vol), newmesh.getElementNodes(vol))
+        self.assertEqual(
+            [(newmesh.getGroupName(g), newmesh.getGroupElementType(g)) for g in newmesh.Groups],
+            [("MyNodeGroup", "Node"), ("MyVolumeGroup", "Volume")]
+        )
+        self.assertEqual(
+            [newmesh.getGroupElements(g) for g in newmesh.Groups],
+            [(1, 2, 3, 4), tuple(sorted(fm.Volumes[:3]))]
+        )
+
     # ********************************************************************************************
     def test_writeAbaqus_precision(
         self
@@ -220,6 +261,58 @@ class TestMeshCommon(unittest.TestCase):
             )
         )
 
+    # ********************************************************************************************
+    def test_nodes_by_shape(
+        self
+    ):
+        # the nodes are looked up in a spatial index and projected onto the shape,
+        # compare them with the distance measured for every node like it was done before
+        import Part
+        fm = Fem.FemMesh()
+        node_id = 1
+        # more nodes than checked by a single thread
+        for x in range(13):
+            for y in range(13):
+                for z in range(13):
+                    fm.addNode(x, y, z, node_id)
+                    node_id += 1
+
+        box = Part.makeBox(10, 10, 10, FreeCAD.Vector(1, 1, 1))
+        # radius 5 puts nodes like (9, 10) on the curved face
+        cylinder = Part.makeCylinder(5, 10, FreeCAD.Vector(6, 6, 1))
+
+        def expected_nodes(shape, limit):
+            # only to skip the far nodes, the nodes are half a grid step away from it
+            bound_box = shape.BoundBox
+            bound_box.enlarge(0.5)
+            nodes = []
+            for node, pnt in fm.Nodes.items():
+                if bound_box.isInside(pnt):
+                    if Part.Vertex(pnt).distToShape(shape)[0] < limit:
+                        nodes.append(node)
+            return sorted(nodes)
+
+        def check_nodes():
+            for solid in (box, cylinder):
+                self.assertEqual(
+                    fm.getNodesBySolid(solid),
+                    expected_nodes(solid, solid.getTolerance(1))
+                )
+            for face in box.Faces + cylinder.Faces:
+                self.assertEqual(fm.getNodesByFace(face), expected_nodes(face, face.Tolerance))
+            for edge in box.Edges + cylinder.Edges:
+                self.assertEqual(fm.getNodesByEdge(edge), expected_nodes(edge, edge.Tolerance))
+            for vertex in box.Vertexes:
+                nodes = [node for node, pnt in fm.Nodes.items()
+                         if pnt.distanceToPoint(vertex.Point) <= vertex.Tolerance]
+                self.assertEqual(fm.getNodesByVertex(vertex), nodes)
+                self.assertEqual(len(nodes), 1)
+
+        check_nodes()
+        # the index must follow the placement of the mesh
+        fm.Placement = FreeCAD.Placement(FreeCAD.Vector(1, 0, 0), FreeCAD.Rotation())
+        check_nodes()
+
 
 # ************************************************************************************************
 # ************************************************************************************************
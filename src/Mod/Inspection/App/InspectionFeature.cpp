@@ -22,6 +22,7 @@
 
 
 #include "PreCompiled.h"
+#include <algorithm>
 #include <numeric>
 #include <gp_Pnt.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
@@ -48,6 +49,7 @@
 #include <Mod/Mesh/App/Mesh.h>
 #include <Mod/Mesh/App/MeshFeature.h>
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
@@ -202,19 +204,17 @@ namespace Inspection {
                     for (ulY = ulY1; ulY <= ulY2; ulY++) {
                         for (ulZ = ulZ1; ulZ <= ulZ2; ulZ++) {
                             if (rclFacet.IntersectBoundingBox(GetBoundBox(ulX, ulY, ulZ)))
-                                _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
+                                AddElement(ulX, ulY, ulZ, ulFacetIndex);
                         }
                     }
                 }
             }
             else
-                _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
+                AddElement(ulX1, ulY1, ulZ1, ulFacetIndex);
         }
 
         void InitGrid (void)
         {
-            unsigned long i, j;
-
             Base::BoundBox3f clBBMesh = _pclMesh->GetBoundBox().Transformed(_transform);
 
             float fLengthX = clBBMesh.LengthX(); 
@@ -230,13 +230,7 @@ namespace Inspection {
             _fGridLenZ = (1.0f + fLengthZ) / float(_ulCtGridsZ);
             _fMinZ = clBBMesh.MinZ - 0.5f;
 
-            _aulGrid.clear();
-            _aulGrid.resize(_ulCtGridsX);
-            for (i = 0; i < _ulCtGridsX; i++) {
-                _aulGrid[i].resize(_ulCtGridsY);
-                for (j = 0; j < _ulCtGridsY; j++)
-                    _aulGrid[i][j].resize(_ulCtGridsZ);
-            }
+            ClearElements();
         }
 
         void RebuildGrid (void)
@@ -250,6 +244,7 @@ namespace Inspection {
             for (clFIter.Init(); clFIter.More(); clFIter.Next()) {
                 AddFacet(*clFIter, i++);
             }
+            FinishGrid();
         }
 
     private:
@@ -296,9 +291,7 @@ float InspectNominalMesh::getDistance(const Base::Vector3f& point) const
     std::vector<unsigned long> indices;
     //_pGrid->GetElements(point, indices);
     if (indices.empty()) {
-        std::set<unsigned long> inds;
-        _pGrid->MeshGrid::SearchNearestFromPoint(point, inds);
-        indices.insert(indices.begin(), inds.begin(), inds.end());
+        _pGrid->MeshGrid::SearchNearestFromPoint(point, indices);
     }
 
     float fMinDist=FLT_MAX;
@@ -323,6 +316,45 @@ float InspectNominalMesh::getDistance(const Base::Vector3f& point) const
 
 // ----------------------------------------------------------------
 
+InspectNominalMeshBVH::InspectNominalMeshBVH(const Mesh::MeshObject& rMesh, float offset)
+  : _mesh(rMesh.getKernel())
+{
+    // the hierarchy is built on the placed mesh so that distances are not affected by scaling
+    Base::Matrix4D tmp;
+    Base::Matrix4D trf = rMesh.getTransform();
+    if (trf != tmp)
+        _mesh.Transform(trf);
+
+    _pTree = new MeshCore::MeshFacetBVH(_mesh);
+    _box = _mesh.GetBoundBox();
+    _box.Enlarge(offset);
+}
+
+InspectNominalMeshBVH::~InspectNominalMeshBVH()
+{
+    delete this->_pTree;
+}
+
+float InspectNominalMeshBVH::getDistance(const Base::Vector3f& point) const
+{
+    if (!_box.IsInBox(point))
+        return FLT_MAX; // must be inside bbox
+
+    // like the grid the nearest facet is searched without a distance limit
+    Base::Vector3f res;
+    float fDist;
+    unsigned long index = _pTree->NearestFacetToPoint(point, res, fDist);
+    if (index == ULONG_MAX)
+        return FLT_MAX;
+
+    MeshCore::MeshGeomFacet geomFace = _mesh.GetFacet(index);
+    if (point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) <= 0)
+        fDist = -fDist;
+    return fDist;
+}
+
+// ----------------------------------------------------------------
+
 InspectNominalFastMesh::InspectNominalFastMesh(const Mesh::MeshObject& rMesh, float offset) : _mesh(rMesh.getKernel())
 {
     const MeshCore::MeshKernel& kernel = rMesh.getKernel();
@@ -366,11 +398,9 @@ float InspectNominalFastMesh::getDistance(const Base::Vector3f& point) const
     if (!_box.IsInBox(point))
         return FLT_MAX; // must be inside bbox
 
-    std::set<unsigned long> indices;
+    std::vector<unsigned long> indices;
 #if 0 // a point in a neighbour grid can be nearer
-    std::vector<unsigned long> elements;
-    _pGrid->GetElements(point, elements);
-    indices.insert(elements.begin(), elements.end());
+    _pGrid->GetElements(point, indices);
 #else
     unsigned long ulX, ulY, ulZ;
     _pGrid->Position(point, ulX, ulY, ulZ);
@@ -379,11 +409,13 @@ float InspectNominalFastMesh::getDistance(const Base::Vector3f& point) const
         _pGrid->GetHull(ulX, ulY, ulZ, ulLevel++, indices);
     if (indices.size() == 0 || ulLevel==1)
         _pGrid->GetHull(ulX, ulY, ulZ, ulLevel, indices);
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
 #endif
 
     float fMinDist=FLT_MAX;
     bool positive = true;
-    for (std::set<unsigned long>::iterator it = indices.begin(); it != indices.end(); ++it) {
+    for (std::vector<unsigned long>::iterator it = indices.begin(); it != indices.end(); ++it) {
         MeshCore::MeshGeomFacet geomFace = _mesh.GetFacet(*it);
         if (_bApply) {
             geomFace.Transform(_clTrf);
@@ -769,7 +801,10 @@ App::DocumentObjectExecReturn* Feature::execute(void)
         InspectNominalGeometry* nominal = 0;
         if ((*it)->getTypeId().isDerivedFrom(Mesh::Feature::getClassTypeId())) {
             Mesh::Feature* mesh = static_cast<Mesh::Feature*>(*it);
-            nominal = new InspectNominalMesh(mesh->Mesh.getValue(), this->SearchRadius.getValue());
+            if (Mesh::MeshObject::useBoundingVolumeHierarchy())
+                nominal = new InspectNominalMeshBVH(mesh->Mesh.getValue(), this->SearchRadius.getValue());
+            else
+                nominal = new InspectNominalMesh(mesh->Mesh.getValue(), this->SearchRadius.getValue());
         }
         else if ((*it)->getTypeId().isDerivedFrom(Points::Feature::getClassTypeId())) {
             Points::Feature* pts = static_cast<Points::Feature*>(*it);
@@ -37,6 +37,7 @@ class BRepExtrema_DistShapeShape;
 namespace MeshCore {
 class MeshKernel;
 class MeshGrid;
+class MeshFacetBVH;
 }
 
 namespace Mesh   { class MeshObject; }
@@ -118,6 +119,23 @@ private:
     Base::Matrix4D _clTrf;
 };
 
+/** Uses a bounding volume hierarchy instead of a grid to find the nearest facet,
+ * if selected by the user parameter BoundingVolumeHierarchy of the Mesh module.
+ * This performs better on meshes with a very non-uniform facet density.
+ */
+class InspectionExport InspectNominalMeshBVH : public InspectNominalGeometry
+{
+public:
+    InspectNominalMeshBVH(const Mesh::MeshObject& rMesh, float offset);
+    ~InspectNominalMeshBVH();
+    virtual float getDistance(const Base::Vector3f&) const;
+
+private:
+    MeshCore::MeshKernel _mesh;
+    MeshCore::MeshFacetBVH* _pTree;
+    Base::BoundBox3f _box;
+};
+
 class InspectionExport InspectNominalFastMesh : public InspectNominalGeometry
 {
 public:
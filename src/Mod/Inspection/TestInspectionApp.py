@@ -0,0 +1,75 @@
+#   (c) FreeCAD Developers 2021                                 LGPL        *
+#                                                                         *
+#   This file is part of the FreeCAD CAx development system.              *
+#                                                                         *
+#   This program is free software; you can redistribute it and/or modify  *
+#   it under the terms of the GNU Lesser General Public License (LGPL)    *
+#   as published by the Free Software Foundation; either version 2 of     *
+#   the License, or (at your option) any later version.                   *
+#   for detail see the LICENCE text file.                                 *
+#                                                                         *
+#   FreeCAD is distributed in the hope that it will be useful,            *
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+#   GNU Library General Public License for more details.                  *
+#                                                                         *
+#   You should have received a copy of the GNU Library General Public     *
+#   License along with FreeCAD; if not, write to the Free Software        *
+#   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+#   USA                                                                   *
+#**************************************************************************
+
+
+import FreeCAD, unittest, Mesh, Inspection
+
+#---------------------------------------------------------------------------
+# define the test cases to test the FreeCAD Inspection module
+#---------------------------------------------------------------------------
+
+
+class InspectionSearchStructureCases(unittest.TestCase):
+    """The distances must be the same with a grid and a bounding volume hierarchy"""
+    def setUp(self):
+        self.Doc = FreeCAD.newDocument("InspectionTest")
+        self.param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Mesh")
+        self.bvh = self.param.GetBool("BoundingVolumeHierarchy", False)
+        self.nominal = self.Doc.addObject("Mesh::Feature", "Nominal")
+        self.nominal.Mesh = Mesh.createSphere(10.0, 50)
+
+    def inspect(self, mesh):
+        actual = self.Doc.addObject("Mesh::Feature", "Actual")
+        actual.Mesh = mesh
+        feature = self.Doc.addObject("Inspection::Feature", "Inspection")
+        feature.Actual = actual
+        feature.Nominals = [self.nominal]
+        feature.SearchRadius = 2.0
+
+        self.param.SetBool("BoundingVolumeHierarchy", False)
+        self.Doc.recompute()
+        grid = feature.Distances
+        self.param.SetBool("BoundingVolumeHierarchy", True)
+        feature.touch()
+        self.Doc.recompute()
+        tree = feature.Distances
+
+        self.assertEqual(len(grid), mesh.CountPoints)
+        self.assertEqual(len(grid), len(tree))
+        return grid, tree
+
+    def testMeshNominal(self):
+        mesh = Mesh.createSphere(10.0, 20)
+        mesh.transform(FreeCAD.Matrix(1.05, 0, 0, 0.3, 0, 0.95, 0, 0, 0, 0, 1.1, 0))
+        grid, tree = self.inspect(mesh)
+        for d1, d2 in zip(grid, tree):
+            self.assertAlmostEqual(d1, d2, 4)
+
+    def testBeyondSearchRadius(self):
+        # points far inside the nominal keep their sign
+        grid, tree = self.inspect(Mesh.createSphere(5.0, 20))
+        for d1, d2 in zip(grid, tree):
+            self.assertTrue(d1 < -2.0)
+            self.assertEqual(d1, d2)
+
+    def tearDown(self):
+        self.param.SetBool("BoundingVolumeHierarchy", self.bvh)
+        FreeCAD.closeDocument("InspectionTest")
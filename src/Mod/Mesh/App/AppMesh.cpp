@@ -98,6 +98,7 @@ PyMOD_INIT_FUNC(Mesh)
     Mesh::FixIndices            ::init();
     Mesh::FillHoles             ::init();
     Mesh::RemoveComponents      ::init();
+    Mesh::FixAllDefects         ::init();
 
     Mesh::Sphere                ::init();
     Mesh::Ellipsoid             ::init();
@@ -32,6 +32,7 @@
 #include "Elements.h"
 #include "Iterator.h"
 #include "Grid.h"
+#include "BVH.h"
 #include "Triangulation.h"
 
 #include <Base/Console.h>
@@ -119,6 +120,12 @@ bool MeshAlgorithm::NearestFacetOnRay (const Base::Vector3f &rclPt, const Base::
     return false;
 }
 
+bool MeshAlgorithm::NearestFacetOnRay (const Base::Vector3f &rclPt, const Base::Vector3f &rclDir, const MeshFacetBVH &rclTree,
+                                       Base::Vector3f &rclRes, unsigned long &rulFacet) const
+{
+    return rclTree.NearestFacetOnRay(rclPt, rclDir, rclRes, rulFacet);
+}
+
 bool MeshAlgorithm::NearestFacetOnRay (const Base::Vector3f &rclPt, const Base::Vector3f &rclDir, float fMaxSearchArea,
                                        const MeshFacetGrid &rclGrid, Base::Vector3f &rclRes, unsigned long &rulFacet) const
 {
@@ -773,8 +780,10 @@ bool MeshAlgorithm::FillupHole(const std::vector<unsigned long>& boundary,
 
         // in case the reference facet has not an open edge print a log message 
         if (ref_side == USHRT_MAX || tri_side == USHRT_MAX) {
-            Base::Console().Log("MeshAlgorithm::FillupHole: Expected open edge for facet <%d, %d, %d>\n", 
-                rFace._aulPoints[0], rFace._aulPoints[1], rFace._aulPoints[2]);
+            Base::Console().Log("MeshAlgorithm::FillupHole: Expected open edge for facet <%lu, %lu, %lu>\n",
+                static_cast<unsigned long>(rFace._aulPoints[0]),
+                static_cast<unsigned long>(rFace._aulPoints[1]),
+                static_cast<unsigned long>(rFace._aulPoints[2]));
             rFaces.clear();
             rPoints.clear();
             cTria.Discard();
@@ -1686,7 +1695,7 @@ bool MeshAlgorithm::Distance (const Base::Vector3f &rclPt, unsigned long ulFacet
 {
   const MeshFacetArray &rclFAry = _rclMesh._aclFacetArray;
   const MeshPointArray &rclPAry = _rclMesh._aclPointArray;
-  const unsigned long *pulIdx = rclFAry[ulFacetIdx]._aulPoints;
+  const MeshIndex *pulIdx = rclFAry[ulFacetIdx]._aulPoints;
 
   BoundBox3f clBB;
   clBB.Add(rclPAry[*(pulIdx++)]);
@@ -0,0 +1,415 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <cfloat>
+# include <climits>
+# include <cmath>
+#endif
+
+#include "BVH.h"
+#include "Elements.h"
+#include "MeshKernel.h"
+
+using namespace MeshCore;
+
+namespace {
+// Number of bins used to evaluate the surface area heuristic
+const int BVH_BINS = 12;
+// Nodes with up to this number of facets are never split
+const std::uint32_t BVH_MIN_LEAF = 2;
+// Nodes with more facets than this are always split
+const std::uint32_t BVH_MAX_LEAF = 8;
+
+struct Bounds
+{
+    float fMin[3];
+    float fMax[3];
+
+    Bounds()
+    {
+        fMin[0] = fMin[1] = fMin[2] = FLT_MAX;
+        fMax[0] = fMax[1] = fMax[2] = -FLT_MAX;
+    }
+    void Add(const float* pMin, const float* pMax)
+    {
+        for (int i = 0; i < 3; i++) {
+            fMin[i] = std::min(fMin[i], pMin[i]);
+            fMax[i] = std::max(fMax[i], pMax[i]);
+        }
+    }
+    void Add(const Bounds& b)
+    {
+        Add(b.fMin, b.fMax);
+    }
+    float HalfArea() const
+    {
+        float dx = fMax[0] - fMin[0];
+        float dy = fMax[1] - fMin[1];
+        float dz = fMax[2] - fMin[2];
+        if (dx < 0.0f)
+            return 0.0f;
+        return dx * dy + dy * dz + dz * dx;
+    }
+};
+
+// Squared distance of a point to an axis-aligned box
+inline float DistanceP2(const float* pMin, const float* pMax, const Base::Vector3f& p)
+{
+    float d = 0.0f;
+    for (int i = 0; i < 3; i++) {
+        float v = std::max(std::max(pMin[i] - p[i], p[i] - pMax[i]), 0.0f);
+        d += v * v;
+    }
+    return d;
+}
+
+// Slab test of a ray with an axis-aligned box, written without branches on the axes
+// so that the compiler can vectorize it. Returns the entry parameter or FLT_MAX.
+inline float IntersectRay(const float* pMin, const float* pMax, const float* org,
+                          const float* inv, float fMaxT)
+{
+    float tmin = 0.0f, tmax = fMaxT;
+    for (int i = 0; i < 3; i++) {
+        float t0 = (pMin[i] - org[i]) * inv[i];
+        float t1 = (pMax[i] - org[i]) * inv[i];
+        tmin = std::max(tmin, std::min(t0, t1));
+        tmax = std::min(tmax, std::max(t0, t1));
+    }
+    return tmin <= tmax ? tmin : FLT_MAX;
+}
+}
+
+struct MeshFacetBVH::BuildFacet
+{
+    float fMin[3];
+    float fMax[3];
+    float fCenter[3];
+    std::uint32_t ulIndex;
+};
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& mesh)
+  : _rclMesh(mesh)
+{
+    Rebuild();
+}
+
+MeshFacetBVH::~MeshFacetBVH()
+{
+}
+
+bool MeshFacetBVH::IsEmpty() const
+{
+    return _aclNodes.empty();
+}
+
+unsigned long MeshFacetBVH::CountFacets() const
+{
+    return static_cast<unsigned long>(_aulFacets.size());
+}
+
+void MeshFacetBVH::Rebuild()
+{
+    _aclNodes.clear();
+    _aulFacets.clear();
+    _aclPoints.clear();
+
+    const MeshPointArray& points = _rclMesh.GetPoints();
+    const MeshFacetArray& faces = _rclMesh.GetFacets();
+    std::uint32_t ulCtFacets = static_cast<std::uint32_t>(faces.size());
+    if (ulCtFacets == 0)
+        return;
+
+    std::vector<BuildFacet> facets(ulCtFacets);
+    for (std::uint32_t i = 0; i < ulCtFacets; i++) {
+        BuildFacet& facet = facets[i];
+        const MeshFacet& face = faces[i];
+        const MeshPoint& p0 = points[face._aulPoints[0]];
+        const MeshPoint& p1 = points[face._aulPoints[1]];
+        const MeshPoint& p2 = points[face._aulPoints[2]];
+        for (int j = 0; j < 3; j++) {
+            facet.fMin[j] = std::min(std::min(p0[j], p1[j]), p2[j]);
+            facet.fMax[j] = std::max(std::max(p0[j], p1[j]), p2[j]);
+            facet.fCenter[j] = 0.5f * (facet.fMin[j] + facet.fMax[j]);
+        }
+        facet.ulIndex = i;
+    }
+
+    _aclNodes.reserve(2 * (ulCtFacets / BVH_MIN_LEAF) + 1);
+    BuildNode(facets, 0, ulCtFacets);
+
+    _aulFacets.resize(ulCtFacets);
+    _aclPoints.resize(3 * ulCtFacets);
+    for (std::uint32_t i = 0; i < ulCtFacets; i++) {
+        const MeshFacet& face = faces[facets[i].ulIndex];
+        _aulFacets[i] = facets[i].ulIndex;
+        _aclPoints[3 * i    ] = points[face._aulPoints[0]];
+        _aclPoints[3 * i + 1] = points[face._aulPoints[1]];
+        _aclPoints[3 * i + 2] = points[face._aulPoints[2]];
+    }
+}
+
+std::uint32_t MeshFacetBVH::BuildNode(std::vector<BuildFacet>& facets, std::uint32_t ulBegin, std::uint32_t ulEnd)
+{
+    std::uint32_t ulNode = static_cast<std::uint32_t>(_aclNodes.size());
+    _aclNodes.push_back(Node());
+
+    Bounds bounds, centers;
+    for (std::uint32_t i = ulBegin; i < ulEnd; i++) {
+        bounds.Add(facets[i].fMin, facets[i].fMax);
+        centers.Add(facets[i].fCenter, facets[i].fCenter);
+    }
+
+    for (int i = 0; i < 3; i++) {
+        _aclNodes[ulNode].fMin[i] = bounds.fMin[i];
+        _aclNodes[ulNode].fMax[i] = bounds.fMax[i];
+    }
+
+    std::uint32_t ulCount = ulEnd - ulBegin;
+    int axis = 0;
+    for (int i = 1; i < 3; i++) {
+        if (centers.fMax[i] - centers.fMin[i] > centers.fMax[axis] - centers.fMin[axis])
+            axis = i;
+    }
+
+    float fExtent = centers.fMax[axis] - centers.fMin[axis];
+    if (ulCount <= BVH_MIN_LEAF || fExtent <= 0.0f) {
+        // all centers coincide, no split can separate the facets
+        _aclNodes[ulNode].ulFirst = ulBegin;
+        _aclNodes[ulNode].ulCount = ulCount;
+        return ulNode;
+    }
+
+    // evaluate the surface area heuristic at the bin borders
+    Bounds binBounds[BVH_BINS];
+    std::uint32_t binCount[BVH_BINS] = {0};
+    float fScale = float(BVH_BINS) / fExtent;
+    for (std::uint32_t i = ulBegin; i < ulEnd; i++) {
+        int bin = std::min(BVH_BINS - 1, int((facets[i].fCenter[axis] - centers.fMin[axis]) * fScale));
+        binCount[bin]++;
+        binBounds[bin].Add(facets[i].fMin, facets[i].fMax);
+    }
+
+    float fRightArea[BVH_BINS];
+    std::uint32_t ulRightCount[BVH_BINS];
+    Bounds right;
+    std::uint32_t ulRight = 0;
+    for (int i = BVH_BINS - 1; i > 0; i--) {
+        right.Add(binBounds[i]);
+        ulRight += binCount[i];
+        fRightArea[i] = right.HalfArea();
+        ulRightCount[i] = ulRight;
+    }
+
+    int bestSplit = -1;
+    float fBestCost = FLT_MAX;
+    Bounds left;
+    std::uint32_t ulLeft = 0;
+    for (int i = 1; i < BVH_BINS; i++) {
+        left.Add(binBounds[i - 1]);
+        ulLeft += binCount[i - 1];
+        if (ulLeft == 0 || ulRightCount[i] == 0)
+            continue;
+        float fCost = left.HalfArea() * float(ulLeft) + fRightArea[i] * float(ulRightCount[i]);
+        if (fCost < fBestCost) {
+            fBestCost = fCost;
+            bestSplit = i;
+        }
+    }
+
+    // a leaf is cheaper than the split, the traversal step costs about as much as one facet test
+    float fLeafCost = bounds.HalfArea() * float(ulCount);
+    if (bestSplit < 0 || (ulCount <= BVH_MAX_LEAF && fLeafCost <= fBestCost + bounds.HalfArea())) {
+        _aclNodes[ulNode].ulFirst = ulBegin;
+        _aclNodes[ulNode].ulCount = ulCount;
+        return ulNode;
+    }
+
+    float fMin = centers.fMin[axis];
+    std::vector<BuildFacet>::iterator mid = std::partition(facets.begin() + ulBegin, facets.begin() + ulEnd,
+        [=](const BuildFacet& f) {
+            return std::min(BVH_BINS - 1, int((f.fCenter[axis] - fMin) * fScale)) < bestSplit;
+        });
+    std::uint32_t ulMid = static_cast<std::uint32_t>(mid - facets.begin());
+
+    // the first child directly follows its parent
+    BuildNode(facets, ulBegin, ulMid);
+    std::uint32_t ulSecond = BuildNode(facets, ulMid, ulEnd);
+    _aclNodes[ulNode].ulFirst = ulSecond;
+    _aclNodes[ulNode].ulCount = 0;
+    return ulNode;
+}
+
+Base::BoundBox3f MeshFacetBVH::GetFacetBoundBox(std::uint32_t ulPos) const
+{
+    Base::BoundBox3f box;
+    box.Add(_aclPoints[3 * ulPos]);
+    box.Add(_aclPoints[3 * ulPos + 1]);
+    box.Add(_aclPoints[3 * ulPos + 2]);
+    return box;
+}
+
+bool MeshFacetBVH::NearestFacetOnRay(const Base::Vector3f& rclPt, const Base::Vector3f& rclDir,
+                                     Base::Vector3f& rclRes, unsigned long& rulFacet) const
+{
+    if (_aclNodes.empty())
+        return false;
+
+    float fLen = rclDir.Length();
+    if (fLen == 0.0f)
+        return false;
+
+    // use a normalized direction so that the ray parameter is the distance
+    Base::Vector3f dir = rclDir / fLen;
+    float org[3] = { rclPt.x, rclPt.y, rclPt.z };
+    float inv[3] = { 1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z };
+
+    float fBest = FLT_MAX;
+    std::uint32_t ulBest = UINT32_MAX;
+    Base::Vector3f clBest;
+
+    std::vector<std::pair<float, std::uint32_t> > stack;
+    stack.push_back(std::make_pair(0.0f, 0u));
+    while (!stack.empty()) {
+        std::pair<float, std::uint32_t> entry = stack.back();
+        stack.pop_back();
+        if (entry.first > fBest)
+            continue;
+
+        const Node& node = _aclNodes[entry.second];
+        if (node.ulCount > 0) {
+            for (std::uint32_t i = node.ulFirst; i < node.ulFirst + node.ulCount; i++) {
+                MeshGeomFacet facet(_aclPoints[3 * i], _aclPoints[3 * i + 1], _aclPoints[3 * i + 2]);
+                Base::Vector3f clRes;
+                if (facet.Foraminate(rclPt, dir, clRes)) {
+                    float t = (clRes - rclPt) * dir;
+                    if (t >= 0.0f && t < fBest) {
+                        fBest = t;
+                        ulBest = i;
+                        clBest = clRes;
+                    }
+                }
+            }
+        }
+        else {
+            // visit the nearer child first
+            const Node& first = _aclNodes[entry.second + 1];
+            const Node& second = _aclNodes[node.ulFirst];
+            float t1 = IntersectRay(first.fMin, first.fMax, org, inv, fBest);
+            float t2 = IntersectRay(second.fMin, second.fMax, org, inv, fBest);
+            if (t1 <= t2) {
+                if (t2 != FLT_MAX)
+                    stack.push_back(std::make_pair(t2, node.ulFirst));
+                if (t1 != FLT_MAX)
+                    stack.push_back(std::make_pair(t1, entry.second + 1));
+            }
+            else {
+                if (t1 != FLT_MAX)
+                    stack.push_back(std::make_pair(t1, entry.second + 1));
+                if (t2 != FLT_MAX)
+                    stack.push_back(std::make_pair(t2, node.ulFirst));
+            }
+        }
+    }
+
+    if (ulBest == UINT32_MAX)
+        return false;
+
+    rclRes = clBest;
+    rulFacet = _aulFacets[ulBest];
+    return true;
+}
+
+unsigned long MeshFacetBVH::NearestFacetToPoint(const Base::Vector3f& rclPt, float fMaxDist,
+                                                Base::Vector3f& rclRes, float& rfDist) const
+{
+    if (_aclNodes.empty())
+        return ULONG_MAX;
+
+    float fBest = fMaxDist;
+    float fBestP2 = fMaxDist < FLT_MAX ? fMaxDist * fMaxDist : FLT_MAX;
+    std::uint32_t ulBest = UINT32_MAX;
+    Base::Vector3f clBest;
+
+    std::vector<std::pair<float, std::uint32_t> > stack;
+    stack.push_back(std::make_pair(DistanceP2(_aclNodes[0].fMin, _aclNodes[0].fMax, rclPt), 0u));
+    while (!stack.empty()) {
+        std::pair<float, std::uint32_t> entry = stack.back();
+        stack.pop_back();
+        if (entry.first >= fBestP2)
+            continue;
+
+        const Node& node = _aclNodes[entry.second];
+        if (node.ulCount > 0) {
+            for (std::uint32_t i = node.ulFirst; i < node.ulFirst + node.ulCount; i++) {
+                MeshGeomFacet facet(_aclPoints[3 * i], _aclPoints[3 * i + 1], _aclPoints[3 * i + 2]);
+                Base::Vector3f clRes;
+                float fDist = facet.DistanceToPoint(rclPt, clRes);
+                if (fDist < fBest) {
+                    fBest = fDist;
+                    fBestP2 = fDist * fDist;
+                    ulBest = i;
+                    clBest = clRes;
+                }
+            }
+        }
+        else {
+            // visit the nearer child first
+            const Node& first = _aclNodes[entry.second + 1];
+            const Node& second = _aclNodes[node.ulFirst];
+            float d1 = DistanceP2(first.fMin, first.fMax, rclPt);
+            float d2 = DistanceP2(second.fMin, second.fMax, rclPt);
+            if (d1 <= d2) {
+                stack.push_back(std::make_pair(d2, node.ulFirst));
+                stack.push_back(std::make_pair(d1, entry.second + 1));
+            }
+            else {
+                stack.push_back(std::make_pair(d1, entry.second + 1));
+                stack.push_back(std::make_pair(d2, node.ulFirst));
+            }
+        }
+    }
+
+    if (ulBest == UINT32_MAX)
+        return ULONG_MAX;
+
+    rclRes = clBest;
+    rfDist = fBest;
+    return _aulFacets[ulBest];
+}
+
+unsigned long MeshFacetBVH::NearestFacetToPoint(const Base::Vector3f& rclPt,
+                                                Base::Vector3f& rclRes, float& rfDist) const
+{
+    return NearestFacetToPoint(rclPt, FLT_MAX, rclRes, rfDist);
+}
+
+unsigned long MeshFacetBVH::Inside(const Base::BoundBox3f& rclBB, std::vector<unsigned long>& raulFacets) const
+{
+    return Collect([&rclBB](const Base::BoundBox3f& box) {
+        return rclBB.Intersect(box);
+    }, raulFacets);
+}
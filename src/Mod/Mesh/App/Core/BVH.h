@@ -0,0 +1,152 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef MESH_BVH_H
+#define MESH_BVH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/Vector3D.h>
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshFacetBVH class is a bounding volume hierarchy over the facets of a mesh.
+ * It can be used instead of a MeshFacetGrid for ray, nearest point and box queries.
+ * Unlike the grid it adapts to the distribution of the facets, so it keeps its
+ * performance on meshes with a very non-uniform facet density.
+ *
+ * The tree is built with the surface area heuristic and stored as a flat array of
+ * 32 byte nodes in depth-first order. The corner points of the facets are copied
+ * in leaf order so that a query doesn't need to access the mesh kernel.
+ * @note The hierarchy must be rebuilt after the mesh has been modified.
+ */
+class MeshExport MeshFacetBVH
+{
+public:
+    MeshFacetBVH(const MeshKernel& mesh);
+    ~MeshFacetBVH();
+
+    /** Rebuilds the hierarchy from the facets of the mesh. */
+    void Rebuild();
+    /** Returns true if the hierarchy doesn't contain any facets. */
+    bool IsEmpty() const;
+    /** Returns the number of facets of the hierarchy. */
+    unsigned long CountFacets() const;
+
+    /**
+     * Searches for the nearest facet hit by the ray defined by (\a rclPt, \a rclDir).
+     * Only facets lying in direction of \a rclDir are taken into account.
+     * The point \a rclRes holds the intersection point and \a rulFacet the index of the facet.
+     */
+    bool NearestFacetOnRay(const Base::Vector3f& rclPt, const Base::Vector3f& rclDir,
+                           Base::Vector3f& rclRes, unsigned long& rulFacet) const;
+    /**
+     * Searches for the facet nearest to the point \a rclPt with a distance lower than
+     * \a fMaxDist. \a rclRes is set to the nearest point on this facet and \a rfDist to its
+     * distance. If no such facet exists ULONG_MAX is returned.
+     */
+    unsigned long NearestFacetToPoint(const Base::Vector3f& rclPt, float fMaxDist,
+                                      Base::Vector3f& rclRes, float& rfDist) const;
+    /** Does the same as the method above without any distance limit. */
+    unsigned long NearestFacetToPoint(const Base::Vector3f& rclPt,
+                                      Base::Vector3f& rclRes, float& rfDist) const;
+    /** Sets \a raulFacets to the sorted indices of the facets whose bounding box intersects \a rclBB. */
+    unsigned long Inside(const Base::BoundBox3f& rclBB, std::vector<unsigned long>& raulFacets) const;
+    /**
+     * Sets \a raulFacets to the sorted indices of the facets whose bounding box is accepted by
+     * \a pred. A sub-tree is skipped if its bounding box is rejected, so the predicate must accept
+     * every box that contains an accepted box.
+     */
+    template <class Predicate>
+    unsigned long Collect(Predicate pred, std::vector<unsigned long>& raulFacets) const;
+
+private:
+    struct Node
+    {
+        float fMin[3];
+        std::uint32_t ulFirst; /**< First facet of a leaf or the second child of an inner node. */
+        float fMax[3];
+        std::uint32_t ulCount; /**< Number of facets of a leaf, zero for inner nodes. */
+
+        Base::BoundBox3f GetBoundBox() const
+        { return Base::BoundBox3f(fMin[0], fMin[1], fMin[2], fMax[0], fMax[1], fMax[2]); }
+    };
+
+    struct BuildFacet;
+    std::uint32_t BuildNode(std::vector<BuildFacet>& facets, std::uint32_t ulBegin, std::uint32_t ulEnd);
+    Base::BoundBox3f GetFacetBoundBox(std::uint32_t ulPos) const;
+
+private:
+    const MeshKernel& _rclMesh;
+    std::vector<Node> _aclNodes;            /**< Nodes in depth-first order, the first child follows its parent. */
+    std::vector<std::uint32_t> _aulFacets;  /**< Facet indices in leaf order. */
+    std::vector<Base::Vector3f> _aclPoints; /**< Three corner points per facet in leaf order. */
+
+    MeshFacetBVH(const MeshFacetBVH&);
+    void operator= (const MeshFacetBVH&);
+};
+
+template <class Predicate>
+unsigned long MeshFacetBVH::Collect(Predicate pred, std::vector<unsigned long>& raulFacets) const
+{
+    raulFacets.clear();
+    if (_aclNodes.empty())
+        return 0;
+
+    std::vector<std::uint32_t> stack;
+    stack.push_back(0);
+    while (!stack.empty()) {
+        std::uint32_t ulNode = stack.back();
+        stack.pop_back();
+
+        const Node& node = _aclNodes[ulNode];
+        if (!pred(node.GetBoundBox()))
+            continue;
+
+        if (node.ulCount > 0) {
+            for (std::uint32_t i = node.ulFirst; i < node.ulFirst + node.ulCount; i++) {
+                if (pred(GetFacetBoundBox(i)))
+                    raulFacets.push_back(_aulFacets[i]);
+            }
+        }
+        else {
+            stack.push_back(node.ulFirst);
+            stack.push_back(ulNode + 1);
+        }
+    }
+
+    std::sort(raulFacets.begin(), raulFacets.end());
+    return raulFacets.size();
+}
+
+} // namespace MeshCore
+
+
+#endif  // MESH_BVH_H
@@ -25,6 +25,9 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <cstring>
+# include <limits>
+# include <vector>
 #endif
 
 #include <Base/Sequencer.h>
@@ -282,6 +285,35 @@ struct MeshFastBuilder::Private {
         }
     };
 
+    // Reads a corner of a facet from records laid out like binary STL
+    struct Corner
+    {
+        Corner(const char* data, std::size_t stride) : data(data), stride(stride) {}
+
+        Vertex operator()(uint32_t c) const
+        {
+            // the records need not be aligned
+            float coords[3];
+            std::memcpy(coords, data + (c / 3) * stride + (c % 3) * sizeof(coords), sizeof(coords));
+            return Vertex(coords[0], coords[1], coords[2]);
+        }
+
+        const char* data;
+        std::size_t stride;
+    };
+
+    struct CornerLess
+    {
+        CornerLess(const Corner& corner) : corner(corner) {}
+
+        bool operator()(uint32_t lhs, uint32_t rhs) const
+        {
+            return corner(lhs) < corner(rhs);
+        }
+
+        Corner corner;
+    };
+
     // Hint: Using a QVector instead of std::vector is a bit faster
     QVector<Vertex> verts;
 };
@@ -322,6 +354,49 @@ void MeshFastBuilder::AddFacet (const MeshGeomFacet& facetPoints)
     }
 }
 
+void MeshFastBuilder::Build (const char* data, size_type ctFacets, std::size_t stride)
+{
+    if (static_cast<std::size_t>(ctFacets) > std::numeric_limits<uint32_t>::max() / 3)
+        throw Base::IndexError("Too many facets");
+
+    // The corners are referenced by their index and their coordinates are
+    // read from the records when needed, so they are never copied
+    Private::Corner corner(data, stride);
+    std::vector<uint32_t> corners(3 * static_cast<std::size_t>(ctFacets));
+    for (std::size_t i = 0; i < corners.size(); ++i)
+        corners[i] = static_cast<uint32_t>(i);
+
+    int threads = std::max(1, QThread::idealThreadCount());
+    MeshCore::parallel_sort(corners.begin(), corners.end(), Private::CornerLess(corner), threads);
+
+    // count the distinct points to allocate the point array only once
+    std::size_t ctPoints = 0;
+    for (std::size_t i = 0; i < corners.size(); ++i) {
+        if (!i || corner(corners[i]) != corner(corners[i-1]))
+            ++ctPoints;
+    }
+
+    MeshPointArray rPoints(static_cast<unsigned long>(ctPoints));
+    MeshFacetArray rFacets(static_cast<unsigned long>(ctFacets));
+
+    std::size_t index = 0;
+    Private::Vertex last;
+    for (std::vector<uint32_t>::const_iterator it = corners.begin(); it != corners.end(); ++it) {
+        Private::Vertex v = corner(*it);
+        if (!index || v != last) {
+            rPoints[index++].Set(v.x, v.y, v.z);
+            last = v;
+        }
+
+        rFacets[*it / 3]._aulPoints[*it % 3] = static_cast<unsigned long>(index - 1);
+    }
+
+    // release the corners before the neighbourhood gets built
+    std::vector<uint32_t>().swap(corners);
+
+    _meshKernel.Adopt(rPoints, rFacets, true);
+}
+
 void MeshFastBuilder::Finish ()
 {
     typedef QVector<Private::Vertex>::size_type size_type;
@@ -335,31 +410,27 @@ void MeshFastBuilder::Finish ()
     int threads = std::max(1, QThread::idealThreadCount());
     MeshCore::parallel_sort(verts.begin(), verts.end(), std::less<Private::Vertex>(), threads);
 
-    QVector<unsigned long> indices(ulCtPts);
+    // the point indices are directly written into the facets, so no
+    // additional index array for all corners is needed
+    size_type ulCt = ulCtPts/3;
+    MeshFacetArray rFacets(static_cast<unsigned long>(ulCt));
 
     size_type vertex_count = 0;
     for (QVector<Private::Vertex>::iterator v = verts.begin(); v != verts.end(); ++v) {
         if (!vertex_count || *v != verts[vertex_count-1])
             verts[vertex_count++] = *v;
 
-        indices[v->i] = static_cast<unsigned long>(vertex_count - 1);
+        rFacets[static_cast<size_t>(v->i / 3)]._aulPoints[v->i % 3] = static_cast<unsigned long>(vertex_count - 1);
     }
 
-    size_type ulCt = verts.size()/3;
-    MeshFacetArray rFacets(static_cast<unsigned long>(ulCt));
-    for (size_type i=0; i < ulCt; ++i) {
-        rFacets[static_cast<size_t>(i)]._aulPoints[0] = indices[3*i];
-        rFacets[static_cast<size_t>(i)]._aulPoints[1] = indices[3*i + 1];
-        rFacets[static_cast<size_t>(i)]._aulPoints[2] = indices[3*i + 2];
+    MeshPointArray rPoints(static_cast<unsigned long>(vertex_count));
+    for (size_type i=0; i < vertex_count; ++i) {
+        const Private::Vertex& v = verts[i];
+        rPoints[static_cast<size_t>(i)].Set(v.x, v.y, v.z);
     }
 
-    verts.resize(vertex_count);
-
-    MeshPointArray rPoints;
-    rPoints.reserve(static_cast<size_t>(vertex_count));
-    for (QVector<Private::Vertex>::iterator v = verts.begin(); v != verts.end(); ++v) {
-        rPoints.push_back(MeshPoint(v->x, v->y, v->z));
-    }
+    // release the corners before the neighbourhood gets built
+    QVector<Private::Vertex>().swap(verts);
 
     _meshKernel.Adopt(rPoints, rFacets, true);
 }
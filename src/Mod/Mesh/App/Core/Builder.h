@@ -201,6 +201,14 @@ public:
     /** Add new facet
      */
     void AddFacet (const MeshGeomFacet& facetPoints);
+    /** Builds the mesh from \a ctFacets facets at once, instead of Initialize(),
+     * AddFacet() and Finish(). The nine coordinates of the corner points of a facet
+     * are expected as consecutive floats and successive facets are \a stride bytes
+     * apart, like the records of a binary STL file. The points are welded directly
+     * from the records, e.g. of a memory mapped file, into the point and facet
+     * arrays of the kernel without copying the corners.
+     */
+    void Build (const char* data, size_type ctFacets, std::size_t stride);
 
     /** Finishes building up the mesh structure. Must be done after adding facets.
      */
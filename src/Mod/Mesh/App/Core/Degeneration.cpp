@@ -38,6 +38,7 @@
 #include "Info.h"
 #include "Grid.h"
 #include "TopoAlgorithm.h"
+#include "Functional.h"
 
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <Base/Sequencer.h>
@@ -310,6 +311,24 @@ struct MeshFacet_Less
     }
 };
 
+/*
+ * Equal facets are ordered by their position in the facet array. This makes the
+ * order independent of the sort algorithm, so the array can be sorted in parallel.
+ */
+struct MeshFacet_Order
+{
+    bool operator()(const FaceIterator& x,
+                    const FaceIterator& y) const
+    {
+        MeshFacet_Less less;
+        if (less(x, y))
+            return true;
+        else if (less(y, x))
+            return false;
+        return x < y;
+    }
+};
+
 }
 
 /*
@@ -362,9 +381,11 @@ std::vector<unsigned long> MeshEvalDuplicateFacets::GetIndices() const
     }
 
     // if there are two adjacent faces which references the same vertices
+    // the face with the lowest index is kept and the others are reported
     std::vector<unsigned long> aInds;
     MeshFacet_EqualTo pred;
-    std::sort(faces.begin(), faces.end(), MeshFacet_Less());
+    int threads = std::max(1, QThread::idealThreadCount());
+    MeshCore::parallel_sort(faces.begin(), faces.end(), MeshFacet_Order(), threads);
 
     std::vector<FaceIterator>::iterator ft = faces.begin();
     while (ft < faces.end()) {
@@ -472,13 +493,21 @@ unsigned long MeshEvalDegeneratedFacets::CountEdgeTooSmall (float fMinEdgeLength
 
 std::vector<unsigned long> MeshEvalDegeneratedFacets::GetIndices() const
 {
-    std::vector<unsigned long> aInds;
-    MeshFacetIterator it(_rclMesh);
-    for (it.Init(); it.More(); it.Next()) {
-        if (it->IsDegenerated(fEpsilon))
-            aInds.push_back(it.Position());
-    }
+    // the facets are checked in parallel and don't access the facet flags
+    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    float fEps = fEpsilon;
+    auto degenerated = [&rFaces, &rPoints, fEps](unsigned long index) {
+        const MeshFacet& face = rFaces[index];
+        MeshGeomFacet facet(rPoints[face._aulPoints[0]],
+                            rPoints[face._aulPoints[1]],
+                            rPoints[face._aulPoints[2]]);
+        return facet.IsDegenerated(fEps);
+    };
 
+    std::vector<unsigned long> aInds;
+    int threads = std::max(1, QThread::idealThreadCount());
+    MeshCore::parallel_find_indices(rFaces.size(), degenerated, aInds, threads);
     return aInds;
 }
 
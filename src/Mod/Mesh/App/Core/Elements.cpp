@@ -110,7 +110,8 @@ MeshFacetArray::MeshFacetArray(const MeshFacetArray& ary)
 
 void MeshFacetArray::Erase (_TIterator pIter)
 {
-  unsigned long i, *pulN;
+  unsigned long i;
+  MeshIndex *pulN;
   _TIterator  pPass, pEnd;
   unsigned long ulInd = pIter - begin();
   erase(pIter);
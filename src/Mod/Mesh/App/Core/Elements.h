@@ -24,14 +24,17 @@
 #ifndef MESH_ELEMENTS_H
 #define MESH_ELEMENTS_H
 
+#include <algorithm>
 #include <functional>
 #include <vector>
 #include <climits>
+#include <cstdint>
 #include <cstring>
 
 #include "Definitions.h"
 
 #include <Base/BoundBox.h>
+#include <Base/Exception.h>
 #include <Base/Vector3D.h>
 #include <Base/Matrix.h>
 
@@ -88,6 +91,60 @@ struct MeshExport VertexCollapse
   std::vector<unsigned long> _circumFacets;
 };
 
+/**
+ * The MeshIndex class is the storage type of the indices and properties of MeshPoint
+ * and MeshFacet. The value is kept in 32 bits which halves the size of the point and facet
+ * arrays on 64-bit platforms, while all algorithms keep on working with unsigned long.
+ * ULONG_MAX, used to mark an invalid index (e.g. a missing neighbour), is preserved.
+ *
+ * Note: A mesh is thus limited to 2^32-1 points and facets, a larger index throws
+ * a Base::IndexError instead of being truncated.
+ */
+class MeshIndex
+{
+public:
+  MeshIndex (void) : _uiValue(0) { }
+  explicit MeshIndex (unsigned long ulValue) : _uiValue(Compact(ulValue)) { }
+
+  operator unsigned long (void) const
+  { return _uiValue == UINT32_MAX ? ULONG_MAX : static_cast<unsigned long>(_uiValue); }
+
+  MeshIndex& operator = (unsigned long ulValue)
+  { _uiValue = Compact(ulValue); return *this; }
+  MeshIndex& operator += (unsigned long ulValue)
+  { return *this = static_cast<unsigned long>(*this) + ulValue; }
+  MeshIndex& operator -= (unsigned long ulValue)
+  { return *this = static_cast<unsigned long>(*this) - ulValue; }
+  MeshIndex& operator ++ (void)
+  { return *this += 1; }
+  MeshIndex& operator -- (void)
+  { return *this -= 1; }
+  unsigned long operator ++ (int)
+  { unsigned long ulValue = *this; *this += 1; return ulValue; }
+  unsigned long operator -- (int)
+  { unsigned long ulValue = *this; *this -= 1; return ulValue; }
+
+  // The mapping of ULONG_MAX keeps the order, so compare the raw values
+  bool operator == (const MeshIndex &rclIdx) const
+  { return _uiValue == rclIdx._uiValue; }
+  bool operator != (const MeshIndex &rclIdx) const
+  { return _uiValue != rclIdx._uiValue; }
+  bool operator < (const MeshIndex &rclIdx) const
+  { return _uiValue < rclIdx._uiValue; }
+
+private:
+  static uint32_t Compact (unsigned long ulValue)
+  {
+    if (ulValue == ULONG_MAX)
+      return UINT32_MAX;
+    if (ulValue >= UINT32_MAX)
+      throw Base::IndexError("Mesh index exceeds the range of 32 bits");
+    return static_cast<uint32_t>(ulValue);
+  }
+
+  uint32_t _uiValue;
+};
+
 /**
  * The MeshPoint class represents a point in the mesh data structure. The class inherits from
  * Vector3f and provides some additional information such as flag state and property value.
@@ -146,7 +203,7 @@ public:
 
 public:
   unsigned char _ucFlag; /**< Flag member */
-  unsigned long _ulProp; /**< Free usable property */
+  MeshIndex     _ulProp; /**< Free usable property */
 };
 
 /**
@@ -323,9 +380,9 @@ public:
 
 public:
   unsigned char _ucFlag; /**< Flag member. */
-  unsigned long _ulProp; /**< Free usable property. */
-  unsigned long _aulPoints[3];     /**< Indices of corner points. */
-  unsigned long _aulNeighbours[3]; /**< Indices of neighbour facets. */
+  MeshIndex     _ulProp; /**< Free usable property. */
+  MeshIndex     _aulPoints[3];     /**< Indices of corner points. */
+  MeshIndex     _aulNeighbours[3]; /**< Indices of neighbour facets. */
 };
 
 /**
@@ -861,8 +918,8 @@ inline MeshFacet::MeshFacet (void)
 : _ucFlag(0),
   _ulProp(0)
 {
-    memset(_aulNeighbours, 0xff, sizeof(unsigned long) * 3);
-    memset(_aulPoints, 0xff, sizeof(unsigned long) * 3);
+    std::fill(_aulNeighbours, _aulNeighbours + 3, MeshIndex(ULONG_MAX));
+    std::fill(_aulPoints, _aulPoints + 3, MeshIndex(ULONG_MAX));
 }
 
 inline MeshFacet::MeshFacet(const MeshFacet &rclF)
@@ -25,6 +25,7 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <atomic>
 # include <vector>
 #endif
 
@@ -32,6 +33,7 @@
 #include <Mod/Mesh/App/WildMagic4/Wm4Vector3.h>
 
 #include "Evaluation.h"
+#include "Degeneration.h"
 #include "Iterator.h"
 #include "Algorithm.h"
 #include "Approximation.h"
@@ -315,6 +317,11 @@ struct Edge_Index
     unsigned long p0, p1, f;
 };
 
+/*
+ * Edges with the same end points are ordered by their facet index. This makes the
+ * order of the sorted edge list independent of the sort algorithm, so sorting the
+ * list in parallel gives the same result as sorting it sequentially.
+ */
 struct Edge_Less
 {
     bool operator()(const Edge_Index& x, const Edge_Index& y) const
@@ -327,7 +334,7 @@ struct Edge_Less
             return true;
         else if (x.p1 > y.p1)
             return false;
-        return false;
+        return x.f < y.f;
     }
 };
 
@@ -357,7 +364,8 @@ bool MeshEvalTopology::Evaluate ()
     }
 
     // sort the edges
-    std::sort(edges.begin(), edges.end(), Edge_Less());
+    int threads = std::max(1, QThread::idealThreadCount());
+    MeshCore::parallel_sort(edges.begin(), edges.end(), Edge_Less(), threads);
 
     // search for non-manifold edges
     unsigned long p0 = ULONG_MAX, p1 = ULONG_MAX;
@@ -397,13 +405,14 @@ void MeshEvalTopology::GetFacetManifolds (std::vector<unsigned long> &raclFacetI
     const MeshFacetArray& rclFAry = _rclMesh.GetFacets();
     MeshFacetArray::_TConstIterator pI;
 
+    // the non-manifold edges are sorted because they are taken from the sorted edge list
     for (pI = rclFAry.begin(); pI != rclFAry.end(); ++pI) {
         for (int i = 0; i < 3; i++) {
             unsigned long ulPt0 = std::min<unsigned long>(pI->_aulPoints[i],  pI->_aulPoints[(i+1)%3]);
             unsigned long ulPt1 = std::max<unsigned long>(pI->_aulPoints[i],  pI->_aulPoints[(i+1)%3]);
             std::pair<unsigned long,unsigned long> edge  = std::make_pair(ulPt0, ulPt1);
 
-            if (std::find(nonManifoldList.begin(), nonManifoldList.end(), edge) != nonManifoldList.end())
+            if (std::binary_search(nonManifoldList.begin(), nonManifoldList.end(), edge))
                 raclFacetIndList.push_back(pI - rclFAry.begin());
         }
     }
@@ -593,76 +602,186 @@ bool MeshFixSingleFacet::Fixup ()
 
 // ----------------------------------------------------------------
 
-bool MeshEvalSelfIntersection::Evaluate ()
-{
-    // Contains bounding boxes for every facet 
-    std::vector<Base::BoundBox3f> boxes;
+namespace MeshCore {
 
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX, ulGridY, ulGridZ;
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
+/*
+ * Checks the facets of a contiguous range of grid cells for self-intersections.
+ * The cells are addressed by their running number in x, y, z order so that the
+ * grid can be split into independent blocks.
+ */
+class SelfIntersectionCells
+{
+public:
+    SelfIntersectionCells(const MeshKernel& rclMesh, const MeshFacetGrid& rclGrid,
+                          const std::vector<Base::BoundBox3f>& boxes, bool firstOnly,
+                          std::atomic<bool>& stop)
+      : _rclMesh(rclMesh), _rclGrid(rclGrid), _boxes(boxes), _firstOnly(firstOnly), _stop(stop)
+    {
+        _rclGrid.GetCtGrids(_ulX, _ulY, _ulZ);
+    }
 
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
+    unsigned long CountCells() const
+    {
+        return _ulX * _ulY * _ulZ;
     }
 
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX*ulGridY*ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        //Get the facet indices, belonging to the current grid unit
+    void Check(unsigned long ulBegin, unsigned long ulEnd,
+               std::vector<std::pair<unsigned long, unsigned long> >* intersection) const
+    {
+        const MeshFacetArray& rFaces = _rclMesh.GetFacets();
+        const MeshPointArray& rPoints = _rclMesh.GetPoints();
         std::vector<unsigned long> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next();
-        if (aulGridElements.size()==0)
-            continue;
-
-        MeshGeomFacet facet1, facet2;
         Base::Vector3f pt1, pt2;
-        for (std::vector<unsigned long>::iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<unsigned long>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) // the identical facet
-                    continue;
-                // If the facets share a common vertex we do not check for self-intersections because they 
-                // could but usually do not intersect each other and the algorithm below would detect false-positives,
-                // otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[0] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[0] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[1] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[1] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[1] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[2] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[2] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[2] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
+
+        for (unsigned long ulCell = ulBegin; ulCell < ulEnd; ulCell++) {
+            if (_stop)
+                return;
+
+            // Get the facet indices, belonging to the current grid unit
+            unsigned long ulGridX = ulCell % _ulX;
+            unsigned long ulGridY = (ulCell / _ulX) % _ulY;
+            unsigned long ulGridZ = ulCell / (_ulX * _ulY);
+            aulGridElements.clear();
+            _rclGrid.GetElements(ulGridX, ulGridY, ulGridZ, aulGridElements);
+
+            for (std::vector<unsigned long>::iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
+                const Base::BoundBox3f& box1 = _boxes[*it];
+                const MeshFacet& rface1 = rFaces[*it];
+                MeshGeomFacet facet1(rPoints[rface1._aulPoints[0]],
+                                     rPoints[rface1._aulPoints[1]],
+                                     rPoints[rface1._aulPoints[2]]);
+                for (std::vector<unsigned long>::iterator jt = it + 1; jt != aulGridElements.end(); ++jt) {
+                    // If the facets share a common vertex we do not check for self-intersections because they 
+                    // could but usually do not intersect each other and the algorithm below would detect false-positives,
+                    // otherwise
+                    const MeshFacet& rface2 = rFaces[*jt];
+                    if (rface1._aulPoints[0] == rface2._aulPoints[0] || 
+                        rface1._aulPoints[0] == rface2._aulPoints[1] ||
+                        rface1._aulPoints[0] == rface2._aulPoints[2])
+                        continue; // ignore facets sharing a common vertex
+                    if (rface1._aulPoints[1] == rface2._aulPoints[0] || 
+                        rface1._aulPoints[1] == rface2._aulPoints[1] ||
+                        rface1._aulPoints[1] == rface2._aulPoints[2])
+                        continue; // ignore facets sharing a common vertex
+                    if (rface1._aulPoints[2] == rface2._aulPoints[0] || 
+                        rface1._aulPoints[2] == rface2._aulPoints[1] ||
+                        rface1._aulPoints[2] == rface2._aulPoints[2])
+                        continue; // ignore facets sharing a common vertex
+
+                    const Base::BoundBox3f& box2 = _boxes[*jt];
+                    if (box1 && box2) {
+                        MeshGeomFacet facet2(rPoints[rface2._aulPoints[0]],
+                                             rPoints[rface2._aulPoints[1]],
+                                             rPoints[rface2._aulPoints[2]]);
+                        int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
+                        if (ret == 2) {
+                            intersection->emplace_back(*it, *jt);
+                            if (_firstOnly) {
+                                // abort after the first detected self-intersection
+                                _stop = true;
+                                return;
+                            }
+                        }
                     }
                 }
             }
         }
     }
 
-    return true;
+private:
+    const MeshKernel& _rclMesh;
+    const MeshFacetGrid& _rclGrid;
+    const std::vector<Base::BoundBox3f>& _boxes;
+    bool _firstOnly;
+    std::atomic<bool>& _stop;
+    unsigned long _ulX, _ulY, _ulZ;
+};
+
+}
+
+void MeshEvalSelfIntersection::SearchIntersections(bool firstOnly,
+                                                   std::vector<std::pair<unsigned long, unsigned long> >& intersection) const
+{
+    // Contains bounding boxes for every facet 
+    std::vector<Base::BoundBox3f> boxes;
+    boxes.reserve(_rclMesh.CountFacets());
+    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    for (MeshFacetArray::_TConstIterator it = rFaces.begin(); it != rFaces.end(); ++it) {
+        Base::BoundBox3f box;
+        box.Add(rPoints[it->_aulPoints[0]]);
+        box.Add(rPoints[it->_aulPoints[1]]);
+        box.Add(rPoints[it->_aulPoints[2]]);
+        boxes.push_back(box);
+    }
+
+    // Splits the mesh using grid for speeding up the calculation
+    MeshFacetGrid cMeshFacetGrid(_rclMesh);
+    std::atomic<bool> stop(false);
+    SelfIntersectionCells cells(_rclMesh, cMeshFacetGrid, boxes, firstOnly, stop);
+    unsigned long ulCtCells = cells.CountCells();
+
+    // The cells are split into blocks that are checked in parallel. The results of the
+    // blocks are appended in the order of the cells, so they don't depend on the number
+    // of threads. There are more blocks than threads to balance the load and to update
+    // the progress bar while waiting.
+    int threads = std::max(1, QThread::idealThreadCount());
+    unsigned long ulBlocks = std::min<unsigned long>(16 * threads, ulCtCells);
+    unsigned long ulBlockSize = ulBlocks > 0 ? (ulCtCells + ulBlocks - 1) / ulBlocks : 0;
+    bool parallel = threads > 1 && _rclMesh.CountFacets() >= 10000;
+
+    // only the search for all intersections can be aborted by the user
+    Base::SequencerLauncher seq("Checking for self-intersections...", ulBlocks);
+    std::vector<std::vector<std::pair<unsigned long, unsigned long> > > results(ulBlocks);
+    if (!parallel) {
+        for (unsigned long i = 0; i < ulBlocks && !stop; i++) {
+            unsigned long ulBegin = std::min<unsigned long>(i * ulBlockSize, ulCtCells);
+            unsigned long ulEnd = std::min<unsigned long>(ulBegin + ulBlockSize, ulCtCells);
+            cells.Check(ulBegin, ulEnd, &results[i]);
+            seq.next(!firstOnly);
+        }
+    }
+    else {
+        std::vector<QFuture<void> > futures;
+        futures.reserve(ulBlocks);
+        for (unsigned long i = 0; i < ulBlocks; i++) {
+            unsigned long ulBegin = std::min<unsigned long>(i * ulBlockSize, ulCtCells);
+            unsigned long ulEnd = std::min<unsigned long>(ulBegin + ulBlockSize, ulCtCells);
+            std::vector<std::pair<unsigned long, unsigned long> >* result = &results[i];
+            futures.push_back(QtConcurrent::run([&cells, ulBegin, ulEnd, result]() {
+                cells.Check(ulBegin, ulEnd, result);
+            }));
+        }
+
+        try {
+            for (unsigned long i = 0; i < ulBlocks; i++) {
+                futures[i].waitForFinished();
+                seq.next(!firstOnly);
+            }
+        }
+        catch (...) {
+            // the user has aborted the check, stop the remaining blocks
+            stop = true;
+            for (unsigned long i = 0; i < ulBlocks; i++)
+                futures[i].waitForFinished();
+            throw;
+        }
+    }
+
+    for (unsigned long i = 0; i < ulBlocks; i++) {
+        if (firstOnly && !results[i].empty()) {
+            intersection.push_back(results[i].front());
+            break;
+        }
+        intersection.insert(intersection.end(), results[i].begin(), results[i].end());
+    }
+}
+
+bool MeshEvalSelfIntersection::Evaluate ()
+{
+    std::vector<std::pair<unsigned long, unsigned long> > intersection;
+    SearchIntersections(true, intersection);
+    return intersection.empty();
 }
 
 void MeshEvalSelfIntersection::GetIntersections(const std::vector<std::pair<unsigned long, unsigned long> >& indices,
@@ -691,72 +810,7 @@ void MeshEvalSelfIntersection::GetIntersections(const std::vector<std::pair<unsi
 
 void MeshEvalSelfIntersection::GetIntersections(std::vector<std::pair<unsigned long, unsigned long> >& intersection) const
 {
-    // Contains bounding boxes for every facet 
-    std::vector<Base::BoundBox3f> boxes;
-    //intersection.clear();
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX, ulGridY, ulGridZ;
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for(cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX*ulGridY*ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        //Get the facet indices, belonging to the current grid unit
-        std::vector<unsigned long> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next(true);
-        if (aulGridElements.size()==0)
-            continue;
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (std::vector<unsigned long>::iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<unsigned long>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) // the identical facet
-                    continue;
-                // If the facets share a common vertex we do not check for self-intersections because they 
-                // could but usually do not intersect each other and the algorithm below would detect false-positives,
-                // otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[0] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[0] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[1] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[1] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[1] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[2] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[2] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[2] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        intersection.emplace_back (*it,*jt);
-                    }
-                }
-            }
-        }
-    }
+    SearchIntersections(false, intersection);
 }
 
 std::vector<unsigned long> MeshFixSelfIntersection::GetFacets() const
@@ -829,7 +883,8 @@ bool MeshEvalNeighbourhood::Evaluate ()
     }
 
     // sort the edges
-    std::sort(edges.begin(), edges.end(), Edge_Less());
+    int threads = std::max(1, QThread::idealThreadCount());
+    MeshCore::parallel_sort(edges.begin(), edges.end(), Edge_Less(), threads);
 
     unsigned long p0 = ULONG_MAX, p1 = ULONG_MAX;
     unsigned long f0 = ULONG_MAX, f1 = ULONG_MAX;
@@ -895,7 +950,8 @@ std::vector<unsigned long> MeshEvalNeighbourhood::GetIndices() const
     }
 
     // sort the edges
-    std::sort(edges.begin(), edges.end(), Edge_Less());
+    int threads = std::max(1, QThread::idealThreadCount());
+    MeshCore::parallel_sort(edges.begin(), edges.end(), Edge_Less(), threads);
 
     unsigned long p0 = ULONG_MAX, p1 = ULONG_MAX;
     unsigned long f0 = ULONG_MAX, f1 = ULONG_MAX;
@@ -950,42 +1006,107 @@ bool MeshFixNeighbourhood::Fixup()
     return true;
 }
 
+namespace MeshCore {
+
+/*
+ * Compact edge record to rebuild the neighbourhood. As a mesh is limited to 32 bit
+ * indices both end points fit into one key. Edges with the same key are ordered by
+ * their facet index to make the result independent of the sort algorithm.
+ */
+struct Edge_Key
+{
+    uint64_t key;
+    uint32_t f;
+
+    Edge_Key() : key(0), f(0) {}
+    Edge_Key(unsigned long p0, unsigned long p1, unsigned long f)
+      : key((static_cast<uint64_t>(std::min(p0, p1)) << 32) | static_cast<uint64_t>(std::max(p0, p1)))
+      , f(static_cast<uint32_t>(f))
+    {
+    }
+    unsigned long P0() const
+    {
+        return static_cast<unsigned long>(key >> 32);
+    }
+    unsigned long P1() const
+    {
+        return static_cast<unsigned long>(key & 0xffffffff);
+    }
+    bool operator < (const Edge_Key& e) const
+    {
+        return key < e.key || (key == e.key && f < e.f);
+    }
+};
+
+}
+
 void MeshKernel::RebuildNeighbours (unsigned long index)
 {
-    std::vector<Edge_Index> edges;
-    edges.reserve(3 * (this->_aclFacetArray.size() - index));
+    unsigned long ulCtFacets = this->_aclFacetArray.size();
+    if (index >= ulCtFacets)
+        return;
 
-    // build up an array of edges
-    MeshFacetArray::_TConstIterator pI;
-    MeshFacetArray::_TConstIterator pB = this->_aclFacetArray.begin();
-    for (pI = pB + index; pI != this->_aclFacetArray.end(); ++pI) {
-        for (int i = 0; i < 3; i++) {
-            Edge_Index item;
-            item.p0 = std::min<unsigned long>(pI->_aulPoints[i], pI->_aulPoints[(i+1)%3]);
-            item.p1 = std::max<unsigned long>(pI->_aulPoints[i], pI->_aulPoints[(i+1)%3]);
-            item.f  = pI - pB;
-            edges.push_back(item);
+    int threads = std::max(1, QThread::idealThreadCount());
+
+    // Facets in front of 'index' are only taken into account if they share a
+    // point with one of the facets to rebuild, because only they can be adjacent
+    std::vector<unsigned long> facets;
+    if (index > 0) {
+        std::vector<char> touched(this->_aclPointArray.size(), 0);
+        for (MeshFacetArray::_TConstIterator pI = this->_aclFacetArray.begin() + index; pI != this->_aclFacetArray.end(); ++pI) {
+            touched[pI->_aulPoints[0]] = 1;
+            touched[pI->_aulPoints[1]] = 1;
+            touched[pI->_aulPoints[2]] = 1;
         }
+
+        const MeshFacetArray& rFacets = this->_aclFacetArray;
+        MeshCore::parallel_find_indices(index, [&rFacets, &touched](unsigned long f) {
+            const MeshFacet& rFace = rFacets[f];
+            return touched[rFace._aulPoints[0]] || touched[rFace._aulPoints[1]] || touched[rFace._aulPoints[2]];
+        }, facets, threads);
     }
 
+    // build up an array of edges, the adjacent facets are added first
+    unsigned long ulCtAdjacent = facets.size();
+    unsigned long ulCtEdges = 3 * (ulCtAdjacent + ulCtFacets - index);
+    std::vector<Edge_Key> edges(ulCtEdges);
+    MeshCore::parallel_for(ulCtEdges / 3, [&](unsigned long begin, unsigned long end) {
+        for (unsigned long i = begin; i < end; i++) {
+            unsigned long f = i < ulCtAdjacent ? facets[i] : index + i - ulCtAdjacent;
+            const MeshFacet& rFace = this->_aclFacetArray[f];
+            for (int j = 0; j < 3; j++)
+                edges[3 * i + j] = Edge_Key(rFace._aulPoints[j], rFace._aulPoints[(j+1)%3], f);
+        }
+    }, threads);
+
     // sort the edges
-    //std::sort(edges.begin(), edges.end(), Edge_Less());
-    int threads = std::max(1, QThread::idealThreadCount());
-    MeshCore::parallel_sort(edges.begin(), edges.end(), Edge_Less(), threads);
+    MeshCore::parallel_sort(edges.begin(), edges.end(), std::less<Edge_Key>(), threads);
+
+    // Set the neighbours of each group of edges with the same end points. The
+    // blocks are moved to the start of a group so that no group gets split and
+    // each facet side is written by one thread only.
+    MeshCore::parallel_for(ulCtEdges, [&](unsigned long begin, unsigned long end) {
+        while (begin > 0 && begin < ulCtEdges && edges[begin-1].key == edges[begin].key)
+            begin++;
+        while (end < ulCtEdges && edges[end-1].key == edges[end].key)
+            end++;
+
+        unsigned long next;
+        for (unsigned long i = begin; i < end; i = next) {
+            next = i + 1;
+            while (next < ulCtEdges && edges[next].key == edges[i].key)
+                next++;
+
+            // edges of the adjacent facets only are already set
+            if (edges[next-1].f < index)
+                continue;
 
-    unsigned long p0 = ULONG_MAX, p1 = ULONG_MAX;
-    unsigned long f0 = ULONG_MAX, f1 = ULONG_MAX;
-    int count = 0;
-    std::vector<Edge_Index>::iterator pE;
-    for (pE = edges.begin(); pE != edges.end(); ++pE) {
-        if (p0 == pE->p0 && p1 == pE->p1) {
-            f1 = pE->f;
-            count++;
-        }
-        else {
             // we handle only the cases for 1 and 2, for all higher
             // values we have a non-manifold that is ignored here
+            unsigned long p0 = edges[i].P0(), p1 = edges[i].P1();
+            unsigned long count = next - i;
             if (count == 2) {
+                unsigned long f0 = edges[i].f, f1 = edges[i+1].f;
                 MeshFacet& rFace0 = this->_aclFacetArray[f0];
                 MeshFacet& rFace1 = this->_aclFacetArray[f1];
                 unsigned short side0 = rFace0.Side(p0,p1);
@@ -994,33 +1115,12 @@ void MeshKernel::RebuildNeighbours (unsigned long index)
                 rFace1._aulNeighbours[side1] = f0;
             }
             else if (count == 1) {
-                MeshFacet& rFace = this->_aclFacetArray[f0];
+                MeshFacet& rFace = this->_aclFacetArray[edges[i].f];
                 unsigned short side = rFace.Side(p0,p1);
                 rFace._aulNeighbours[side] = ULONG_MAX;
             }
-
-            p0 = pE->p0;
-            p1 = pE->p1;
-            f0 = pE->f;
-            count = 1;
         }
-    }
-
-    // we handle only the cases for 1 and 2, for all higher
-    // values we have a non-manifold that is ignored here
-    if (count == 2) {
-        MeshFacet& rFace0 = this->_aclFacetArray[f0];
-        MeshFacet& rFace1 = this->_aclFacetArray[f1];
-        unsigned short side0 = rFace0.Side(p0,p1);
-        unsigned short side1 = rFace1.Side(p0,p1);
-        rFace0._aulNeighbours[side0] = f1;
-        rFace1._aulNeighbours[side1] = f0;
-    }
-    else if (count == 1) {
-        MeshFacet& rFace = this->_aclFacetArray[f0];
-        unsigned short side = rFace.Side(p0,p1);
-        rFace._aulNeighbours[side] = ULONG_MAX;
-    }
+    }, threads);
 }
 
 void MeshKernel::RebuildNeighbours (void)
@@ -1172,3 +1272,97 @@ void MeshEigensystem::CalculateLocalSystem()
     if ((_cU%_cV)*_cW < 0.0f)
         _cW = -_cW; // make a right-handed system
 }
+
+// ----------------------------------------------------------------
+
+bool MeshEvalDefects::Evaluate ()
+{
+    _flippedFacets.clear();
+    _nonManifoldEdges.clear();
+    _nonManifoldPoints.clear();
+    _invalidNeighbourIndices.clear();
+    _invalidPointIndices.clear();
+    _corruptedFacets.clear();
+    _invalidNeighbourhood.clear();
+    _degeneratedFacets.clear();
+    _duplicatedFacets.clear();
+    _duplicatedPoints.clear();
+    _selfIntersections.clear();
+
+    // all other checks rely on valid indices
+    _invalidPointIndices = MeshEvalRangePoint(_rclMesh).GetIndices();
+    _invalidNeighbourIndices = MeshEvalRangeFacet(_rclMesh).GetIndices();
+    bool validPoints = _invalidPointIndices.empty();
+    bool validNeighbours = _invalidNeighbourIndices.empty();
+    if (!(_checks & Indices)) {
+        _invalidPointIndices.clear();
+        _invalidNeighbourIndices.clear();
+    }
+
+    // These checks don't report progress and the orientation check is the only one
+    // that modifies the facet flags, which none of the other checks reads. So they
+    // can run in the background.
+    std::vector<QFuture<void> > futures;
+    if ((_checks & Orientation) && validNeighbours) {
+        futures.push_back(QtConcurrent::run([this]() {
+            _flippedFacets = MeshEvalOrientation(_rclMesh).GetIndices();
+        }));
+    }
+    if (_checks & DuplicatedFacets) {
+        futures.push_back(QtConcurrent::run([this]() {
+            _duplicatedFacets = MeshEvalDuplicateFacets(_rclMesh).GetIndices();
+        }));
+    }
+    if (_checks & DuplicatedPoints) {
+        futures.push_back(QtConcurrent::run([this]() {
+            _duplicatedPoints = MeshEvalDuplicatePoints(_rclMesh).GetIndices();
+        }));
+    }
+    if ((_checks & NonManifoldPoints) && validPoints) {
+        futures.push_back(QtConcurrent::run([this]() {
+            MeshEvalPointManifolds eval(_rclMesh);
+            eval.Evaluate();
+            _nonManifoldPoints = eval.GetIndices();
+        }));
+    }
+
+    try {
+        if (_checks & Indices) {
+            _corruptedFacets = MeshEvalCorruptedFacets(_rclMesh).GetIndices();
+            if (validPoints && validNeighbours)
+                _invalidNeighbourhood = MeshEvalNeighbourhood(_rclMesh).GetIndices();
+        }
+        if (_checks & NonManifolds) {
+            MeshEvalTopology eval(_rclMesh);
+            eval.Evaluate();
+            _nonManifoldEdges = eval.GetIndices();
+        }
+        if ((_checks & Degenerations) && validPoints) {
+            _degeneratedFacets = MeshEvalDegeneratedFacets(_rclMesh, _fEpsilon).GetIndices();
+        }
+        if ((_checks & SelfIntersections) && validPoints) {
+            MeshEvalSelfIntersection(_rclMesh).GetIntersections(_selfIntersections);
+        }
+    }
+    catch (...) {
+        // the background checks access this object, so wait for them before leaving
+        for (std::vector<QFuture<void> >::iterator it = futures.begin(); it != futures.end(); ++it)
+            it->waitForFinished();
+        throw;
+    }
+
+    for (std::vector<QFuture<void> >::iterator it = futures.begin(); it != futures.end(); ++it)
+        it->waitForFinished();
+
+    return _flippedFacets.empty() &&
+           _nonManifoldEdges.empty() &&
+           _nonManifoldPoints.empty() &&
+           _invalidNeighbourIndices.empty() &&
+           _invalidPointIndices.empty() &&
+           _corruptedFacets.empty() &&
+           _invalidNeighbourhood.empty() &&
+           _degeneratedFacets.empty() &&
+           _duplicatedFacets.empty() &&
+           _duplicatedPoints.empty() &&
+           _selfIntersections.empty();
+}
@@ -297,6 +297,14 @@ public:
         std::vector<std::pair<Base::Vector3f, Base::Vector3f> >&) const;
     /// collect the index of all facets with self intersections
     void GetIntersections(std::vector<std::pair<unsigned long, unsigned long> >&) const;
+
+private:
+    /**
+     * Searches the grid cells for intersecting facets. For large meshes the cells are split
+     * into blocks which are checked in parallel. If \a firstOnly is true the search stops
+     * after the first intersection.
+     */
+    void SearchIntersections(bool firstOnly, std::vector<std::pair<unsigned long, unsigned long> >&) const;
 };
 
 /**
@@ -380,6 +388,72 @@ private:
   float _fU, _fV, _fW; /**< Expansion in \a u, \a v, and \a w direction of the transformed mesh. */
 };
 
+// ----------------------------------------------------
+
+/**
+ * The MeshEvalDefects class runs the common checks of the mesh kernel in one go.
+ * Checks that neither modify the facet flags nor report progress run concurrently
+ * in the background while the others run on the calling thread, and most checks
+ * use several threads themselves.
+ * Checks that need valid point or neighbour indices are skipped if the index check
+ * fails.
+ */
+class MeshExport MeshEvalDefects : public MeshEvaluation
+{
+public:
+    enum Check {
+        Orientation       = 1,
+        NonManifolds      = 2,
+        NonManifoldPoints = 4,
+        Indices           = 8,
+        Degenerations     = 16,
+        DuplicatedFacets  = 32,
+        DuplicatedPoints  = 64,
+        SelfIntersections = 128,
+        AllChecks         = 255
+    };
+
+    MeshEvalDefects (const MeshKernel &rclB, float fEpsilon, int checks = AllChecks)
+      : MeshEvaluation(rclB), _fEpsilon(fEpsilon), _checks(checks) {}
+    virtual ~MeshEvalDefects () {}
+    /// Runs the selected checks and returns true if no defects were found
+    bool Evaluate ();
+
+    /** @name Results */
+    //@{
+    const std::vector<unsigned long>& GetFlippedFacets() const { return _flippedFacets; }
+    const std::vector<std::pair<unsigned long, unsigned long> >& GetNonManifoldEdges() const { return _nonManifoldEdges; }
+    const std::vector<unsigned long>& GetNonManifoldPoints() const { return _nonManifoldPoints; }
+    /// facets with an out of range neighbour index
+    const std::vector<unsigned long>& GetInvalidNeighbourIndices() const { return _invalidNeighbourIndices; }
+    /// facets with an out of range point index
+    const std::vector<unsigned long>& GetInvalidPointIndices() const { return _invalidPointIndices; }
+    /// facets referencing a point more than once
+    const std::vector<unsigned long>& GetCorruptedFacets() const { return _corruptedFacets; }
+    /// facets whose neighbour indices don't match the topology
+    const std::vector<unsigned long>& GetInvalidNeighbourhood() const { return _invalidNeighbourhood; }
+    const std::vector<unsigned long>& GetDegeneratedFacets() const { return _degeneratedFacets; }
+    const std::vector<unsigned long>& GetDuplicatedFacets() const { return _duplicatedFacets; }
+    const std::vector<unsigned long>& GetDuplicatedPoints() const { return _duplicatedPoints; }
+    const std::vector<std::pair<unsigned long, unsigned long> >& GetSelfIntersections() const { return _selfIntersections; }
+    //@}
+
+private:
+    float _fEpsilon;
+    int _checks;
+    std::vector<unsigned long> _flippedFacets;
+    std::vector<std::pair<unsigned long, unsigned long> > _nonManifoldEdges;
+    std::vector<unsigned long> _nonManifoldPoints;
+    std::vector<unsigned long> _invalidNeighbourIndices;
+    std::vector<unsigned long> _invalidPointIndices;
+    std::vector<unsigned long> _corruptedFacets;
+    std::vector<unsigned long> _invalidNeighbourhood;
+    std::vector<unsigned long> _degeneratedFacets;
+    std::vector<unsigned long> _duplicatedFacets;
+    std::vector<unsigned long> _duplicatedPoints;
+    std::vector<std::pair<unsigned long, unsigned long> > _selfIntersections;
+};
+
 } // namespace MeshCore
 
 #endif // MESH_EVALUATION_H
@@ -25,6 +25,7 @@
 #define MESH_FUNCTIONAL_H
 
 #include <algorithm>
+#include <vector>
 #include <QtConcurrentRun>
 #include <QFuture>
 #include <QThread>
@@ -58,6 +59,80 @@ namespace MeshCore
         }
     }
 
+    /**
+     * Appends all indices in the range [0, count) for which \a pred returns true to \a indices.
+     * The range is split into contiguous blocks which are checked by up to \a threads threads,
+     * so \a pred must be safe to call concurrently. The indices are appended in ascending order.
+     */
+    template <class Pred>
+    static void parallel_find_indices(unsigned long count, Pred pred, std::vector<unsigned long>& indices, int threads)
+    {
+        if (threads < 2 || count < 1000)
+        {
+            for (unsigned long i = 0; i < count; i++)
+            {
+                if (pred(i))
+                    indices.push_back(i);
+            }
+        }
+        else
+        {
+            unsigned long blocks = static_cast<unsigned long>(threads);
+            unsigned long size = (count + blocks - 1) / blocks;
+            std::vector<std::vector<unsigned long> > results(blocks);
+            std::vector<QFuture<void> > futures;
+            for (unsigned long i = 0; i < blocks; i++)
+            {
+                unsigned long begin = std::min<unsigned long>(i * size, count);
+                unsigned long end = std::min<unsigned long>(begin + size, count);
+                std::vector<unsigned long>* result = &results[i];
+                futures.push_back(QtConcurrent::run([begin, end, result, &pred]() {
+                    for (unsigned long j = begin; j < end; j++)
+                    {
+                        if (pred(j))
+                            result->push_back(j);
+                    }
+                }));
+            }
+
+            for (unsigned long i = 0; i < blocks; i++)
+            {
+                futures[i].waitForFinished();
+                indices.insert(indices.end(), results[i].begin(), results[i].end());
+            }
+        }
+    }
+
+    /**
+     * Calls \a func(begin, end) for contiguous blocks that cover the range [0, count).
+     * The blocks are processed by up to \a threads threads, so \a func must be safe to
+     * call concurrently for disjoint blocks.
+     */
+    template <class Func>
+    static void parallel_for(unsigned long count, Func func, int threads)
+    {
+        if (threads < 2 || count < 1000)
+        {
+            func(0UL, count);
+        }
+        else
+        {
+            unsigned long blocks = static_cast<unsigned long>(threads);
+            unsigned long size = (count + blocks - 1) / blocks;
+            std::vector<QFuture<void> > futures;
+            for (unsigned long begin = 0; begin < count; begin += size)
+            {
+                unsigned long end = std::min<unsigned long>(begin + size, count);
+                futures.push_back(QtConcurrent::run([begin, end, &func]() {
+                    func(begin, end);
+                }));
+            }
+
+            for (std::vector<QFuture<void> >::iterator it = futures.begin(); it != futures.end(); ++it)
+                it->waitForFinished();
+        }
+    }
+
 } // namespace MeshCore
 
 
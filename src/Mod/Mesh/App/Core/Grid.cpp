@@ -27,6 +27,10 @@
 # include <algorithm>
 #endif
 
+#include <QFuture>
+#include <QThread>
+#include <QtConcurrentRun>
+
 #include "Grid.h"
 #include "Iterator.h"
 
@@ -62,7 +66,9 @@ void MeshGrid::Attach (const MeshKernel &rclM)
 
 void MeshGrid::Clear (void)
 {
-  _aulGrid.clear();
+  _aulGridOffsets.clear();
+  _aulGridElements.clear();
+  _aclGridEntries.clear();
   _pclMesh = NULL;  
 }
 
@@ -93,8 +99,6 @@ void MeshGrid::InitGrid (void)
 {
   assert(_pclMesh != NULL);
 
-  unsigned long i, j;
-
   // Grid Laengen berechnen wenn nicht initialisiert
   //
   if ((_ulCtGridsX == 0) || (_ulCtGridsY == 0) || (_ulCtGridsZ == 0))
@@ -128,14 +132,36 @@ void MeshGrid::InitGrid (void)
   }
 
   // Daten-Struktur anlegen
-  _aulGrid.clear();
-  _aulGrid.resize(_ulCtGridsX);
-  for (i = 0; i < _ulCtGridsX; i++)
-  {
-    _aulGrid[i].resize(_ulCtGridsY);
-    for (j = 0; j < _ulCtGridsY; j++)
-      _aulGrid[i][j].resize(_ulCtGridsZ);
-  }
+  ClearElements();
+}
+
+void MeshGrid::ClearElements (void)
+{
+  _aulGridOffsets.assign(_ulCtGridsX * _ulCtGridsY * _ulCtGridsZ + 1, 0);
+  _aulGridElements.clear();
+  _aclGridEntries.clear();
+}
+
+void MeshGrid::FinishGrid (void)
+{
+  unsigned long ulCtGrids = _ulCtGridsX * _ulCtGridsY * _ulCtGridsZ;
+  _aulGridOffsets.assign(ulCtGrids + 1, 0);
+
+  // count the elements per grid
+  std::vector<GridEntry>::const_iterator it;
+  for (it = _aclGridEntries.begin(); it != _aclGridEntries.end(); ++it)
+    _aulGridOffsets[it->first + 1]++;
+  for (unsigned long i = 0; i < ulCtGrids; i++)
+    _aulGridOffsets[i + 1] += _aulGridOffsets[i];
+
+  // the sort is stable, so the elements of each grid keep their ascending order
+  std::vector<unsigned long> aulFill(_aulGridOffsets.begin(), _aulGridOffsets.end() - 1);
+  _aulGridElements.resize(_aclGridEntries.size());
+  for (it = _aclGridEntries.begin(); it != _aclGridEntries.end(); ++it)
+    _aulGridElements[aulFill[it->first]++] = it->second;
+
+  // release the memory of the temporary entries
+  std::vector<GridEntry>().swap(_aclGridEntries);
 }
 
 unsigned long MeshGrid::Inside (const Base::BoundBox3f &rclBB, std::vector<unsigned long> &raulElements,
@@ -155,7 +181,7 @@ unsigned long MeshGrid::Inside (const Base::BoundBox3f &rclBB, std::vector<unsig
     {
       for (k = ulMinZ; k <= ulMaxZ; k++)
       {
-        raulElements.insert(raulElements.end(), _aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+        raulElements.insert(raulElements.end(), GridBegin(i, j, k), GridEnd(i, j, k));
       }
     }
   }  
@@ -190,7 +216,7 @@ unsigned long MeshGrid::Inside (const Base::BoundBox3f &rclBB, std::vector<unsig
       for (k = ulMinZ; k <= ulMaxZ; k++)
       {
         if (Base::DistanceP2(GetBoundBox(i, j, k).GetCenter(), rclOrg) < fMinDistP2)
-          raulElements.insert(raulElements.end(), _aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+          raulElements.insert(raulElements.end(), GridBegin(i, j, k), GridEnd(i, j, k));
       }
     }
   }  
@@ -221,7 +247,7 @@ unsigned long MeshGrid::Inside (const Base::BoundBox3f &rclBB, std::set<unsigned
     {
       for (k = ulMinZ; k <= ulMaxZ; k++)
       {
-        raulElements.insert(_aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+        raulElements.insert(GridBegin(i, j, k), GridEnd(i, j, k));
       }
     }
   }  
@@ -450,6 +476,14 @@ void MeshGrid::CalculateGridLength (int iCtGridPerAxis)
 }
 
 void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<unsigned long> &raclInd) const
+{
+  std::vector<unsigned long> aulInd;
+  SearchNearestFromPoint(rclPt, aulInd);
+  raclInd.clear();
+  raclInd.insert(aulInd.begin(), aulInd.end());
+}
+
+void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::vector<unsigned long> &raclInd) const
 {
   raclInd.clear();
   Base::BoundBox3f  clBB = GetBoundBox();
@@ -478,7 +512,7 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<uns
           for (unsigned long i = 0; i < _ulCtGridsY; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsZ; j++)
-              raclInd.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+              raclInd.insert(raclInd.end(), GridBegin(nX, i, j), GridEnd(nX, i, j));
           }
           nX++;
         }
@@ -492,7 +526,7 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<uns
           for (unsigned long i = 0; i < _ulCtGridsY; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsZ; j++)
-              raclInd.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+              raclInd.insert(raclInd.end(), GridBegin(nX, i, j), GridEnd(nX, i, j));
           }
           nX++;
         }
@@ -506,7 +540,7 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<uns
           for (unsigned long i = 0; i < _ulCtGridsX; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsZ; j++)
-              raclInd.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+              raclInd.insert(raclInd.end(), GridBegin(i, nY, j), GridEnd(i, nY, j));
           }
           nY++;
         }
@@ -520,7 +554,7 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<uns
           for (unsigned long i = 0; i < _ulCtGridsX; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsZ; j++)
-              raclInd.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+              raclInd.insert(raclInd.end(), GridBegin(i, nY, j), GridEnd(i, nY, j));
           }
           nY--;
         }
@@ -534,7 +568,7 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<uns
           for (unsigned long i = 0; i < _ulCtGridsX; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsY; j++)
-              raclInd.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+              raclInd.insert(raclInd.end(), GridBegin(i, j, nZ), GridEnd(i, j, nZ));
           }
           nZ++;
         }
@@ -548,7 +582,7 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<uns
           for (unsigned long i = 0; i < _ulCtGridsX; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsY; j++)
-              raclInd.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+              raclInd.insert(raclInd.end(), GridBegin(i, j, nZ), GridEnd(i, j, nZ));
           }
           nZ--;
         }
@@ -559,10 +593,22 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<uns
         break;
     }
   }
+
+  // doppelte Nennungen entfernen
+  std::sort(raclInd.begin(), raclInd.end());
+  raclInd.erase(std::unique(raclInd.begin(), raclInd.end()), raclInd.end());
 }
 
 void MeshGrid::GetHull (unsigned long ulX, unsigned long ulY, unsigned long ulZ, 
                         unsigned long ulDistance, std::set<unsigned long> &raclInd) const
+{
+  std::vector<unsigned long> aulInd;
+  GetHull(ulX, ulY, ulZ, ulDistance, aulInd);
+  raclInd.insert(aulInd.begin(), aulInd.end());
+}
+
+void MeshGrid::GetHull (unsigned long ulX, unsigned long ulY, unsigned long ulZ, 
+                        unsigned long ulDistance, std::vector<unsigned long> &raclInd) const
 {
   int nX1 = std::max<int>(0, int(ulX) - int(ulDistance));
   int nY1 = std::max<int>(0, int(ulY) - int(ulDistance));
@@ -644,14 +690,19 @@ void MeshGrid::GetHull (unsigned long ulX, unsigned long ulY, unsigned long ulZ,
 unsigned long MeshGrid::GetElements (unsigned long ulX, unsigned long ulY, unsigned long ulZ,  
                                      std::set<unsigned long> &raclInd) const
 {
-  const std::set<unsigned long> &rclSet = _aulGrid[ulX][ulY][ulZ];
-  if (rclSet.size() > 0)
-  {
-    raclInd.insert(rclSet.begin(), rclSet.end());
-    return rclSet.size();
-  }
+  const unsigned long *pBegin = GridBegin(ulX, ulY, ulZ);
+  const unsigned long *pEnd = GridEnd(ulX, ulY, ulZ);
+  raclInd.insert(pBegin, pEnd);
+  return static_cast<unsigned long>(pEnd - pBegin);
+}
 
-  return 0;
+unsigned long MeshGrid::GetElements (unsigned long ulX, unsigned long ulY, unsigned long ulZ,  
+                                     std::vector<unsigned long> &raclInd) const
+{
+  const unsigned long *pBegin = GridBegin(ulX, ulY, ulZ);
+  const unsigned long *pEnd = GridEnd(ulX, ulY, ulZ);
+  raclInd.insert(raclInd.end(), pBegin, pEnd);
+  return static_cast<unsigned long>(pEnd - pBegin);
 }
 
 unsigned long MeshGrid::GetElements(const Base::Vector3f &rclPoint, std::vector<unsigned long>& aulFacets) const
@@ -660,9 +711,7 @@ unsigned long MeshGrid::GetElements(const Base::Vector3f &rclPoint, std::vector<
   if (!CheckPosition(rclPoint, ulX, ulY, ulZ))
     return 0;
 
-  aulFacets.resize(_aulGrid[ulX][ulY][ulZ].size());
-
-  std::copy(_aulGrid[ulX][ulY][ulZ].begin(), _aulGrid[ulX][ulY][ulZ].end(), aulFacets.begin());
+  aulFacets.assign(GridBegin(ulX, ulY, ulZ), GridEnd(ulX, ulY, ulZ));
   return aulFacets.size();
 }
 
@@ -767,15 +816,53 @@ void MeshFacetGrid::RebuildGrid (void)
   InitGrid();
  
   // Daten-Struktur fuellen
-  MeshFacetIterator clFIter(*_pclMesh);
+  unsigned long ulThreads = static_cast<unsigned long>(std::max<int>(QThread::idealThreadCount(), 1));
+  if (ulThreads < 2 || _ulCtElements < 10000)
+  {
+    MeshFacetIterator clFIter(*_pclMesh);
 
-  unsigned long i = 0;
-  for (clFIter.Init(); clFIter.More(); clFIter.Next())
+    unsigned long i = 0;
+    for (clFIter.Init(); clFIter.More(); clFIter.Next())
+    {
+      AddFacet(*clFIter, i++);
+    }
+  }
+  else
   {
-//    AddFacet(*clFIter, i++, 2.0f);
-    AddFacet(*clFIter, i++);
+    // each thread collects the entries of a contiguous block of facets, appending the blocks
+    // in order keeps the element indices of each grid sorted
+    std::vector<std::vector<GridEntry> > aclBlocks(ulThreads);
+    std::vector<QFuture<void> > aclFutures;
+    unsigned long ulBlockSize = (_ulCtElements + ulThreads - 1) / ulThreads;
+    for (unsigned long i = 0; i < ulThreads; i++)
+    {
+      unsigned long ulBegin = std::min<unsigned long>(i * ulBlockSize, _ulCtElements);
+      unsigned long ulEnd = std::min<unsigned long>(ulBegin + ulBlockSize, _ulCtElements);
+      aclFutures.push_back(QtConcurrent::run(this, &MeshFacetGrid::CollectFacets, ulBegin, ulEnd, &aclBlocks[i]));
+    }
+
+    std::size_t ulCtEntries = 0;
+    for (unsigned long i = 0; i < ulThreads; i++)
+    {
+      aclFutures[i].waitForFinished();
+      ulCtEntries += aclBlocks[i].size();
+    }
+
+    _aclGridEntries.reserve(ulCtEntries);
+    for (unsigned long i = 0; i < ulThreads; i++)
+    {
+      _aclGridEntries.insert(_aclGridEntries.end(), aclBlocks[i].begin(), aclBlocks[i].end());
+      std::vector<GridEntry>().swap(aclBlocks[i]);
+    }
   }
 
+  FinishGrid();
+}
+
+void MeshFacetGrid::CollectFacets (unsigned long ulBegin, unsigned long ulEnd, std::vector<GridEntry> *paclEntries) const
+{
+  for (unsigned long i = ulBegin; i < ulEnd; i++)
+    CollectFacet(_pclMesh->GetFacet(i), i, *paclEntries);
 }
 
 unsigned long MeshFacetGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt) const
@@ -1006,8 +1093,8 @@ void MeshFacetGrid::SearchNearestFacetInGrid(unsigned long ulX, unsigned long ul
                                              const Base::Vector3f &rclPt, float &rfMinDist,
                                              unsigned long &rulFacetInd) const
 {
-  const std::set<unsigned long> &rclSet = _aulGrid[ulX][ulY][ulZ];
-  for (std::set<unsigned long>::const_iterator pI = rclSet.begin(); pI != rclSet.end(); ++pI)
+  const unsigned long *pEnd = GridEnd(ulX, ulY, ulZ);
+  for (const unsigned long *pI = GridBegin(ulX, ulY, ulZ); pI != pEnd; ++pI)
   {
     float fDist = _pclMesh->GetFacet(*pI).DistanceToPoint(rclPt);
     if (fDist < rfMinDist)
@@ -1058,7 +1145,7 @@ void MeshPointGrid::AddPoint (const MeshPoint &rclPt, unsigned long ulPtIndex, f
   unsigned long ulX, ulY, ulZ;
   Pos(Base::Vector3f(rclPt.x, rclPt.y, rclPt.z), ulX, ulY, ulZ);
   if ( (ulX < _ulCtGridsX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ) )
-    _aulGrid[ulX][ulY][ulZ].insert(ulPtIndex);
+    AddElement(ulX, ulY, ulZ, ulPtIndex);
 }
 
 void MeshPointGrid::Validate (const MeshKernel &rclMesh)
@@ -1117,6 +1204,8 @@ void MeshPointGrid::RebuildGrid (void)
   {
     AddPoint(*cPIter, i++);
   }
+
+  FinishGrid();
 }
 
 void MeshPointGrid::Pos (const Base::Vector3f &rclPoint, unsigned long &rulX, unsigned long &rulY, unsigned long &rulZ) const
@@ -1178,7 +1267,7 @@ bool MeshGridIterator::InitOnRay (const Base::Vector3f &rclPt, const Base::Vecto
   if ((_rclGrid.GetBoundBox().IsInBox(rclPt)) == true)
   {  // Voxel bestimmen, indem der Startpunkt liegt
     _rclGrid.Position(rclPt, _ulX, _ulY, _ulZ);
-    raulElements.insert(raulElements.end(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+    raulElements.insert(raulElements.end(), _rclGrid.GridBegin(_ulX, _ulY, _ulZ), _rclGrid.GridEnd(_ulX, _ulY, _ulZ));
     _bValidRay = true;
   }
   else
@@ -1191,7 +1280,7 @@ bool MeshGridIterator::InitOnRay (const Base::Vector3f &rclPt, const Base::Vecto
       else
         _rclGrid.Position(cP1, _ulX, _ulY, _ulZ);
 
-      raulElements.insert(raulElements.end(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+      raulElements.insert(raulElements.end(), _rclGrid.GridBegin(_ulX, _ulY, _ulZ), _rclGrid.GridEnd(_ulX, _ulY, _ulZ));
       _bValidRay = true;
     }
   }
@@ -1242,7 +1331,7 @@ bool MeshGridIterator::NextOnRay (std::vector<unsigned long> &raulElements)
   if ((_bValidRay == true) && (_rclGrid.CheckPos(_ulX, _ulY, _ulZ) == true))
   {
     GridElement pos(_ulX, _ulY, _ulZ); _cSearchPositions.insert(pos);
-    raulElements.insert(raulElements.end(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end()); 
+    raulElements.insert(raulElements.end(), _rclGrid.GridBegin(_ulX, _ulY, _ulZ), _rclGrid.GridEnd(_ulX, _ulY, _ulZ)); 
   }
   else
     _bValidRay = false;  // Strahl ausgetreten
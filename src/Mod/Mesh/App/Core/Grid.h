@@ -25,6 +25,8 @@
 #define MESH_GRID_H
 
 #include <set>
+#include <utility>
+#include <vector>
 
 #include "MeshKernel.h"
 #include <Base/Vector3D.h>
@@ -51,6 +53,12 @@ class MeshGrid;
  *
  * Grids can be used within algorithms to avoid to iterate through all elements,
  * so grids can speed up algorithms dramatically.
+ *
+ * The element indices of all grids are kept in one contiguous array in
+ * compressed sparse row layout: for the grid with number n (see GetIndexToPosition())
+ * the elements are stored in the range [_aulGridOffsets[n], _aulGridOffsets[n+1])
+ * of _aulGridElements, sorted in ascending order. Sub-classes fill the grid
+ * with AddElement() and call FinishGrid() afterwards.
  */
 class MeshExport MeshGrid
 {
@@ -89,12 +97,17 @@ public:
                                 const Base::Vector3f &rclOrg, float fMaxDist, bool bDelDoubles = true) const;
   /** Searches for the nearest grids that contain elements from a point, the result are grid indices. */
   void SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<unsigned long> &rclInd) const;
+  /** Does the same as the method above but writes the sorted element indices into the vector \a raclInd
+   * which can be re-used over several calls without allocating tree nodes. */
+  void SearchNearestFromPoint (const Base::Vector3f &rclPt, std::vector<unsigned long> &raclInd) const;
   //@}
 
   /** @name Getters */
   //@{
   /** Returns the indices of the elements in the given grid. */
   unsigned long GetElements (unsigned long ulX, unsigned long ulY, unsigned long ulZ,  std::set<unsigned long> &raclInd) const;
+  /** Appends the indices of the elements in the given grid to \a raclInd and returns the number of appended elements. */
+  unsigned long GetElements (unsigned long ulX, unsigned long ulY, unsigned long ulZ,  std::vector<unsigned long> &raclInd) const;
   unsigned long GetElements (const Base::Vector3f &rclPoint, std::vector<unsigned long>& aulFacets) const;
   //@}
 
@@ -125,7 +138,10 @@ public:
   bool GetPositionToIndex(unsigned long id, unsigned long& ulX, unsigned long& ulY, unsigned long& ulZ) const;
   /** Returns the number of elements in a given grid. */
   unsigned long GetCtElements(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
-  { return static_cast<unsigned long>(_aulGrid[ulX][ulY][ulZ].size()); }
+  {
+    unsigned long ulGrid = GridNumber(ulX, ulY, ulZ);
+    return _aulGridOffsets[ulGrid+1] - _aulGridOffsets[ulGrid];
+  }
   /** Validates the grid structure and rebuilds it if needed. Must be implemented in sub-classes. */
   virtual void Validate (const MeshKernel &rclM) = 0;
   /** Verifies the grid structure and returns false if inconsistencies are found. */
@@ -141,10 +157,21 @@ public:
   inline bool CheckPos (unsigned long ulX, unsigned long ulY, unsigned long ulZ) const;
   /** Get the indices of all elements lying in the grids around a given grid with distance \a ulDistance. */
   void GetHull (unsigned long ulX, unsigned long ulY, unsigned long ulZ, unsigned long ulDistance, std::set<unsigned long> &raclInd) const;
+  /** Appends the indices of all elements lying in the grids around a given grid with distance \a ulDistance.
+   * An element that lies in several of these grids is appended several times. */
+  void GetHull (unsigned long ulX, unsigned long ulY, unsigned long ulZ, unsigned long ulDistance, std::vector<unsigned long> &raclInd) const;
 
 protected:
   /** Initializes the size of the internal structure. */
   virtual void InitGrid (void);
+  /** Removes all elements and sets up an empty offset table for the current number of grids. */
+  void ClearElements (void);
+  /** Registers the element \a ulIndex for the given grid. The element becomes visible not before FinishGrid()
+   * is called. Elements must be registered with ascending indices to keep the grids sorted. */
+  void AddElement (unsigned long ulX, unsigned long ulY, unsigned long ulZ, unsigned long ulIndex)
+  { _aclGridEntries.push_back(GridEntry(GridNumber(ulX, ulY, ulZ), ulIndex)); }
+  /** Builds the compressed grid structure out of all registered elements by a counting sort. */
+  void FinishGrid (void);
   /** Deletes the grid structure. */
   virtual void Clear (void);
   /** Calculates the grid length dependent on maximum number of grids. */
@@ -155,9 +182,22 @@ protected:
   virtual void RebuildGrid (void) = 0;
   /** Returns the number of stored elements. Must be implemented in sub-classes. */
   virtual unsigned long HasElements (void) const = 0;
+  /** Returns the number of the given grid without any range checks. */
+  unsigned long GridNumber (unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+  { return (ulZ * _ulCtGridsY + ulY) * _ulCtGridsX + ulX; }
+  /** Returns a pointer to the first element of the given grid. */
+  const unsigned long* GridBegin (unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+  { return _aulGridElements.data() + _aulGridOffsets[GridNumber(ulX, ulY, ulZ)]; }
+  /** Returns a pointer past the last element of the given grid. */
+  const unsigned long* GridEnd (unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+  { return _aulGridElements.data() + _aulGridOffsets[GridNumber(ulX, ulY, ulZ)+1]; }
 
 protected:
-  std::vector<std::vector<std::vector<std::set<unsigned long> > > >  _aulGrid;   /**< Grid data structure. */
+  /** Pair of grid number and element index collected while building the grid. */
+  typedef std::pair<unsigned long, unsigned long> GridEntry;
+  std::vector<unsigned long> _aulGridOffsets;  /**< Offsets into _aulGridElements, one per grid plus one. */
+  std::vector<unsigned long> _aulGridElements; /**< Element indices of all grids. */
+  std::vector<GridEntry>     _aclGridEntries;  /**< Elements registered but not yet sorted into the grids. */
   const MeshKernel* _pclMesh;     /**< The mesh kernel. */
   unsigned long     _ulCtElements;/**< Number of grid elements for validation issues. */
   unsigned long     _ulCtGridsX;  /**< Number of grid elements in z. */
@@ -228,6 +268,10 @@ protected:
    * the corresponding index in the mesh kernel. The facet is added to each grid element that intersects 
    * the facet. */
   inline void AddFacet (const MeshGeomFacet &rclFacet, unsigned long ulFacetIndex, float fEpsilon = 0.0f);
+  /** Collects the grid entries for \a rclFacet into \a raclEntries without modifying the grid. */
+  inline void CollectFacet (const MeshGeomFacet &rclFacet, unsigned long ulFacetIndex, std::vector<GridEntry> &raclEntries) const;
+  /** Collects the grid entries of the facets in the range [ulBegin, ulEnd). Used to build the grid in parallel. */
+  void CollectFacets (unsigned long ulBegin, unsigned long ulEnd, std::vector<GridEntry> *paclEntries) const;
   /** Returns the number of stored elements. */
   unsigned long HasElements (void) const
   { return _pclMesh->CountFacets(); }
@@ -295,7 +339,7 @@ public:
   /** Returns indices of the elements in the current grid. */
   void GetElements (std::vector<unsigned long> &raulElements) const
   {
-    raulElements.insert(raulElements.end(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+    raulElements.insert(raulElements.end(), _rclGrid.GridBegin(_ulX, _ulY, _ulZ), _rclGrid.GridEnd(_ulX, _ulY, _ulZ));
   }
   /** Returns the number of elements in the current grid. */
   unsigned long GetCtElements() const
@@ -436,36 +480,12 @@ inline void MeshFacetGrid::PosWithCheck (const Base::Vector3f &rclPoint, unsigne
 
 inline void MeshFacetGrid::AddFacet (const MeshGeomFacet &rclFacet, unsigned long ulFacetIndex, float /*fEpsilon*/)
 {
-#if 0
-  unsigned long  i, ulX, ulY, ulZ, ulX1, ulY1, ulZ1, ulX2, ulY2, ulZ2;
-  
-  ulX1 = ulY1 = ulZ1 = ULONG_MAX;
-  ulX2 = ulY2 = ulZ2 = 0;
+  CollectFacet(rclFacet, ulFacetIndex, _aclGridEntries);
+}
 
-  for (i = 0; i < 3; i++)
-  {
-    Pos(rclFacet._aclPoints[i], ulX, ulY, ulZ);
-    _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
-    ulX1 = RSmin<unsigned long>(ulX1, ulX); ulY1 = RSmin<unsigned long>(ulY1, ulY); ulZ1 = RSmin<unsigned long>(ulZ1, ulZ);
-    ulX2 = RSmax<unsigned long>(ulX2, ulX); ulY2 = RSmax<unsigned long>(ulY2, ulY); ulZ2 = RSmax<unsigned long>(ulZ2, ulZ);
-  }
-  
-  // falls Facet ueber mehrere BB reicht
-  if ((ulX1 < ulX2) || (ulY1 < ulY2) || (ulZ1 < ulZ2))
-  {
-    for (ulX = ulX1; ulX <= ulX2; ulX++)
-    {
-      for (ulY = ulY1; ulY <= ulY2; ulY++)
-      {
-        for (ulZ = ulZ1; ulZ <= ulZ2; ulZ++)
-        {
-          if (CMeshFacetFunc::BBoxContainFacet(GetBoundBox(ulX, ulY, ulZ), rclFacet) == true)
-            _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
-        }
-      }
-    }
-  }
-#else
+inline void MeshFacetGrid::CollectFacet (const MeshGeomFacet &rclFacet, unsigned long ulFacetIndex,
+                                         std::vector<GridEntry> &raclEntries) const
+{
   unsigned long ulX, ulY, ulZ;
 
   unsigned long ulX1, ulY1, ulZ1, ulX2, ulY2, ulZ2;
@@ -503,15 +523,13 @@ inline void MeshFacetGrid::AddFacet (const MeshGeomFacet &rclFacet, unsigned lon
         for (ulZ = ulZ1; ulZ <= ulZ2; ulZ++)
         {
           if ( rclFacet.IntersectBoundingBox( GetBoundBox(ulX, ulY, ulZ) ) )
-            _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
+            raclEntries.push_back(GridEntry(GridNumber(ulX, ulY, ulZ), ulFacetIndex));
         }
       }
     }
   }
   else
-    _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
-
-#endif
+    raclEntries.push_back(GridEntry(GridNumber(ulX1, ulY1, ulZ1), ulFacetIndex));
 }
 
 } // namespace MeshCore
@@ -41,8 +41,10 @@
 #include <Base/Placement.h>
 #include <Base/Tools.h>
 #include <zipios++/gzipoutputstream.h>
+#include <QFile>
 
 #include <cmath>
+#include <cstring>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
@@ -80,6 +82,15 @@ char *ltrim (char *psz)
     return psz;
 }
 
+/* Checks if the zero-terminated bytes after the header of an STL file contain
+ * keywords of the ASCII format. */
+static bool hasAsciiSTLKeywords(char* szBuf)
+{
+    upper(szBuf);
+    return (strstr(szBuf, "SOLID") != NULL)  || (strstr(szBuf, "FACET") != NULL)    || (strstr(szBuf, "NORMAL") != NULL) ||
+           (strstr(szBuf, "VERTEX") != NULL) || (strstr(szBuf, "ENDFACET") != NULL) || (strstr(szBuf, "ENDLOOP") != NULL);
+}
+
 std::string& upper(std::string& str)
 {
     for (std::string::iterator it = str.begin(); it != str.end(); ++it)
@@ -160,6 +171,44 @@ bool MeshInput::LoadAny(const char* FileName)
     if (!fi.isReadable())
         throw Base::FileException("No permission on the file",FileName);
 
+    if (fi.hasExtension("stl") || fi.hasExtension("ast")) {
+        // The file is opened only once: binary files are mapped into memory so
+        // that the facets are welded directly from the records, other files are
+        // read through the same handle
+        QFile file(QString::fromUtf8(fi.filePath().c_str()));
+        if (!file.open(QIODevice::ReadOnly))
+            throw Base::FileException("Cannot open file",FileName);
+
+        qint64 size = file.size();
+        const uchar* data = 0;
+        if (size >= 134)
+            data = file.map(0, size);
+
+        if (data) {
+            // same check as in LoadSTL()
+            char szBuf[101];
+            uint32_t ulCt;
+            std::memcpy(&ulCt, data + 80, sizeof(ulCt));
+            std::size_t ulBytes = ulCt > 1 && size >= 184 ? 100 : 50;
+            std::memcpy(szBuf, data + 84, ulBytes);
+            szBuf[ulBytes] = 0;
+
+            if (!hasAsciiSTLKeywords(szBuf)) {
+                try {
+                    return LoadBinarySTL(reinterpret_cast<const char*>(data), static_cast<std::size_t>(size));
+                }
+                catch (...) {
+                    _rclMesh.Clear();
+                    throw;
+                }
+            }
+        }
+
+        Base::IODeviceIStreambuf buf(&file);
+        std::istream str(&buf);
+        return LoadSTL(str);
+    }
+
     Base::ifstream str(fi, std::ios::in | std::ios::binary);
 
     if (fi.hasExtension("bms")) {
@@ -169,10 +218,7 @@ bool MeshInput::LoadAny(const char* FileName)
     else {
         // read file
         bool ok = false;
-        if (fi.hasExtension("stl") || fi.hasExtension("ast")) {
-            ok = LoadSTL(str);
-        }
-        else if (fi.hasExtension("iv")) {
+        if (fi.hasExtension("iv")) {
             ok = LoadInventor( str );
             if (ok && _rclMesh.CountFacets() == 0)
                 Base::Console().Warning("No usable mesh found in file '%s'", FileName);
@@ -255,11 +301,9 @@ bool MeshInput::LoadSTL (std::istream &rstrIn)
     if (!rstrIn.read(szBuf, ulBytes))
         return (ulCt==0);
     szBuf[ulBytes] = 0;
-    upper(szBuf);
 
     try {
-        if ((strstr(szBuf, "SOLID") == NULL)  && (strstr(szBuf, "FACET") == NULL)    && (strstr(szBuf, "NORMAL") == NULL) &&
-            (strstr(szBuf, "VERTEX") == NULL) && (strstr(szBuf, "ENDFACET") == NULL) && (strstr(szBuf, "ENDLOOP") == NULL)) {
+        if (!hasAsciiSTLKeywords(szBuf)) {
             // probably binary STL
             buf->pubseekoff(0, std::ios::beg, std::ios::in);
             return LoadBinarySTL(rstrIn);
@@ -1037,6 +1081,23 @@ bool MeshInput::LoadPLY (std::istream &inp)
         }
     }
 
+    // The values of a vertex are stored in the order of its properties, so
+    // look up the positions of the coordinates and colors once
+    auto indexOf = [&vertex_props](const char* name) {
+        for (std::size_t i = 0; i < vertex_props.size(); i++) {
+            if (vertex_props[i].first == name)
+                return i;
+        }
+        return vertex_props.size();
+    };
+    std::size_t idx_x = indexOf("x");
+    std::size_t idx_y = indexOf("y");
+    std::size_t idx_z = indexOf("z");
+    std::size_t idx_r = indexOf("red");
+    std::size_t idx_g = indexOf("green");
+    std::size_t idx_b = indexOf("blue");
+    std::vector<float> prop_values(vertex_props.size());
+
     if (format == ascii) {
         boost::regex rx_d("(([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?))\\s*");
         boost::regex rx_s("\\b([-+]?[0-9]+)\\s*");
@@ -1046,9 +1107,8 @@ bool MeshInput::LoadPLY (std::istream &inp)
 
         for (std::size_t i = 0; i < v_count && std::getline(inp, line); i++) {
             // go through the vertex properties
-            std::map<std::string, float> prop_values;
-            for (std::vector<std::pair<std::string, Number> >::iterator it = vertex_props.begin(); it != vertex_props.end(); ++it) {
-                switch (it->second) {
+            for (std::size_t j = 0; j < vertex_props.size(); j++) {
+                switch (vertex_props[j].second) {
                 case int8:
                 case int16:
                 case int32:
@@ -1056,7 +1116,7 @@ bool MeshInput::LoadPLY (std::istream &inp)
                         if (boost::regex_search(line, what, rx_s)) {
                             int v;
                             v = boost::lexical_cast<int>(what[1]);
-                            prop_values[it->first] = static_cast<float>(v);
+                            prop_values[j] = static_cast<float>(v);
                             line = line.substr(what[0].length());
                         }
                         else {
@@ -1070,7 +1130,7 @@ bool MeshInput::LoadPLY (std::istream &inp)
                         if (boost::regex_search(line, what, rx_u)) {
                             int v;
                             v = boost::lexical_cast<int>(what[1]);
-                            prop_values[it->first] = static_cast<float>(v);
+                            prop_values[j] = static_cast<float>(v);
                             line = line.substr(what[0].length());
                         }
                         else {
@@ -1083,7 +1143,7 @@ bool MeshInput::LoadPLY (std::istream &inp)
                         if (boost::regex_search(line, what, rx_d)) {
                             double v;
                             v = boost::lexical_cast<double>(what[1]);
-                            prop_values[it->first] = static_cast<float>(v);
+                            prop_values[j] = static_cast<float>(v);
                             line = line.substr(what[0].length());
                         }
                         else {
@@ -1096,15 +1156,15 @@ bool MeshInput::LoadPLY (std::istream &inp)
             }
 
             Base::Vector3f pt;
-            pt.x = (prop_values["x"]);
-            pt.y = (prop_values["y"]);
-            pt.z = (prop_values["z"]);
+            pt.x = prop_values[idx_x];
+            pt.y = prop_values[idx_y];
+            pt.z = prop_values[idx_z];
             meshPoints.push_back(pt);
 
             if (_material && (rgb_value == MeshIO::PER_VERTEX)) {
-                float r = (prop_values["red"]) / 255.0f;
-                float g = (prop_values["green"]) / 255.0f;
-                float b = (prop_values["blue"]) / 255.0f;
+                float r = prop_values[idx_r] / 255.0f;
+                float g = prop_values[idx_g] / 255.0f;
+                float b = prop_values[idx_b] / 255.0f;
                 _material->diffuseColor.emplace_back(r, g, b);
             }
         }
@@ -1129,48 +1189,47 @@ bool MeshInput::LoadPLY (std::istream &inp)
 
         for (std::size_t i = 0; i < v_count; i++) {
             // go through the vertex properties
-            std::map<std::string, float> prop_values;
-            for (std::vector<std::pair<std::string, Number> >::iterator it = vertex_props.begin(); it != vertex_props.end(); ++it) {
-                switch (it->second) {
+            for (std::size_t j = 0; j < vertex_props.size(); j++) {
+                switch (vertex_props[j].second) {
                 case int8:
                     {
                         int8_t v; is >> v;
-                        prop_values[it->first] = static_cast<float>(v);
+                        prop_values[j] = static_cast<float>(v);
                     } break;
                 case uint8:
                     {
                         uint8_t v; is >> v;
-                        prop_values[it->first] = static_cast<float>(v);
+                        prop_values[j] = static_cast<float>(v);
                     } break;
                 case int16:
                     {
                         int16_t v; is >> v;
-                        prop_values[it->first] = static_cast<float>(v);
+                        prop_values[j] = static_cast<float>(v);
                     } break;
                 case uint16:
                     {
                         uint16_t v; is >> v;
-                        prop_values[it->first] = static_cast<float>(v);
+                        prop_values[j] = static_cast<float>(v);
                     } break;
                 case int32:
                     {
                         int32_t v; is >> v;
-                        prop_values[it->first] = static_cast<float>(v);
+                        prop_values[j] = static_cast<float>(v);
                     } break;
                 case uint32:
                     {
                         uint32_t v; is >> v;
-                        prop_values[it->first] = static_cast<float>(v);
+                        prop_values[j] = static_cast<float>(v);
                     } break;
                 case float32:
                     {
                         float v; is >> v;
-                        prop_values[it->first] = v;
+                        prop_values[j] = v;
                     } break;
                 case float64:
                     {
                         double v; is >> v;
-                        prop_values[it->first] = static_cast<float>(v);
+                        prop_values[j] = static_cast<float>(v);
                     } break;
                 default:
                     return false;
@@ -1178,15 +1237,15 @@ bool MeshInput::LoadPLY (std::istream &inp)
             }
 
             Base::Vector3f pt;
-            pt.x = (prop_values["x"]);
-            pt.y = (prop_values["y"]);
-            pt.z = (prop_values["z"]);
+            pt.x = prop_values[idx_x];
+            pt.y = prop_values[idx_y];
+            pt.z = prop_values[idx_z];
             meshPoints.push_back(pt);
 
             if (_material && (rgb_value == MeshIO::PER_VERTEX)) {
-                float r = (prop_values["red"]) / 255.0f;
-                float g = (prop_values["green"]) / 255.0f;
-                float b = (prop_values["blue"]) / 255.0f;
+                float r = prop_values[idx_r] / 255.0f;
+                float g = prop_values[idx_g] / 255.0f;
+                float b = prop_values[idx_b] / 255.0f;
                 _material->diffuseColor.emplace_back(r, g, b);
             }
         }
@@ -1448,6 +1507,26 @@ bool MeshInput::LoadBinarySTL (std::istream &rstrIn)
     return true;
 }
 
+bool MeshInput::LoadBinarySTL (const char* data, std::size_t size)
+{
+    // 80 bytes header and the number of facets
+    if (size < 84)
+        return false;
+
+    uint32_t ulCt = 0;
+    std::memcpy(&ulCt, data + 80, sizeof(ulCt));
+
+    // compare with the number of facets the file can hold
+    if (ulCt > (size - 84) / 50)
+        return false;// not a valid STL file
+
+    // each record holds the normal, the three points and 2 bytes attribute
+    MeshFastBuilder builder(this->_rclMesh);
+    builder.Build(data + 84 + sizeof(Base::Vector3f), ulCt, 50);
+
+    return true;
+}
+
 /** Loads the mesh object from an XML file. */
 void MeshInput::LoadXML (Base::XMLReader &reader)
 {
@@ -111,6 +111,8 @@ public:
     bool LoadAsciiSTL (std::istream &rstrIn);
     /** Loads a binary STL file. */
     bool LoadBinarySTL (std::istream &rstrIn);
+    /** Loads a binary STL file from a memory block of \a size bytes, e.g. a memory mapped file. */
+    bool LoadBinarySTL (const char* data, std::size_t size);
     /** Loads an OBJ Mesh file. */
     bool LoadOBJ (std::istream &rstrIn);
     /** Loads the materials of an OBJ file. */
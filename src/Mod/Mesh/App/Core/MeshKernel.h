@@ -427,7 +427,10 @@ public:
     //@}
 
 protected:
-    /** Rebuilds the neighbour indices for subset of all facets from index \a index on. */
+    /** Rebuilds the neighbour indices for subset of all facets from index \a index on.
+     * Facets in front of \a index are connected to them if they share an edge, the
+     * neighbourhood among these facets is kept.
+     */
     void RebuildNeighbours (unsigned long);
     /** Checks if this point is associated to no other facet and deletes if so.
      * The point indices of the facets get adjusted.
@@ -32,6 +32,7 @@
 #include "Iterator.h"
 #include "Algorithm.h"
 #include "Grid.h"
+#include "BVH.h"
 
 #include <Base/Exception.h>
 #include <Base/Console.h>
@@ -144,12 +145,6 @@ bool MeshProjection::projectLineOnMesh(const MeshFacetGrid& grid,
                                        const Base::Vector3f& vd,
                                        std::vector<Base::Vector3f>& polyline)
 {
-    Base::Vector3f dir(v2 - v1);
-    Base::Vector3f base(v1), normal(vd % dir);
-    normal.Normalize();
-    dir.Normalize();
-
-
     std::vector<unsigned long> facets;
 
     // special case: start and endpoint inside same facet
@@ -170,10 +165,63 @@ bool MeshProjection::projectLineOnMesh(const MeshFacetGrid& grid,
     std::sort(facets.begin(), facets.end());
     facets.erase(std::unique(facets.begin(), facets.end()), facets.end());
 
+    return projectLineOnFacets(facets, v1, f1, v2, f2, vd, polyline);
+}
+
+bool MeshProjection::projectLineOnMesh(const MeshFacetBVH& tree,
+                                       const Base::Vector3f& v1, unsigned long f1,
+                                       const Base::Vector3f& v2, unsigned long f2,
+                                       const Base::Vector3f& vd,
+                                       std::vector<Base::Vector3f>& polyline)
+{
+    // special case: start and endpoint inside same facet
+    if (f1 == f2) {
+        polyline.push_back(v1);
+        polyline.push_back(v2);
+        return true;
+    }
+
+    Base::Vector3f dir(v2 - v1);
+    Base::Vector3f base(v1), normal(vd % dir);
+    normal.Normalize();
+    float len = dir.Length();
+    dir.Normalize();
+
+    // The sub-trees must be cut by the plane and reach into the slab between the two
+    // end points. Unlike bboxInsideRectangle() this test holds for all enclosing boxes.
+    std::vector<unsigned long> facets;
+    tree.Collect([&](const Base::BoundBox3f& box) {
+        if (!box.IsCutPlane(base, normal))
+            return false;
+        Base::Vector3f cnt(box.GetCenter());
+        float radius = 0.5f * (fabs(dir.x) * box.LengthX() +
+                               fabs(dir.y) * box.LengthY() +
+                               fabs(dir.z) * box.LengthZ());
+        float pos = (cnt - v1) * dir;
+        return (pos + radius >= 0.0f) && (pos - radius <= len);
+    }, facets);
+
+    // same order as with the grid
+    std::sort(facets.begin(), facets.end());
+
+    return projectLineOnFacets(facets, v1, f1, v2, f2, vd, polyline);
+}
+
+bool MeshProjection::projectLineOnFacets(const std::vector<unsigned long>& facets,
+                                         const Base::Vector3f& v1, unsigned long f1,
+                                         const Base::Vector3f& v2, unsigned long f2,
+                                         const Base::Vector3f& vd,
+                                         std::vector<Base::Vector3f>& polyline) const
+{
+    Base::Vector3f dir(v2 - v1);
+    Base::Vector3f base(v1), normal(vd % dir);
+    normal.Normalize();
+    dir.Normalize();
+
     // cut all facets with plane
     std::list< std::pair<Base::Vector3f, Base::Vector3f> > cutLine;
     //unsigned long start = 0, end = 0;
-    for (std::vector<unsigned long>::iterator it = facets.begin(); it != facets.end(); ++it) {
+    for (std::vector<unsigned long>::const_iterator it = facets.begin(); it != facets.end(); ++it) {
         Base::Vector3f e1, e2;
         MeshGeomFacet tria = kernel.GetFacet(*it);
         if (bboxInsideRectangle(tria.GetBoundBox(), v1, v2, vd)) {
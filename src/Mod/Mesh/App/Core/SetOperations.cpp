@@ -194,10 +194,10 @@ void SetOperations::Cut (std::set<unsigned long>& facetsCuttingEdge0, std::set<u
       
           if (vecFacets2.size() > 0)
           {
-            std::set<unsigned long> vecFacets1;
+            std::vector<unsigned long> vecFacets1;
             grid1.GetElements(gx1, gy1, gz1, vecFacets1);
             
-            std::set<unsigned long>::iterator it1;
+            std::vector<unsigned long>::iterator it1;
             for (it1 = vecFacets1.begin(); it1 != vecFacets1.end(); ++it1)
             {
               unsigned long fidx1 = *it1;
@@ -1467,8 +1467,10 @@ void MeshTopoAlgorithm::FillupHoles(int level, AbstractPolygonTriangulator& cTri
             if (it->_aulPoints[0] >= ctPoints || 
                 it->_aulPoints[1] >= ctPoints || 
                 it->_aulPoints[2] >= ctPoints) {
-                Base::Console().Log("Ignore invalid face <%d, %d, %d> (%d vertices)\n", 
-                    it->_aulPoints[0], it->_aulPoints[1], it->_aulPoints[2], ctPoints);
+                Base::Console().Log("Ignore invalid face <%lu, %lu, %lu> (%lu vertices)\n",
+                    static_cast<unsigned long>(it->_aulPoints[0]),
+                    static_cast<unsigned long>(it->_aulPoints[1]),
+                    static_cast<unsigned long>(it->_aulPoints[2]), ctPoints);
             }
             else {
                 addFacets.push_back(*it);
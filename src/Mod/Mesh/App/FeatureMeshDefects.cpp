@@ -29,6 +29,7 @@
 
 #include "FeatureMeshDefects.h"
 #include "Core/Degeneration.h"
+#include "Core/Evaluation.h"
 #include "Core/TopoAlgorithm.h"
 #include "Core/Triangulation.h"
 #include <Base/Tools.h>
@@ -351,3 +352,60 @@ App::DocumentObjectExecReturn *RemoveComponents::execute(void)
 
     return App::DocumentObject::StdReturn;
 }
+
+// ----------------------------------------------------------------------
+
+PROPERTY_SOURCE(Mesh::FixAllDefects, Mesh::FixDefects)
+
+FixAllDefects::FixAllDefects()
+{
+}
+
+FixAllDefects::~FixAllDefects()
+{
+}
+
+App::DocumentObjectExecReturn *FixAllDefects::execute(void)
+{
+    App::DocumentObject* link = Source.getValue();
+    if (!link) return new App::DocumentObjectExecReturn("No mesh linked");
+    App::Property* prop = link->getPropertyByName("Mesh");
+    if (prop && prop->getTypeId() == Mesh::PropertyMeshKernel::getClassTypeId()) {
+        Mesh::PropertyMeshKernel* kernel = static_cast<Mesh::PropertyMeshKernel*>(prop);
+        std::unique_ptr<MeshObject> mesh(new MeshObject);
+        *mesh = kernel->getValue();
+        float epsilon = static_cast<float>(Epsilon.getValue());
+
+        MeshCore::MeshEvalDefects eval(mesh->getKernel(), epsilon);
+        eval.Evaluate();
+
+        // most checks are skipped for invalid indices, so analyze the mesh again after fixing them
+        if (!eval.GetInvalidPointIndices().empty() ||
+            !eval.GetInvalidNeighbourIndices().empty() ||
+            !eval.GetCorruptedFacets().empty() ||
+            !eval.GetInvalidNeighbourhood().empty()) {
+            mesh->validateIndices();
+            eval.Evaluate();
+        }
+
+        // the repair functions search for the defects themselves because
+        // the indices change with every repair step
+        if (!eval.GetSelfIntersections().empty())
+            mesh->removeSelfIntersections();
+        if (!eval.GetFlippedFacets().empty())
+            mesh->harmonizeNormals();
+        if (!eval.GetNonManifoldEdges().empty())
+            mesh->removeNonManifolds();
+        if (!eval.GetNonManifoldPoints().empty())
+            mesh->removeNonManifoldPoints();
+        if (!eval.GetDegeneratedFacets().empty())
+            mesh->validateDegenerations(epsilon);
+        if (!eval.GetDuplicatedFacets().empty())
+            mesh->removeDuplicatedFacets();
+        if (!eval.GetDuplicatedPoints().empty())
+            mesh->removeDuplicatedPoints();
+        this->Mesh.setValuePtr(mesh.release());
+    }
+
+    return App::DocumentObject::StdReturn;
+}
@@ -268,6 +268,26 @@ public:
   //@}
 };
 
+/**
+ * The FixAllDefects class analyzes the mesh with all common checks in one sweep and
+ * only runs the repair functions for the defects that were found.
+ */
+class MeshExport FixAllDefects : public Mesh::FixDefects
+{
+  PROPERTY_HEADER(Mesh::FixAllDefects);
+
+public:
+  /// Constructor
+  FixAllDefects(void);
+  virtual ~FixAllDefects();
+
+  /** @name methods override Feature */
+  //@{
+  /// recalculate the Feature
+  virtual App::DocumentObjectExecReturn *execute(void);
+  //@}
+};
+
 } //namespace Mesh
 
 
@@ -37,6 +37,7 @@
 #include <Base/Sequencer.h>
 #include <Base/Tools.h>
 #include <Base/ViewProj.h>
+#include <App/Application.h>
 
 #include "Core/Builder.h"
 #include "Core/MeshKernel.h"
@@ -1758,6 +1759,13 @@ MeshObject* MeshObject::createCube(float length, float width, float height, floa
     return 0;
 }
 
+bool MeshObject::useBoundingVolumeHierarchy()
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Mesh");
+    return hGrp->GetBool("BoundingVolumeHierarchy", false);
+}
+
 void MeshObject::addSegment(const Segment& s)
 {
     addSegment(s.getIndices());
@@ -317,6 +317,14 @@ public:
     static MeshObject* createCube(float, float, float, float);
     //@}
 
+    /** @name Search structures */
+    //@{
+    /** Returns true if the user parameter BoundingVolumeHierarchy of the Mesh module
+     * selects a MeshFacetBVH instead of a MeshFacetGrid for facet queries.
+     */
+    static bool useBoundingVolumeHierarchy();
+    //@}
+
 public:
     class MeshExport const_point_iterator
     {
@@ -451,27 +451,40 @@ void PropertyMeshKernel::setValuePtr(MeshObject* mesh)
     // before calling hasSetValue()
     Base::Reference<MeshObject> tmp(_meshObject);
     aboutToSetValue();
-    _meshObject = mesh;
+    discardDeferred();
+    setMeshObject(mesh);
     hasSetValue();
 }
 
 void PropertyMeshKernel::setValue(const MeshObject& mesh)
 {
     aboutToSetValue();
-    *_meshObject = mesh;
+    discardDeferred();
+    if (isShared())
+        setMeshObject(new MeshObject(mesh));
+    else
+        *_meshObject = mesh;
     hasSetValue();
 }
 
 void PropertyMeshKernel::setValue(const MeshCore::MeshKernel& mesh)
 {
     aboutToSetValue();
-    _meshObject->setKernel(mesh);
+    discardDeferred();
+    if (isShared())
+        setMeshObject(new MeshObject(mesh, _meshObject->getTransform()));
+    else
+        _meshObject->setKernel(mesh);
     hasSetValue();
 }
 
 void PropertyMeshKernel::swapMesh(MeshObject& mesh)
 {
     aboutToSetValue();
+    discardDeferred();
+    // the passed mesh gets the old data, a shared mesh is copied for it
+    if (isShared())
+        setMeshObject(new MeshObject(*_meshObject));
     _meshObject->swap(mesh);
     hasSetValue();
 }
@@ -479,27 +492,65 @@ void PropertyMeshKernel::swapMesh(MeshObject& mesh)
 void PropertyMeshKernel::swapMesh(MeshCore::MeshKernel& mesh)
 {
     aboutToSetValue();
+    discardDeferred();
+    if (isShared())
+        setMeshObject(new MeshObject(_meshObject->getKernel(), _meshObject->getTransform()));
     _meshObject->swap(mesh);
     hasSetValue();
 }
 
+bool PropertyMeshKernel::isShared() const
+{
+    // other references to the mesh object, e.g. by a Python wrapper of the
+    // mesh or a temporary in setValuePtr(), don't count
+    return _meshShare.use_count() > 1;
+}
+
+std::shared_ptr<PropertyMeshKernel::MeshShare> PropertyMeshKernel::shareMesh() const
+{
+    if (!_meshShare)
+        _meshShare = std::make_shared<MeshShare>();
+    return _meshShare;
+}
+
+void PropertyMeshKernel::setMeshObject(MeshObject* mesh)
+{
+    _meshObject = mesh;
+    _meshShare.reset();
+    // the Python wrapper always refers to the mesh of the property
+    if (meshPyObject)
+        meshPyObject->setTwinPointer(mesh);
+}
+
+MeshObject* PropertyMeshKernel::detachMesh()
+{
+    restoreDeferred();
+    if (isShared())
+        setMeshObject(new MeshObject(*_meshObject));
+    return _meshObject;
+}
+
 const MeshObject& PropertyMeshKernel::getValue(void)const 
 {
+    restoreDeferred();
     return *_meshObject;
 }
 
 const MeshObject* PropertyMeshKernel::getValuePtr(void)const 
 {
+    restoreDeferred();
     return (MeshObject*)_meshObject;
 }
 
 const Data::ComplexGeoData* PropertyMeshKernel::getComplexData() const
 {
+    restoreDeferred();
     return (MeshObject*)_meshObject;
 }
 
 Base::BoundBox3d PropertyMeshKernel::getBoundingBox() const
 {
+    restoreDeferred();
     return _meshObject->getBoundBox();
 }
 
@@ -507,14 +558,29 @@ unsigned int PropertyMeshKernel::getMemSize (void) const
 {
     unsigned int size = 0;
     size += _meshObject->getMemSize();
+    // a shared mesh is split between the properties holding it
+    if (_meshShare)
+        size /= _meshShare.use_count();
+    // a mesh not restored yet is estimated by the size of its data file
+    size += getDeferredSize();
     
     return size;
 }
 
+void PropertyMeshKernel::setTransform(const Base::Matrix4D &rclTrf)
+{
+    // The placement doesn't need the data of the mesh. A pending data file is
+    // loaded into the same mesh object later on and keeps the transformation.
+    if (isDeferred() && !isShared())
+        _meshObject->setTransform(rclTrf);
+    else
+        detachMesh()->setTransform(rclTrf);
+}
+
 MeshObject* PropertyMeshKernel::startEditing()
 {
     aboutToSetValue();
-    return (MeshObject*)_meshObject;
+    return detachMesh();
 }
 
 void PropertyMeshKernel::finishEditing()
@@ -525,14 +591,14 @@ void PropertyMeshKernel::finishEditing()
 void PropertyMeshKernel::transformGeometry(const Base::Matrix4D &rclMat)
 {
     aboutToSetValue();
-    _meshObject->transformGeometry(rclMat);
+    detachMesh()->transformGeometry(rclMat);
     hasSetValue();
 }
 
 void PropertyMeshKernel::setPointIndices(const std::vector<std::pair<unsigned long, Base::Vector3f> >& inds)
 {
     aboutToSetValue();
-    MeshCore::MeshKernel& kernel = _meshObject->getKernel();
+    MeshCore::MeshKernel& kernel = detachMesh()->getKernel();
     for (std::vector<std::pair<unsigned long, Base::Vector3f> >::const_iterator it = inds.begin(); it != inds.end(); ++it)
         kernel.SetPoint(it->first, it->second);
     hasSetValue();
@@ -540,6 +606,7 @@ void PropertyMeshKernel::setPointIndices(const std::vector<std::pair<unsigned lo
 
 PyObject *PropertyMeshKernel::getPyObject(void)
 {
+    restoreDeferred();
     if (!meshPyObject) {
         meshPyObject = new MeshPy(&*_meshObject);
         meshPyObject->setConst(); // set immutable
@@ -575,6 +642,7 @@ void PropertyMeshKernel::setPyObject(PyObject *value)
 
 void PropertyMeshKernel::Save (Base::Writer &writer) const
 {
+    restoreDeferred();
     if (writer.isForceXML()) {
         writer.Stream() << writer.ind() << "<Mesh>" << std::endl;
         MeshCore::MeshOutput saver(_meshObject->getKernel());
@@ -603,40 +671,54 @@ void PropertyMeshKernel::Restore(Base::XMLReader &reader)
         kernel.Adopt(points, facets);
 
         aboutToSetValue();
+        if (isShared())
+            setMeshObject(new MeshObject(MeshCore::MeshKernel(), _meshObject->getTransform()));
         _meshObject->getKernel().Adopt(points, facets);
         hasSetValue();
     } 
     else {
-        // initiate a file read
-        reader.addFile(file.c_str(),this);
+        // initiate a file read, which may be deferred until the mesh is needed
+        addDeferredFile(reader, file.c_str());
     }
 }
 
 void PropertyMeshKernel::SaveDocFile (Base::Writer &writer) const
 {
+    restoreDeferred();
     _meshObject->save(writer.Stream());
 }
 
 void PropertyMeshKernel::RestoreDocFile(Base::Reader &reader)
 {
-    aboutToSetValue();
+    // a deferred mesh completes the restored document and thus isn't a change
+    bool notify = !reader.isDeferred();
+    if (notify)
+        aboutToSetValue();
+    if (isShared())
+        setMeshObject(new MeshObject(MeshCore::MeshKernel(), _meshObject->getTransform()));
     _meshObject->load(reader);
-    hasSetValue();
+    if (notify)
+        hasSetValue();
 }
 
 App::Property *PropertyMeshKernel::Copy(void) const
 {
-    // Note: Copy the content, do NOT reference the same mesh object
+    // Note: The copy references the same mesh object. Before the mesh gets
+    // modified by either of the properties it's copied (see detachMesh()).
+    restoreDeferred();
     PropertyMeshKernel *prop = new PropertyMeshKernel();
-    *(prop->_meshObject) = *(this->_meshObject);
+    prop->_meshObject = this->_meshObject;
+    prop->_meshShare = shareMesh();
     return prop;
 }
 
 void PropertyMeshKernel::Paste(const App::Property &from)
 {
-    // Note: Copy the content, do NOT reference the same mesh object
+    // Note: The mesh object is shared until one of the properties modifies it
     aboutToSetValue();
+    discardDeferred();
     const PropertyMeshKernel& prop = dynamic_cast<const PropertyMeshKernel&>(from);
-    *(this->_meshObject) = *(prop._meshObject);
+    setMeshObject(prop._meshObject);
+    _meshShare = prop.shareMesh();
     hasSetValue();
 }
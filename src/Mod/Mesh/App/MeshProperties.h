@@ -29,6 +29,7 @@
 #include <set>
 #include <string>
 #include <map>
+#include <memory>
 
 #include <Base/Handle.h>
 #include <Base/Matrix.h>
@@ -215,6 +216,8 @@ public:
     void finishEditing();
     /// Transform the real mesh data
     void transformGeometry(const Base::Matrix4D &rclMat);
+    /// Set the placement of the mesh without notification
+    void setTransform(const Base::Matrix4D &rclTrf);
     void setPointIndices( const std::vector<std::pair<unsigned long, Base::Vector3f> >& );
     //@}
 
@@ -249,8 +252,20 @@ public:
     void Paste(const App::Property &from);
     //@}
 
+private:
+    /** Copies of the property, e.g. by the undo stack, share the mesh object
+     * with this property. The mesh must be detached before it can be modified.
+     */
+    bool isShared() const;
+    MeshObject* detachMesh();
+    void setMeshObject(MeshObject*);
+    struct MeshShare {};
+    std::shared_ptr<MeshShare> shareMesh() const;
+
 private:
     Base::Reference<MeshObject> _meshObject;
+    /// Held by all properties that share the mesh object, see Copy() and Paste()
+    mutable std::shared_ptr<MeshShare> _meshShare;
     MeshPy* meshPyObject;
 };
 
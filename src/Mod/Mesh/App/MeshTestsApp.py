@@ -45,6 +45,76 @@ class MeshTopoTestCases(unittest.TestCase):
 		planarMeshObject = Mesh.Mesh(self.planarMesh)
 		planarMeshObject.collapseFacets(range(18))
 
+	def testNeighbourIndices(self):
+		# two triangles sharing one edge
+		planarMeshObject = Mesh.Mesh(self.planarMesh[0:6])
+		n0 = planarMeshObject.Facets[0].NeighbourIndices
+		n1 = planarMeshObject.Facets[1].NeighbourIndices
+		self.assertEqual(n0.count(1), 1)
+		self.assertEqual(n1.count(0), 1)
+		# open edges must keep the invalid index with the compact storage
+		invalid = [i for i in n0 + n1 if i > 1]
+		self.assertEqual(len(invalid), 4)
+		self.assertEqual(len(set(invalid)), 1)
+		self.assertTrue(invalid[0] >= 2**32-1)
+
+	def createGrid(self, count):
+		# a planar grid of count x count squares with two triangles each
+		points = []
+		for i in range(count + 1):
+			for j in range(count + 1):
+				points.append(FreeCAD.Vector(i, j, 0))
+		faces = []
+		for i in range(count):
+			for j in range(count):
+				a = i * (count + 1) + j
+				c = a + count + 1
+				faces.append((a, a + 1, c + 1))
+				faces.append((a, c + 1, c))
+		return points, faces
+
+	def checkNeighbours(self, mesh):
+		# compare with the neighbours found by a brute-force search over all edges
+		points, faces = mesh.Topology
+		facets = mesh.Facets
+		edges = {}
+		for index, face in enumerate(faces):
+			for j in range(3):
+				edges.setdefault(frozenset((face[j], face[(j+1)%3])), []).append(index)
+		for index, face in enumerate(faces):
+			neighbours = facets[index].NeighbourIndices
+			for j in range(3):
+				other = [f for f in edges[frozenset((face[j], face[(j+1)%3]))] if f != index]
+				if other:
+					self.assertEqual(neighbours[j], other[0])
+				else:
+					self.assertTrue(neighbours[j] >= 2**32-1)
+
+	def testNeighbourIndicesParallel(self):
+		# enough facets to split the rebuild over several threads
+		points, faces = self.createGrid(80)
+		mesh = Mesh.Mesh()
+		mesh.addFacets((points, faces), False)
+		self.assertEqual(mesh.CountFacets, len(faces))
+		self.checkNeighbours(mesh)
+		mesh.rebuildNeighbourHood()
+		self.checkNeighbours(mesh)
+
+	def testNeighbourIndicesIncremental(self):
+		# the second half shares points with the first one and must be connected to it
+		points, faces = self.createGrid(80)
+		mesh = Mesh.Mesh()
+		mesh.addFacets((points, faces[0::2]), False)
+		mesh.addFacets(([], faces[1::2]), False)
+		self.assertEqual(mesh.CountFacets, len(faces))
+		self.checkNeighbours(mesh)
+
+		# merging a mesh appends its points, so both parts stay disconnected
+		other = Mesh.Mesh()
+		other.addFacets((points, faces[:len(faces)//2]), False)
+		mesh.addMesh(other)
+		self.checkNeighbours(mesh)
+
 
 class MeshGeoTestCases(unittest.TestCase):
 	def setUp(self):
@@ -80,6 +150,65 @@ class MeshGeoTestCases(unittest.TestCase):
 		res=f1.intersect(f2)
 		self.failUnless(len(res) == 0)
 
+	def testSelfIntersectionsWithGrid(self):
+		# large enough to build the facet grid on several threads
+		sphere = Mesh.createSphere(10.0, 100)
+		self.failUnless(sphere.CountFacets > 10000)
+		self.failIf(sphere.hasSelfIntersections())
+		box1 = Mesh.createBox(10.0, 10.0, 10.0)
+		box2 = Mesh.createBox(10.0, 10.0, 10.0)
+		box2.translate(5.0, 5.0, 5.0)
+		box1.addMesh(box2)
+		self.failUnless(box1.hasSelfIntersections())
+
+class MeshDefectsTestCases(unittest.TestCase):
+	def setUp(self):
+		self.doc = FreeCAD.newDocument("MeshDefectsTest")
+
+	def testFixAllDefects(self):
+		# a box with one flipped facet
+		box = Mesh.createBox(1.0, 1.0, 1.0)
+		points = []
+		for i, facet in enumerate(box.Facets):
+			pts = list(facet.Points)
+			if i == 0:
+				pts.reverse()
+			points.extend(pts)
+		feature = self.doc.addObject("Mesh::Feature", "Mesh")
+		feature.Mesh = Mesh.Mesh(points)
+		self.failUnless(feature.Mesh.hasNonUniformOrientedFacets())
+		fix = self.doc.addObject("Mesh::FixAllDefects", "FixAllDefects")
+		fix.Source = feature
+		self.doc.recompute()
+		self.failIf(fix.Mesh.hasNonUniformOrientedFacets())
+		self.failUnless(fix.Mesh.CountFacets == 12)
+		self.failUnless(fix.Mesh.isSolid())
+
+	def tearDown(self):
+		FreeCAD.closeDocument("MeshDefectsTest")
+
+class MeshIOTestCases(unittest.TestCase):
+	def setUp(self):
+		self.mesh = Mesh.createSphere(10.0, 200)
+
+	def testBinarySTL(self):
+		# large enough to read the memory mapped file in parallel
+		name = tempfile.gettempdir() + os.sep + "mesh_io.stl"
+		self.mesh.write(name)
+		mesh = Mesh.Mesh(name)
+		os.remove(name)
+		self.failUnless(mesh.CountPoints == self.mesh.CountPoints)
+		self.failUnless(mesh.CountFacets == self.mesh.CountFacets)
+		self.failUnless(mesh.isSolid())
+
+	def testPLY(self):
+		name = tempfile.gettempdir() + os.sep + "mesh_io.ply"
+		self.mesh.write(name)
+		mesh = Mesh.Mesh(name)
+		os.remove(name)
+		self.failUnless(mesh.CountPoints == self.mesh.CountPoints)
+		self.failUnless(mesh.CountFacets == self.mesh.CountFacets)
+
 class PivyTestCases(unittest.TestCase):
 	def setUp(self):
 		# set up a planar face with 2 triangles
@@ -230,3 +359,81 @@ class PolynomialFitCases(unittest.TestCase):
 
     def tearDown(self):
         pass
+
+class MeshUndoTestCases(unittest.TestCase):
+    def setUp(self):
+        self.doc = FreeCAD.newDocument("MeshUndoTest")
+        self.doc.UndoMode = 1
+
+    def testUndoRedoEditing(self):
+        feature = self.doc.addObject("Mesh::Feature", "Mesh")
+        feature.Mesh = Mesh.createSphere(10.0, 20)
+        mesh = feature.Mesh
+        before = [p.Vector for p in mesh.Points]
+
+        self.doc.openTransaction("Smooth")
+        feature.smooth(3)
+        self.doc.commitTransaction()
+        after = [p.Vector for p in feature.Mesh.Points]
+        self.assertNotEqual(before, after)
+        self.assertEqual([p.Vector for p in mesh.Points], after)
+        self.assertGreater(self.doc.UndoRedoMemSize, 0)
+
+        self.doc.undo()
+        self.assertEqual([p.Vector for p in feature.Mesh.Points], before)
+        self.assertEqual([p.Vector for p in mesh.Points], before)
+
+        self.doc.redo()
+        self.assertEqual([p.Vector for p in feature.Mesh.Points], after)
+
+    def tearDown(self):
+        FreeCAD.closeDocument(self.doc.Name)
+
+class MeshLazyLoadingTestCases(unittest.TestCase):
+    def setUp(self):
+        self.doc = FreeCAD.newDocument("MeshLazyLoadingTest")
+        self.fileName = tempfile.gettempdir() + os.sep + "MeshLazyLoading.FCStd"
+
+    def openLazy(self):
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+        lazy = param.GetBool("LazyLoading", False)
+        param.SetBool("LazyLoading", True)
+        try:
+            return FreeCAD.openDocument(self.fileName)
+        finally:
+            param.SetBool("LazyLoading", lazy)
+
+    def testLazyLoading(self):
+        feature = self.doc.addObject("Mesh::Feature", "Mesh")
+        feature.Mesh = Mesh.createSphere(10.0, 20)
+        count = feature.Mesh.CountPoints
+        self.doc.saveAs(self.fileName)
+        FreeCAD.closeDocument(self.doc.Name)
+
+        self.doc = self.openLazy()
+        feature = self.doc.getObject("Mesh")
+        self.assertFalse("Touched" in self.doc.State)
+
+        # the placement set before the mesh data is restored must be kept
+        feature.Placement = FreeCAD.Placement(FreeCAD.Vector(5, 0, 0), FreeCAD.Rotation())
+        mesh = feature.Mesh
+        self.assertEqual(mesh.CountPoints, count)
+        self.assertAlmostEqual(mesh.Placement.Base.x, 5.0)
+        self.assertAlmostEqual(mesh.BoundBox.Center.x, 5.0, 3)
+        self.assertAlmostEqual(mesh.BoundBox.XLength, 20.0, 1)
+
+        # saving restores the pending data and keeps the placement
+        feature.Placement = FreeCAD.Placement(FreeCAD.Vector(0, 5, 0), FreeCAD.Rotation())
+        self.doc.save()
+        FreeCAD.closeDocument(self.doc.Name)
+        self.doc = self.openLazy()
+        feature = self.doc.getObject("Mesh")
+        feature.Placement = FreeCAD.Placement(FreeCAD.Vector(0, 0, 5), FreeCAD.Rotation())
+        mesh = feature.Mesh
+        self.assertEqual(mesh.CountPoints, count)
+        self.assertAlmostEqual(mesh.BoundBox.Center.y, 0.0, 3)
+        self.assertAlmostEqual(mesh.BoundBox.Center.z, 5.0, 3)
+
+    def tearDown(self):
+        FreeCAD.closeDocument(self.doc.Name)
+        os.remove(self.fileName)
@@ -60,6 +60,7 @@
 #endif
 // STL
 #include <algorithm>
+#include <atomic>
 #include <bitset>
 #include <iostream>
 #include <iomanip>
@@ -440,40 +440,30 @@ void DlgEvaluateMeshImp::on_analyzeOrientationButton_clicked()
 
         const MeshKernel& rMesh = d->meshFeature->Mesh.getValue().getKernel();
         MeshEvalOrientation eval(rMesh);
-        std::vector<unsigned long> inds = eval.GetIndices();
-#if 0
-        if (inds.empty() && !eval.Evaluate()) {
-            d->ui.checkOrientationButton->setText(tr("Flipped normals found"));
-            MeshEvalFoldOversOnSurface f_eval(rMesh);
-            if (!f_eval.Evaluate()) {
-                qApp->restoreOverrideCursor();
-                QMessageBox::warning(this, tr("Orientation"),
-                    tr("Check failed due to folds on the surface.\n"
-                    "Please run the command to repair folds first"));
-                qApp->setOverrideCursor(Qt::WaitCursor);
-            }
-        }
-        else
-#endif
-        if (inds.empty()) {
-            d->ui.checkOrientationButton->setText( tr("No flipped normals") );
-            d->ui.checkOrientationButton->setChecked(false);
-            d->ui.repairOrientationButton->setEnabled(false);
-            removeViewProvider( "MeshGui::ViewProviderMeshOrientation" );
-        }
-        else {
-            d->ui.checkOrientationButton->setText( tr("%1 flipped normals").arg(inds.size()) );
-            d->ui.checkOrientationButton->setChecked(true);
-            d->ui.repairOrientationButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
-            addViewProvider( "MeshGui::ViewProviderMeshOrientation", eval.GetIndices());
-        }
+        showOrientation(eval.GetIndices());
 
         qApp->restoreOverrideCursor();
         d->ui.analyzeOrientationButton->setEnabled(true);
     }
 }
 
+void DlgEvaluateMeshImp::showOrientation(const std::vector<unsigned long>& inds)
+{
+    if (inds.empty()) {
+        d->ui.checkOrientationButton->setText( tr("No flipped normals") );
+        d->ui.checkOrientationButton->setChecked(false);
+        d->ui.repairOrientationButton->setEnabled(false);
+        removeViewProvider( "MeshGui::ViewProviderMeshOrientation" );
+    }
+    else {
+        d->ui.checkOrientationButton->setText( tr("%1 flipped normals").arg(inds.size()) );
+        d->ui.checkOrientationButton->setChecked(true);
+        d->ui.repairOrientationButton->setEnabled(true);
+        d->ui.repairAllTogether->setEnabled(true);
+        addViewProvider( "MeshGui::ViewProviderMeshOrientation", inds);
+    }
+}
+
 void DlgEvaluateMeshImp::on_repairOrientationButton_clicked()
 {
     if (d->meshFeature) {
@@ -530,50 +520,53 @@ void DlgEvaluateMeshImp::on_analyzeNonmanifoldsButton_clicked()
 
         const MeshKernel& rMesh = d->meshFeature->Mesh.getValue().getKernel();
         MeshEvalTopology f_eval(rMesh);
-        bool ok1 = f_eval.Evaluate();
-        bool ok2 = true;
+        f_eval.Evaluate();
         std::vector<unsigned long> point_indices;
 
         if (d->checkNonManfoldPoints) {
             MeshEvalPointManifolds p_eval(rMesh);
-            ok2 = p_eval.Evaluate();
-            if (!ok2)
+            if (!p_eval.Evaluate())
                 point_indices = p_eval.GetIndices();
         }
 
-        if (ok1 && ok2) {
-            d->ui.checkNonmanifoldsButton->setText(tr("No non-manifolds"));
-            d->ui.checkNonmanifoldsButton->setChecked(false);
-            d->ui.repairNonmanifoldsButton->setEnabled(false);
-            removeViewProvider("MeshGui::ViewProviderMeshNonManifolds");
-            removeViewProvider("MeshGui::ViewProviderMeshNonManifoldPoints");
-        }
-        else {
-            d->ui.checkNonmanifoldsButton->setText(tr("%1 non-manifolds").arg(f_eval.CountManifolds()+point_indices.size()));
-            d->ui.checkNonmanifoldsButton->setChecked(true);
-            d->ui.repairNonmanifoldsButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
+        showNonManifolds(f_eval.GetIndices(), point_indices);
 
-            if (!ok1) {
-                const std::vector<std::pair<unsigned long, unsigned long> >& inds = f_eval.GetIndices();
-                std::vector<unsigned long> indices;
-                indices.reserve(2*inds.size());
-                std::vector<std::pair<unsigned long, unsigned long> >::const_iterator it;
-                for (it = inds.begin(); it != inds.end(); ++it) {
-                    indices.push_back(it->first);
-                    indices.push_back(it->second);
-                }
+        qApp->restoreOverrideCursor();
+        d->ui.analyzeNonmanifoldsButton->setEnabled(true);
+    }
+}
 
-                addViewProvider("MeshGui::ViewProviderMeshNonManifolds", indices);
-            }
+void DlgEvaluateMeshImp::showNonManifolds(const std::vector<std::pair<unsigned long, unsigned long> >& inds,
+                                          const std::vector<unsigned long>& point_indices)
+{
+    if (inds.empty() && point_indices.empty()) {
+        d->ui.checkNonmanifoldsButton->setText(tr("No non-manifolds"));
+        d->ui.checkNonmanifoldsButton->setChecked(false);
+        d->ui.repairNonmanifoldsButton->setEnabled(false);
+        removeViewProvider("MeshGui::ViewProviderMeshNonManifolds");
+        removeViewProvider("MeshGui::ViewProviderMeshNonManifoldPoints");
+    }
+    else {
+        d->ui.checkNonmanifoldsButton->setText(tr("%1 non-manifolds").arg(inds.size()+point_indices.size()));
+        d->ui.checkNonmanifoldsButton->setChecked(true);
+        d->ui.repairNonmanifoldsButton->setEnabled(true);
+        d->ui.repairAllTogether->setEnabled(true);
 
-            if (!ok2) {
-                addViewProvider("MeshGui::ViewProviderMeshNonManifoldPoints", point_indices);
+        if (!inds.empty()) {
+            std::vector<unsigned long> indices;
+            indices.reserve(2*inds.size());
+            std::vector<std::pair<unsigned long, unsigned long> >::const_iterator it;
+            for (it = inds.begin(); it != inds.end(); ++it) {
+                indices.push_back(it->first);
+                indices.push_back(it->second);
             }
+
+            addViewProvider("MeshGui::ViewProviderMeshNonManifolds", indices);
         }
 
-        qApp->restoreOverrideCursor();
-        d->ui.analyzeNonmanifoldsButton->setEnabled(true);
+        if (!point_indices.empty()) {
+            addViewProvider("MeshGui::ViewProviderMeshNonManifoldPoints", point_indices);
+        }
     }
 }
 
@@ -635,47 +628,65 @@ void DlgEvaluateMeshImp::on_analyzeIndicesButton_clicked()
         MeshEvalRangePoint rp(rMesh);
         MeshEvalCorruptedFacets cf(rMesh);
         MeshEvalNeighbourhood nb(rMesh);
+        std::vector<unsigned long> empty;
         
-        if (!rf.Evaluate()) {
-            d->ui.checkIndicesButton->setText(tr("Invalid face indices"));
-            d->ui.checkIndicesButton->setChecked(true);
-            d->ui.repairIndicesButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
-            addViewProvider("MeshGui::ViewProviderMeshIndices", rf.GetIndices());
-        }
-        else if (!rp.Evaluate()) {
-            d->ui.checkIndicesButton->setText(tr("Invalid point indices"));
-            d->ui.checkIndicesButton->setChecked(true);
-            d->ui.repairIndicesButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
-            //addViewProvider("MeshGui::ViewProviderMeshIndices", rp.GetIndices());
-        }
-        else if (!cf.Evaluate()) {
-            d->ui.checkIndicesButton->setText(tr("Multiple point indices"));
-            d->ui.checkIndicesButton->setChecked(true);
-            d->ui.repairIndicesButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
-            addViewProvider("MeshGui::ViewProviderMeshIndices", cf.GetIndices());
-        }
-        else if (!nb.Evaluate()) {
-            d->ui.checkIndicesButton->setText(tr("Invalid neighbour indices"));
-            d->ui.checkIndicesButton->setChecked(true);
-            d->ui.repairIndicesButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
-            addViewProvider("MeshGui::ViewProviderMeshIndices", nb.GetIndices());
-        }
-        else {
-            d->ui.checkIndicesButton->setText(tr("No invalid indices"));
-            d->ui.checkIndicesButton->setChecked(false);
-            d->ui.repairIndicesButton->setEnabled(false);
-            removeViewProvider("MeshGui::ViewProviderMeshIndices");
-        }
+        if (!rf.Evaluate())
+            showIndices(rf.GetIndices(), empty, empty, empty);
+        else if (!rp.Evaluate())
+            showIndices(empty, rp.GetIndices(), empty, empty);
+        else if (!cf.Evaluate())
+            showIndices(empty, empty, cf.GetIndices(), empty);
+        else if (!nb.Evaluate())
+            showIndices(empty, empty, empty, nb.GetIndices());
+        else
+            showIndices(empty, empty, empty, empty);
 
         qApp->restoreOverrideCursor();
         d->ui.analyzeIndicesButton->setEnabled(true);
     }
 }
 
+void DlgEvaluateMeshImp::showIndices(const std::vector<unsigned long>& range_facets,
+                                     const std::vector<unsigned long>& range_points,
+                                     const std::vector<unsigned long>& corrupted_facets,
+                                     const std::vector<unsigned long>& neighbours)
+{
+    if (!range_facets.empty()) {
+        d->ui.checkIndicesButton->setText(tr("Invalid face indices"));
+        d->ui.checkIndicesButton->setChecked(true);
+        d->ui.repairIndicesButton->setEnabled(true);
+        d->ui.repairAllTogether->setEnabled(true);
+        addViewProvider("MeshGui::ViewProviderMeshIndices", range_facets);
+    }
+    else if (!range_points.empty()) {
+        d->ui.checkIndicesButton->setText(tr("Invalid point indices"));
+        d->ui.checkIndicesButton->setChecked(true);
+        d->ui.repairIndicesButton->setEnabled(true);
+        d->ui.repairAllTogether->setEnabled(true);
+        //addViewProvider("MeshGui::ViewProviderMeshIndices", range_points);
+    }
+    else if (!corrupted_facets.empty()) {
+        d->ui.checkIndicesButton->setText(tr("Multiple point indices"));
+        d->ui.checkIndicesButton->setChecked(true);
+        d->ui.repairIndicesButton->setEnabled(true);
+        d->ui.repairAllTogether->setEnabled(true);
+        addViewProvider("MeshGui::ViewProviderMeshIndices", corrupted_facets);
+    }
+    else if (!neighbours.empty()) {
+        d->ui.checkIndicesButton->setText(tr("Invalid neighbour indices"));
+        d->ui.checkIndicesButton->setChecked(true);
+        d->ui.repairIndicesButton->setEnabled(true);
+        d->ui.repairAllTogether->setEnabled(true);
+        addViewProvider("MeshGui::ViewProviderMeshIndices", neighbours);
+    }
+    else {
+        d->ui.checkIndicesButton->setText(tr("No invalid indices"));
+        d->ui.checkIndicesButton->setChecked(false);
+        d->ui.repairIndicesButton->setEnabled(false);
+        removeViewProvider("MeshGui::ViewProviderMeshIndices");
+    }
+}
+
 void DlgEvaluateMeshImp::on_repairIndicesButton_clicked()
 {
     if (d->meshFeature) {
@@ -721,27 +732,30 @@ void DlgEvaluateMeshImp::on_analyzeDegeneratedButton_clicked()
 
         const MeshKernel& rMesh = d->meshFeature->Mesh.getValue().getKernel();
         MeshEvalDegeneratedFacets eval(rMesh, d->epsilonDegenerated);
-        std::vector<unsigned long> degen = eval.GetIndices();
-        
-        if (degen.empty()) {
-            d->ui.checkDegenerationButton->setText(tr("No degenerations"));
-            d->ui.checkDegenerationButton->setChecked(false);
-            d->ui.repairDegeneratedButton->setEnabled(false);
-            removeViewProvider("MeshGui::ViewProviderMeshDegenerations");
-        }
-        else {
-            d->ui.checkDegenerationButton->setText(tr("%1 degenerated faces").arg(degen.size()));
-            d->ui.checkDegenerationButton->setChecked(true);
-            d->ui.repairDegeneratedButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
-            addViewProvider("MeshGui::ViewProviderMeshDegenerations", degen);
-        }
+        showDegenerations(eval.GetIndices());
 
         qApp->restoreOverrideCursor();
         d->ui.analyzeDegeneratedButton->setEnabled(true);
     }
 }
 
+void DlgEvaluateMeshImp::showDegenerations(const std::vector<unsigned long>& degen)
+{
+    if (degen.empty()) {
+        d->ui.checkDegenerationButton->setText(tr("No degenerations"));
+        d->ui.checkDegenerationButton->setChecked(false);
+        d->ui.repairDegeneratedButton->setEnabled(false);
+        removeViewProvider("MeshGui::ViewProviderMeshDegenerations");
+    }
+    else {
+        d->ui.checkDegenerationButton->setText(tr("%1 degenerated faces").arg(degen.size()));
+        d->ui.checkDegenerationButton->setChecked(true);
+        d->ui.repairDegeneratedButton->setEnabled(true);
+        d->ui.repairAllTogether->setEnabled(true);
+        addViewProvider("MeshGui::ViewProviderMeshDegenerations", degen);
+    }
+}
+
 void DlgEvaluateMeshImp::on_repairDegeneratedButton_clicked()
 {
     if (d->meshFeature) {
@@ -787,28 +801,31 @@ void DlgEvaluateMeshImp::on_analyzeDuplicatedFacesButton_clicked()
 
         const MeshKernel& rMesh = d->meshFeature->Mesh.getValue().getKernel();
         MeshEvalDuplicateFacets eval(rMesh);
-        std::vector<unsigned long> dupl = eval.GetIndices();
-    
-        if (dupl.empty()) {
-            d->ui.checkDuplicatedFacesButton->setText(tr("No duplicated faces"));
-            d->ui.checkDuplicatedFacesButton->setChecked(false);
-            d->ui.repairDuplicatedFacesButton->setEnabled(false);
-            removeViewProvider("MeshGui::ViewProviderMeshDuplicatedFaces");
-        }
-        else {
-            d->ui.checkDuplicatedFacesButton->setText(tr("%1 duplicated faces").arg(dupl.size()));
-            d->ui.checkDuplicatedFacesButton->setChecked(true);
-            d->ui.repairDuplicatedFacesButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
-
-            addViewProvider("MeshGui::ViewProviderMeshDuplicatedFaces", dupl);
-        }
+        showDuplicatedFaces(eval.GetIndices());
 
         qApp->restoreOverrideCursor();
         d->ui.analyzeDuplicatedFacesButton->setEnabled(true);
     }
 }
 
+void DlgEvaluateMeshImp::showDuplicatedFaces(const std::vector<unsigned long>& dupl)
+{
+    if (dupl.empty()) {
+        d->ui.checkDuplicatedFacesButton->setText(tr("No duplicated faces"));
+        d->ui.checkDuplicatedFacesButton->setChecked(false);
+        d->ui.repairDuplicatedFacesButton->setEnabled(false);
+        removeViewProvider("MeshGui::ViewProviderMeshDuplicatedFaces");
+    }
+    else {
+        d->ui.checkDuplicatedFacesButton->setText(tr("%1 duplicated faces").arg(dupl.size()));
+        d->ui.checkDuplicatedFacesButton->setChecked(true);
+        d->ui.repairDuplicatedFacesButton->setEnabled(true);
+        d->ui.repairAllTogether->setEnabled(true);
+
+        addViewProvider("MeshGui::ViewProviderMeshDuplicatedFaces", dupl);
+    }
+}
+
 void DlgEvaluateMeshImp::on_repairDuplicatedFacesButton_clicked()
 {
     if (d->meshFeature) {
@@ -854,26 +871,30 @@ void DlgEvaluateMeshImp::on_analyzeDuplicatedPointsButton_clicked()
 
         const MeshKernel& rMesh = d->meshFeature->Mesh.getValue().getKernel();
         MeshEvalDuplicatePoints eval(rMesh);
-    
-        if (eval.Evaluate()) {
-            d->ui.checkDuplicatedPointsButton->setText(tr("No duplicated points"));
-            d->ui.checkDuplicatedPointsButton->setChecked(false);
-            d->ui.repairDuplicatedPointsButton->setEnabled(false);
-            removeViewProvider("MeshGui::ViewProviderMeshDuplicatedPoints");
-        }
-        else {
-            d->ui.checkDuplicatedPointsButton->setText(tr("Duplicated points"));
-            d->ui.checkDuplicatedPointsButton->setChecked(true);
-            d->ui.repairDuplicatedPointsButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
-            addViewProvider("MeshGui::ViewProviderMeshDuplicatedPoints", eval.GetIndices());
-        }
+        showDuplicatedPoints(eval.GetIndices());
 
         qApp->restoreOverrideCursor();
         d->ui.analyzeDuplicatedPointsButton->setEnabled(true);
     }
 }
 
+void DlgEvaluateMeshImp::showDuplicatedPoints(const std::vector<unsigned long>& dupl)
+{
+    if (dupl.empty()) {
+        d->ui.checkDuplicatedPointsButton->setText(tr("No duplicated points"));
+        d->ui.checkDuplicatedPointsButton->setChecked(false);
+        d->ui.repairDuplicatedPointsButton->setEnabled(false);
+        removeViewProvider("MeshGui::ViewProviderMeshDuplicatedPoints");
+    }
+    else {
+        d->ui.checkDuplicatedPointsButton->setText(tr("Duplicated points"));
+        d->ui.checkDuplicatedPointsButton->setChecked(true);
+        d->ui.repairDuplicatedPointsButton->setEnabled(true);
+        d->ui.repairAllTogether->setEnabled(true);
+        addViewProvider("MeshGui::ViewProviderMeshDuplicatedPoints", dupl);
+    }
+}
+
 void DlgEvaluateMeshImp::on_repairDuplicatedPointsButton_clicked()
 {
     if (d->meshFeature) {
@@ -927,32 +948,37 @@ void DlgEvaluateMeshImp::on_analyzeSelfIntersectionButton_clicked()
             Base::Console().Message("The self-intersection analyse was aborted by the user\n");
         }
 
-        if (intersection.empty()) {
-            d->ui.checkSelfIntersectionButton->setText(tr("No self-intersections"));
-            d->ui.checkSelfIntersectionButton->setChecked(false);
-            d->ui.repairSelfIntersectionButton->setEnabled(false);
-            removeViewProvider("MeshGui::ViewProviderMeshSelfIntersections");
-        }
-        else {
-            d->ui.checkSelfIntersectionButton->setText(tr("Self-intersections"));
-            d->ui.checkSelfIntersectionButton->setChecked(true);
-            d->ui.repairSelfIntersectionButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
+        showSelfIntersections(intersection);
 
-            std::vector<unsigned long> indices;
-            indices.reserve(2*intersection.size());
-            std::vector<std::pair<unsigned long, unsigned long> >::iterator it;
-            for (it = intersection.begin(); it != intersection.end(); ++it) {
-                indices.push_back(it->first);
-                indices.push_back(it->second);
-            }
+        qApp->restoreOverrideCursor();
+        d->ui.analyzeSelfIntersectionButton->setEnabled(true);
+    }
+}
 
-            addViewProvider("MeshGui::ViewProviderMeshSelfIntersections", indices);
-            d->self_intersections.swap(indices);
+void DlgEvaluateMeshImp::showSelfIntersections(const std::vector<std::pair<unsigned long, unsigned long> >& intersection)
+{
+    if (intersection.empty()) {
+        d->ui.checkSelfIntersectionButton->setText(tr("No self-intersections"));
+        d->ui.checkSelfIntersectionButton->setChecked(false);
+        d->ui.repairSelfIntersectionButton->setEnabled(false);
+        removeViewProvider("MeshGui::ViewProviderMeshSelfIntersections");
+    }
+    else {
+        d->ui.checkSelfIntersectionButton->setText(tr("Self-intersections"));
+        d->ui.checkSelfIntersectionButton->setChecked(true);
+        d->ui.repairSelfIntersectionButton->setEnabled(true);
+        d->ui.repairAllTogether->setEnabled(true);
+
+        std::vector<unsigned long> indices;
+        indices.reserve(2*intersection.size());
+        std::vector<std::pair<unsigned long, unsigned long> >::const_iterator it;
+        for (it = intersection.begin(); it != intersection.end(); ++it) {
+            indices.push_back(it->first);
+            indices.push_back(it->second);
         }
 
-        qApp->restoreOverrideCursor();
-        d->ui.analyzeSelfIntersectionButton->setEnabled(true);
+        addViewProvider("MeshGui::ViewProviderMeshSelfIntersections", indices);
+        d->self_intersections.swap(indices);
     }
 }
 
@@ -1073,15 +1099,43 @@ void DlgEvaluateMeshImp::on_repairFoldsButton_clicked()
 
 void DlgEvaluateMeshImp::on_analyzeAllTogether_clicked()
 {
-    on_analyzeOrientationButton_clicked();
-    on_analyzeDuplicatedFacesButton_clicked();
-    on_analyzeDuplicatedPointsButton_clicked();
-    on_analyzeNonmanifoldsButton_clicked();
-    on_analyzeDegeneratedButton_clicked();
-    on_analyzeIndicesButton_clicked();
-    on_analyzeSelfIntersectionButton_clicked();
-    if (d->enableFoldsCheck)
-        on_analyzeFoldsButton_clicked();
+    if (d->meshFeature) {
+        d->ui.analyzeAllTogether->setEnabled(false);
+        qApp->processEvents();
+        qApp->setOverrideCursor(Qt::WaitCursor);
+
+        // run all checks in one sweep instead of one after another
+        int checks = MeshEvalDefects::AllChecks;
+        if (!d->checkNonManfoldPoints)
+            checks &= ~MeshEvalDefects::NonManifoldPoints;
+        const MeshKernel& rMesh = d->meshFeature->Mesh.getValue().getKernel();
+        MeshEvalDefects eval(rMesh, d->epsilonDegenerated, checks);
+        bool aborted = false;
+        try {
+            eval.Evaluate();
+        }
+        catch (const Base::AbortException&) {
+            Base::Console().Message("The mesh analyse was aborted by the user\n");
+            aborted = true;
+        }
+
+        if (!aborted) {
+            showOrientation(eval.GetFlippedFacets());
+            showDuplicatedFaces(eval.GetDuplicatedFacets());
+            showDuplicatedPoints(eval.GetDuplicatedPoints());
+            showNonManifolds(eval.GetNonManifoldEdges(), eval.GetNonManifoldPoints());
+            showDegenerations(eval.GetDegeneratedFacets());
+            showIndices(eval.GetInvalidNeighbourIndices(), eval.GetInvalidPointIndices(),
+                        eval.GetCorruptedFacets(), eval.GetInvalidNeighbourhood());
+            showSelfIntersections(eval.GetSelfIntersections());
+        }
+
+        qApp->restoreOverrideCursor();
+        d->ui.analyzeAllTogether->setEnabled(true);
+
+        if (!aborted && d->enableFoldsCheck)
+            on_analyzeFoldsButton_clicked();
+    }
 }
 
 void DlgEvaluateMeshImp::on_repairAllTogether_clicked()
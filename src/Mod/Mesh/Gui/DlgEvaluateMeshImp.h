@@ -132,6 +132,19 @@ protected:
     void removeViewProviders();
     void changeEvent(QEvent *e);
 
+    /** @name Show the results of the checks */
+    //@{
+    void showOrientation(const std::vector<unsigned long>&);
+    void showDuplicatedFaces(const std::vector<unsigned long>&);
+    void showDuplicatedPoints(const std::vector<unsigned long>&);
+    void showNonManifolds(const std::vector<std::pair<unsigned long, unsigned long> >&,
+                          const std::vector<unsigned long>&);
+    void showDegenerations(const std::vector<unsigned long>&);
+    void showIndices(const std::vector<unsigned long>&, const std::vector<unsigned long>&,
+                     const std::vector<unsigned long>&, const std::vector<unsigned long>&);
+    void showSelfIntersections(const std::vector<std::pair<unsigned long, unsigned long> >&);
+    //@}
+
 private:
     class Private;
     Private* d;
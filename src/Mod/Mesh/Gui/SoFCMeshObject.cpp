@@ -53,6 +53,7 @@
 #include <Gui/SoFCInteractiveElement.h>
 #include <Gui/SoFCSelectionAction.h>
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
 #include <Mod/Mesh/App/Core/MeshIO.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Mesh/App/Core/Elements.h>
@@ -334,7 +335,7 @@ SO_NODE_SOURCE(SoFCMeshPickNode)
 /*!
   Constructor.
 */
-SoFCMeshPickNode::SoFCMeshPickNode(void) : meshGrid(0)
+SoFCMeshPickNode::SoFCMeshPickNode(void) : meshGrid(0), meshTree(0)
 {
     SO_NODE_CONSTRUCTOR(SoFCMeshPickNode);
 
@@ -347,6 +348,7 @@ SoFCMeshPickNode::SoFCMeshPickNode(void) : meshGrid(0)
 SoFCMeshPickNode::~SoFCMeshPickNode()
 {
     delete meshGrid;
+    delete meshTree;
 }
 
 // Doc from superclass.
@@ -361,10 +363,18 @@ void SoFCMeshPickNode::notify(SoNotList *list)
     if (f == &mesh) {
         const Mesh::MeshObject* meshObject = mesh.getValue();
         if (meshObject) {
-            MeshCore::MeshAlgorithm alg(meshObject->getKernel());
-            float fAvgLen = alg.GetAverageEdgeLength();
             delete meshGrid;
-            meshGrid = new MeshCore::MeshFacetGrid(meshObject->getKernel(), 5.0f * fAvgLen);
+            delete meshTree;
+            meshGrid = 0;
+            meshTree = 0;
+            if (Mesh::MeshObject::useBoundingVolumeHierarchy()) {
+                meshTree = new MeshCore::MeshFacetBVH(meshObject->getKernel());
+            }
+            else {
+                MeshCore::MeshAlgorithm alg(meshObject->getKernel());
+                float fAvgLen = alg.GetAverageEdgeLength();
+                meshGrid = new MeshCore::MeshFacetGrid(meshObject->getKernel(), 5.0f * fAvgLen);
+            }
         }
     }
 }
@@ -389,7 +399,9 @@ void SoFCMeshPickNode::pick(SoPickAction * action)
     Base::Vector3f pt(pos[0],pos[1],pos[2]);
     Base::Vector3f dr(dir[0],dir[1],dir[2]);
     unsigned long index;
-    if (alg.NearestFacetOnRay(pt, dr, *meshGrid, pt, index)) {
+    bool found = meshTree ? alg.NearestFacetOnRay(pt, dr, *meshTree, pt, index)
+                          : alg.NearestFacetOnRay(pt, dr, *meshGrid, pt, index);
+    if (found) {
         SoPickedPoint* pp = raypick->addIntersection(SbVec3f(pt.x,pt.y,pt.z));
         if (pp) {
             SoFaceDetail* det = new SoFaceDetail();
@@ -38,7 +38,7 @@ typedef unsigned int GLuint;
 typedef int GLint;
 typedef float GLfloat;
 
-namespace MeshCore { class MeshFacetGrid; }
+namespace MeshCore { class MeshFacetGrid; class MeshFacetBVH; }
 
 namespace MeshGui {
 
@@ -97,6 +97,7 @@ protected:
 
 private:
     MeshCore::MeshFacetGrid* meshGrid;
+    MeshCore::MeshFacetBVH* meshTree;
 };
 
 // -------------------------------------------------------
@@ -26,6 +26,7 @@
 # ifdef FC_OS_LINUX
 #  include <unistd.h>
 # endif
+# include <memory>
 # include <Bnd_Box.hxx>
 # include <BndLib_Add3dCurve.hxx>
 # include <BRepAdaptor_Curve.hxx>
@@ -55,6 +56,7 @@
 #include <Mod/Mesh/App/Core/Algorithm.h>
 #include <Mod/Mesh/App/Core/Projection.h>
 #include <Mod/Mesh/App/Core/Grid.h>
+#include <Mod/Mesh/App/Core/BVH.h>
 #include <Mod/Mesh/App/Mesh.h>
 
 #include <Base/Exception.h>
@@ -70,6 +72,52 @@ using MeshCore::MeshAlgorithm;
 using MeshCore::MeshFacetGrid;
 using MeshCore::MeshFacet;
 
+namespace MeshPart {
+
+/**
+ * Casts rays and projects lines onto a mesh. By default a grid is used to find the
+ * facets, with the parameter BoundingVolumeHierarchy of the Mesh module it's a
+ * bounding volume hierarchy.
+ */
+class MeshRaySearch
+{
+public:
+    MeshRaySearch(const MeshKernel& rMesh, float fGridLen)
+      : _rcMesh(rMesh)
+    {
+        if (Mesh::MeshObject::useBoundingVolumeHierarchy())
+            _pTree.reset(new MeshCore::MeshFacetBVH(rMesh));
+        else
+            _pGrid.reset(new MeshFacetGrid(rMesh, fGridLen));
+    }
+
+    bool nearestFacetOnRay(const Base::Vector3f& pnt, const Base::Vector3f& dir,
+                           Base::Vector3f& res, unsigned long& index) const
+    {
+        MeshAlgorithm clAlg(_rcMesh);
+        if (_pTree)
+            return clAlg.NearestFacetOnRay(pnt, dir, *_pTree, res, index);
+        return clAlg.NearestFacetOnRay(pnt, dir, *_pGrid, res, index);
+    }
+
+    bool projectLineOnMesh(const Base::Vector3f& p1, unsigned long f1,
+                           const Base::Vector3f& p2, unsigned long f2,
+                           const Base::Vector3f& dir, std::vector<Base::Vector3f>& polyline) const
+    {
+        MeshCore::MeshProjection meshProjection(_rcMesh);
+        if (_pTree)
+            return meshProjection.projectLineOnMesh(*_pTree, p1, f1, p2, f2, dir, polyline);
+        return meshProjection.projectLineOnMesh(*_pGrid, p1, f1, p2, f2, dir, polyline);
+    }
+
+private:
+    const MeshKernel& _rcMesh;
+    std::unique_ptr<MeshFacetGrid> _pGrid;
+    std::unique_ptr<MeshCore::MeshFacetBVH> _pTree;
+};
+
+}
+
 CurveProjector::CurveProjector(const TopoDS_Shape &aShape, const MeshKernel &pMesh)
 : _Shape(aShape), _Mesh(pMesh)
 {
@@ -852,7 +900,7 @@ void MeshProjection::projectOnMesh(const std::vector<Base::Vector3f>& pointsIn,
     // calculate the average edge length and create a grid
     MeshAlgorithm clAlg(_rcMesh);
     float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f*fAvgLen);
+    MeshRaySearch cSearch(_rcMesh, 5.0f*fAvgLen);
 
     // get all boundary points and edges of the mesh
     std::vector<Base::Vector3f> boundaryPoints;
@@ -879,7 +927,7 @@ void MeshProjection::projectOnMesh(const std::vector<Base::Vector3f>& pointsIn,
     for (auto it : pointsIn) {
         Base::Vector3f result;
         unsigned long index;
-        if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
+        if (cSearch.nearestFacetOnRay(it, dir, result, index)) {
             MeshCore::MeshGeomFacet geomFacet = _rcMesh.GetFacet(index);
             if (tolerance > 0 && geomFacet.IntersectPlaneWithLine(it, dir, result)) {
                 if (geomFacet.IsPointOfFace(result, tolerance))
@@ -929,7 +977,7 @@ void MeshProjection::projectParallelToMesh (const TopoDS_Shape &aShape, const Ba
     // calculate the average edge length and create a grid
     MeshAlgorithm clAlg(_rcMesh);
     float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f*fAvgLen);
+    MeshRaySearch cSearch(_rcMesh, 5.0f*fAvgLen);
     TopExp_Explorer Ex;
 
     int iCnt=0;
@@ -950,7 +998,7 @@ void MeshProjection::projectParallelToMesh (const TopoDS_Shape &aShape, const Ba
         for (auto it : points) {
             Base::Vector3f result;
             unsigned long index;
-            if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
+            if (cSearch.nearestFacetOnRay(it, dir, result, index)) {
                 hitPoints.emplace_back(result, index);
 
                 if (hitPoints.size() > 1) {
@@ -961,12 +1009,11 @@ void MeshProjection::projectParallelToMesh (const TopoDS_Shape &aShape, const Ba
             }
         }
 
-        MeshCore::MeshProjection meshProjection(_rcMesh);
         PolyLine polyline;
         for (auto it : hitPointPairs) {
             points.clear();
-            if (meshProjection.projectLineOnMesh(cGrid, it.first.first, it.first.second,
-                                                 it.second.first, it.second.second, dir, points)) {
+            if (cSearch.projectLineOnMesh(it.first.first, it.first.second,
+                                          it.second.first, it.second.second, dir, points)) {
                 polyline.points.insert(polyline.points.end(), points.begin(), points.end());
             }
         }
@@ -981,7 +1028,7 @@ void MeshProjection::projectParallelToMesh (const std::vector<PolyLine> &aEdges,
     // calculate the average edge length and create a grid
     MeshAlgorithm clAlg(_rcMesh);
     float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f*fAvgLen);
+    MeshRaySearch cSearch(_rcMesh, 5.0f*fAvgLen);
 
     Base::SequencerLauncher seq( "Project curve on mesh", aEdges.size() );
 
@@ -995,7 +1042,7 @@ void MeshProjection::projectParallelToMesh (const std::vector<PolyLine> &aEdges,
         for (auto it : points) {
             Base::Vector3f result;
             unsigned long index;
-            if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
+            if (cSearch.nearestFacetOnRay(it, dir, result, index)) {
                 hitPoints.emplace_back(result, index);
 
                 if (hitPoints.size() > 1) {
@@ -1006,12 +1053,11 @@ void MeshProjection::projectParallelToMesh (const std::vector<PolyLine> &aEdges,
             }
         }
 
-        MeshCore::MeshProjection meshProjection(_rcMesh);
         PolyLine polyline;
         for (auto it : hitPointPairs) {
             points.clear();
-            if (meshProjection.projectLineOnMesh(cGrid, it.first.first, it.first.second,
-                                                 it.second.first, it.second.second, dir, points)) {
+            if (cSearch.projectLineOnMesh(it.first.first, it.first.second,
+                                          it.second.first, it.second.second, dir, points)) {
                 polyline.points.insert(polyline.points.end(), points.begin(), points.end());
             }
         }
@@ -54,6 +54,7 @@
 #include <string>
 #include <map>
 #include <vector>
+#include <memory>
 #include <set>
 #include <bitset>
 
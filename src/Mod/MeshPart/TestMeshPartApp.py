@@ -0,0 +1,67 @@
+#   (c) FreeCAD Developers 2021                                 LGPL        *
+#                                                                         *
+#   This file is part of the FreeCAD CAx development system.              *
+#                                                                         *
+#   This program is free software; you can redistribute it and/or modify  *
+#   it under the terms of the GNU Lesser General Public License (LGPL)    *
+#   as published by the Free Software Foundation; either version 2 of     *
+#   the License, or (at your option) any later version.                   *
+#   for detail see the LICENCE text file.                                 *
+#                                                                         *
+#   FreeCAD is distributed in the hope that it will be useful,            *
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+#   GNU Library General Public License for more details.                  *
+#                                                                         *
+#   You should have received a copy of the GNU Library General Public     *
+#   License along with FreeCAD; if not, write to the Free Software        *
+#   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+#   USA                                                                   *
+#**************************************************************************
+
+
+import FreeCAD, unittest, Mesh, MeshPart, Part
+from FreeCAD import Vector
+
+#---------------------------------------------------------------------------
+# define the test cases to test the FreeCAD MeshPart module
+#---------------------------------------------------------------------------
+
+
+class MeshPartSearchStructureCases(unittest.TestCase):
+    """The projections must be the same with a grid and a bounding volume hierarchy"""
+    def setUp(self):
+        self.mesh = Mesh.createSphere(10.0, 50)
+        self.param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Mesh")
+        self.bvh = self.param.GetBool("BoundingVolumeHierarchy", False)
+
+    def project(self, func, *args):
+        self.param.SetBool("BoundingVolumeHierarchy", False)
+        grid = func(*args)
+        self.param.SetBool("BoundingVolumeHierarchy", True)
+        tree = func(*args)
+        return grid, tree
+
+    def comparePoints(self, grid, tree):
+        self.assertEqual(len(grid), len(tree))
+        for p, q in zip(grid, tree):
+            self.assertAlmostEqual(p.distanceToPoint(q), 0.0, 4)
+
+    def testProjectPointsOnMesh(self):
+        points = [Vector(0.7 * x, 0.7 * y, 20.0) for x in range(-15, 16) for y in range(-15, 16)]
+        grid, tree = self.project(MeshPart.projectPointsOnMesh, points, self.mesh, Vector(0, 0, -1))
+        self.assertTrue(len(grid) > 0)
+        self.comparePoints(grid, tree)
+
+    def testProjectShapeOnMesh(self):
+        shape = Part.makeCompound([Part.makeLine(Vector(-8, -3, 20), Vector(8, 4, 20)),
+                                   Part.makeCircle(5.0, Vector(1, 1, 20))])
+        grid, tree = self.project(MeshPart.projectShapeOnMesh, shape, self.mesh, Vector(0, 0, -1))
+        self.assertEqual(len(grid), 2)
+        self.assertEqual(len(grid), len(tree))
+        for g, t in zip(grid, tree):
+            self.assertTrue(len(g) > 0)
+            self.comparePoints(g, t)
+
+    def tearDown(self):
+        self.param.SetBool("BoundingVolumeHierarchy", self.bvh)
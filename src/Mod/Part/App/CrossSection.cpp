@@ -27,17 +27,20 @@
 # include <BRepAlgoAPI_Common.hxx>
 # include <BRepAlgoAPI_Cut.hxx>
 # include <BRepAlgoAPI_Section.hxx>
+# include <BRepBuilderAPI_Copy.hxx>
 # include <BRepBuilderAPI_MakeFace.hxx>
 # include <BRepBuilderAPI_MakeWire.hxx>
 # include <BRepGProp_Face.hxx>
 # include <BRepPrimAPI_MakeHalfSpace.hxx>
 # include <gp_Pln.hxx>
 # include <Precision.hxx>
+# include <Standard_Version.hxx>
 # include <ShapeFix_Wire.hxx>
 # include <ShapeAnalysis_FreeBounds.hxx>
 # include <TopExp.hxx>
 # include <TopExp_Explorer.hxx>
 # include <TopTools_IndexedMapOfShape.hxx>
+# include <TopTools_ListOfShape.hxx>
 # include <TopTools_HSequenceOfShape.hxx>
 # include <TopoDS.hxx>
 # include <TopoDS_Edge.hxx>
@@ -75,7 +78,15 @@ std::list<TopoDS_Wire> CrossSection::slice(double d) const
 
 void CrossSection::sliceNonSolid(double d, const TopoDS_Shape& shape, std::list<TopoDS_Wire>& wires) const
 {
-    BRepAlgoAPI_Section cs(shape, gp_Pln(a,b,c,-d));
+    // The input shape must not be modified (e.g. its tolerances) because the
+    // same shape may be sliced at different heights in parallel
+#if OCC_VERSION_HEX >= 0x070100
+    BRepAlgoAPI_Section cs(shape, gp_Pln(a,b,c,-d), Standard_False);
+    cs.SetNonDestructive(Standard_True);
+    cs.Build();
+#else
+    BRepAlgoAPI_Section cs(BRepBuilderAPI_Copy(shape).Shape(), gp_Pln(a,b,c,-d));
+#endif
     if (cs.IsDone()) {
         std::list<TopoDS_Edge> edges;
         TopExp_Explorer xp;
@@ -113,7 +124,19 @@ void CrossSection::sliceSolid(double d, const TopoDS_Shape& shape, std::list<Top
 
     BRepPrimAPI_MakeHalfSpace mkSolid(face, refPoint);
     TopoDS_Solid solid = mkSolid.Solid();
-    BRepAlgoAPI_Cut mkCut(shape, solid);
+#if OCC_VERSION_HEX >= 0x070100
+    // see sliceNonSolid()
+    TopTools_ListOfShape arguments, tools;
+    arguments.Append(shape);
+    tools.Append(solid);
+    BRepAlgoAPI_Cut mkCut;
+    mkCut.SetArguments(arguments);
+    mkCut.SetTools(tools);
+    mkCut.SetNonDestructive(Standard_True);
+    mkCut.Build();
+#else
+    BRepAlgoAPI_Cut mkCut(BRepBuilderAPI_Copy(shape).Shape(), solid);
+#endif
 
     if (mkCut.IsDone()) {
         TopTools_IndexedMapOfShape mapOfFaces;
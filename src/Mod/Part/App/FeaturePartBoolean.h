@@ -49,6 +49,8 @@ public:
     /// recalculate the Feature
     App::DocumentObjectExecReturn *execute(void);
     short mustExecute() const;
+    /// the operation only reads the shapes of Base and Tool
+    bool canRecomputeInThread() const {return true;}
     //@}
 
     /// returns the type name of the ViewProvider
@@ -28,11 +28,11 @@
 # include <BRepAdaptor_Curve.hxx>
 # include <BRepAdaptor_Surface.hxx>
 # include <BRepBndLib.hxx>
+# include <BRepBuilderAPI_Copy.hxx>
 # include <BRepBuilderAPI_GTransform.hxx>
 # include <Bnd_Box.hxx>
 # include <BRepTools.hxx>
 # include <BRepTools_ShapeSet.hxx>
-# include <BRepBuilderAPI_Copy.hxx>
 # include <TopTools_HSequenceOfShape.hxx>
 # include <TopTools_MapOfShape.hxx>
 # include <TopoDS.hxx>
@@ -85,34 +85,73 @@ PropertyPartShape::~PropertyPartShape()
 void PropertyPartShape::setValue(const TopoShape& sh)
 {
     aboutToSetValue();
-    _Shape = sh;
+    discardDeferred();
+    _deferredTransform.reset();
+    setShape(sh);
     hasSetValue();
 }
 
 void PropertyPartShape::setValue(const TopoDS_Shape& sh)
 {
     aboutToSetValue();
-    _Shape.setShape(sh);
+    discardDeferred();
+    _deferredTransform.reset();
+    setShape(TopoShape(sh));
     hasSetValue();
 }
 
+void PropertyPartShape::setShape(const TopoShape& sh)
+{
+    // assigning the same topology again, e.g. with another location, keeps it shared
+    if (!sh.getShape().IsPartner(_Shape.getShape()))
+        _shapeShare.reset();
+    _Shape = sh;
+}
+
+bool PropertyPartShape::isShared() const
+{
+    return _shapeShare.use_count() > 1;
+}
+
+std::shared_ptr<PropertyPartShape::ShapeShare> PropertyPartShape::shareShape() const
+{
+    if (!_shapeShare)
+        _shapeShare = std::make_shared<ShapeShare>();
+    return _shapeShare;
+}
+
+void PropertyPartShape::detachShape()
+{
+    restoreDeferred();
+    if (isShared() && !_Shape.getShape().IsNull()) {
+        BRepBuilderAPI_Copy copy(_Shape.getShape());
+        TopoShape shape(_Shape);
+        shape.setShape(copy.Shape());
+        setShape(shape);
+    }
+}
+
 const TopoDS_Shape& PropertyPartShape::getValue(void)const
 {
+    restoreDeferred();
     return _Shape.getShape();
 }
 
 const TopoShape& PropertyPartShape::getShape() const
 {
+    restoreDeferred();
     return this->_Shape;
 }
 
 const Data::ComplexGeoData* PropertyPartShape::getComplexData() const
 {
+    restoreDeferred();
     return &(this->_Shape);
 }
 
 Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 {
+    restoreDeferred();
     Base::BoundBox3d box;
     if (_Shape.getShape().IsNull())
         return box;
@@ -139,13 +178,28 @@ Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 
 void PropertyPartShape::transformGeometry(const Base::Matrix4D &rclTrf)
 {
+    restoreDeferred();
     aboutToSetValue();
     _Shape.transformGeometry(rclTrf);
+    _shapeShare.reset();
     hasSetValue();
 }
 
+void PropertyPartShape::setTransform(const Base::Matrix4D &rclTrf)
+{
+    // The placement doesn't need the topology. It's applied to a pending
+    // shape once its data file is restored, see setRestoredValue().
+    if (isDeferred())
+        _deferredTransform.reset(new Base::Matrix4D(rclTrf));
+    else
+        _Shape.setTransform(rclTrf);
+}
+
 PyObject *PropertyPartShape::getPyObject(void)
 {
+    // The topology can be modified in place through Python, e.g. by
+    // fixTolerance() or the Tolerance attribute of a sub-shape
+    detachShape();
     Base::PyObjectBase* prop = static_cast<Base::PyObjectBase*>(_Shape.getPyObject());
     if (prop)
         prop->setConst();
@@ -167,12 +221,14 @@ void PropertyPartShape::setPyObject(PyObject *value)
 
 App::Property *PropertyPartShape::Copy(void) const
 {
+    // Note: The copy shares the topology with this property like Paste() does.
+    // Features replace their shape by a new one on recompute. Only a few methods
+    // modify a shape in place (e.g. fixTolerance()), which is why the shape is
+    // copied before it's handed out to Python (see detachShape()).
+    restoreDeferred();
     PropertyPartShape *prop = new PropertyPartShape();
     prop->_Shape = this->_Shape;
-    if (!_Shape.getShape().IsNull()) {
-        BRepBuilderAPI_Copy copy(_Shape.getShape());
-        prop->_Shape.setShape(copy.Shape());
-    }
+    prop->_shapeShare = shareShape();
 
     return prop;
 }
@@ -180,13 +236,22 @@ App::Property *PropertyPartShape::Copy(void) const
 void PropertyPartShape::Paste(const App::Property &from)
 {
     aboutToSetValue();
-    _Shape = dynamic_cast<const PropertyPartShape&>(from)._Shape;
+    discardDeferred();
+    _deferredTransform.reset();
+    const PropertyPartShape& prop = dynamic_cast<const PropertyPartShape&>(from);
+    _Shape = prop._Shape;
+    _shapeShare = prop.shareShape();
     hasSetValue();
 }
 
 unsigned int PropertyPartShape::getMemSize (void) const
 {
-    return _Shape.getMemSize();
+    // a shared topology is split between the properties holding it
+    unsigned int size = _Shape.getMemSize();
+    if (_shapeShare)
+        size /= _shapeShare.use_count();
+    // a shape not restored yet is estimated by the size of its data file
+    return size + getDeferredSize();
 }
 
 void PropertyPartShape::getPaths(std::vector<App::ObjectIdentifier> &paths) const
@@ -226,8 +291,8 @@ void PropertyPartShape::Restore(Base::XMLReader &reader)
     std::string file (reader.getAttribute("file") );
 
     if (!file.empty()) {
-        // initiate a file read
-        reader.addFile(file.c_str(),this);
+        // initiate a file read, which may be deferred until the shape is needed
+        addDeferredFile(reader, file.c_str());
     }
 }
 
@@ -277,6 +342,7 @@ static Standard_Boolean  BRepTools_Write(const TopoDS_Shape& Sh, const Standard_
 
 void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
 {
+    restoreDeferred();
     // If the shape is empty we simply store nothing. The file size will be 0 which
     // can be checked when reading in the data.
     if (_Shape.getShape().IsNull())
@@ -350,7 +416,7 @@ void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
     if (brep.hasExtension("bin")) {
         TopoShape shape;
         shape.importBinary(reader);
-        setValue(shape);
+        setRestoredValue(shape, reader);
     }
     else {
         bool direct = App::GetApplication().GetParameterGroupByPath
@@ -394,17 +460,33 @@ void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
 
             // delete the temp file
             fi.deleteFile();
-            setValue(shape);
+            setRestoredValue(TopoShape(shape), reader);
         }
         else {
             BRep_Builder builder;
             TopoDS_Shape shape;
             BRepTools::Read(shape, reader, builder);
-            setValue(shape);
+            setRestoredValue(TopoShape(shape), reader);
         }
     }
 }
 
+void PropertyPartShape::setRestoredValue(const TopoShape& shape, const Base::Reader& reader)
+{
+    // a deferred shape completes the restored document and thus isn't a change
+    if (reader.isDeferred()) {
+        TopoShape restored(shape);
+        if (_deferredTransform) {
+            restored.setTransform(*_deferredTransform);
+            _deferredTransform.reset();
+        }
+        setShape(restored);
+    }
+    else {
+        setValue(shape);
+    }
+}
+
 // -------------------------------------------------------------------------
 
 TYPESYSTEM_SOURCE(Part::PropertyShapeHistory , App::PropertyLists)
@@ -29,6 +29,7 @@
 #include <App/DocumentObject.h>
 #include <App/PropertyGeo.h>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace Part
@@ -61,6 +62,8 @@ public:
     //@{
     /// Transform the real shape data
     void transformGeometry(const Base::Matrix4D &rclMat);
+    /// Set the placement of the shape without notification
+    void setTransform(const Base::Matrix4D &rclTrf);
     //@}
 
     /** @name Getting basic geometric entities */
@@ -91,8 +94,23 @@ public:
     /// Get valid paths for this property; used by auto completer
     virtual void getPaths(std::vector<App::ObjectIdentifier> & paths) const;
 
+private:
+    void setRestoredValue(const TopoShape&, const Base::Reader&);
+    /** Copies of the property, e.g. by the undo stack, share the topology with
+     * this property. It must be detached before it can be modified in place.
+     */
+    bool isShared() const;
+    void detachShape();
+    void setShape(const TopoShape&);
+    struct ShapeShare {};
+    std::shared_ptr<ShapeShare> shareShape() const;
+
 private:
     TopoShape _Shape;
+    /// Held by all properties that share the topology, see Copy() and Paste()
+    mutable std::shared_ptr<ShapeShare> _shapeShare;
+    /// A placement set while the shape is pending, see setTransform()
+    std::unique_ptr<Base::Matrix4D> _deferredTransform;
 };
 
 struct PartExport ShapeHistory {
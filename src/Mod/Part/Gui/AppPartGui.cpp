@@ -31,6 +31,7 @@
 
 #include "AttacherTexts.h"
 #include "PropertyEnumAttacherItem.h"
+#include "PropertyTessellation.h"
 #include "SoBrepFaceSet.h"
 #include "SoBrepEdgeSet.h"
 #include "SoBrepPointSet.h"
@@ -149,6 +150,7 @@ PyMOD_INIT_FUNC(PartGui)
     PyModule_AddObject(partGuiModule, "AttachEngineResources", pAttachEngineTextsModule);
 
     PartGui::PropertyEnumAttacherItem               ::init();
+    PartGui::PropertyTessellation                   ::init();
     PartGui::SoBrepFaceSet                          ::initClass();
     PartGui::SoBrepEdgeSet                          ::initClass();
     PartGui::SoBrepPointSet                         ::initClass();
@@ -0,0 +1,242 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#include <Base/Reader.h>
+#include <Base/Stream.h>
+#include <Base/Writer.h>
+
+#include "PropertyTessellation.h"
+#include "ViewProviderExt.h"
+
+using namespace PartGui;
+
+namespace {
+
+// version of the binary format written by PropertyTessellation::SaveDocFile
+const uint32_t tessellationVersion = 1;
+
+void writeIndexes(Base::OutputStream &str, const std::vector<int32_t>& values)
+{
+    str << static_cast<uint32_t>(values.size());
+    for (std::vector<int32_t>::const_iterator it = values.begin(); it != values.end(); ++it)
+        str << *it;
+}
+
+void readIndexes(Base::InputStream &str, std::vector<int32_t>& values)
+{
+    uint32_t count = 0;
+    str >> count;
+    values.resize(count);
+    for (std::vector<int32_t>::iterator it = values.begin(); it != values.end(); ++it)
+        str >> *it;
+}
+
+void writePoints(Base::OutputStream &str, const std::vector<SbVec3f>& values)
+{
+    str << static_cast<uint32_t>(values.size());
+    for (std::vector<SbVec3f>::const_iterator it = values.begin(); it != values.end(); ++it)
+        str << (*it)[0] << (*it)[1] << (*it)[2];
+}
+
+void readPoints(Base::InputStream &str, std::vector<SbVec3f>& values)
+{
+    uint32_t count = 0;
+    str >> count;
+    values.resize(count);
+    float x, y, z;
+    for (std::vector<SbVec3f>::iterator it = values.begin(); it != values.end(); ++it) {
+        str >> x >> y >> z;
+        it->setValue(x, y, z);
+    }
+}
+
+// Checks that the restored arrays are consistent so that Coin cannot read out of bounds
+bool isValid(const ShapeTessellation& data)
+{
+    int32_t numNodes = static_cast<int32_t>(data.verts.size());
+    if (data.norms.size() > data.verts.size())
+        return false;
+    if (data.nodeStart < 0 || data.nodeStart > numNodes)
+        return false;
+
+    std::size_t numTriangles = 0;
+    for (std::vector<int32_t>::const_iterator it = data.parts.begin(); it != data.parts.end(); ++it) {
+        if (*it < 0)
+            return false;
+        numTriangles += *it;
+    }
+    if (numTriangles * 4 != data.faceIndex.size())
+        return false;
+
+    int32_t numNorms = static_cast<int32_t>(data.norms.size());
+    for (std::size_t i = 0; i < data.faceIndex.size(); i++) {
+        int32_t index = data.faceIndex[i];
+        if (i % 4 == 3 ? index != -1 : (index < 0 || index >= numNorms))
+            return false;
+    }
+    for (std::vector<int32_t>::const_iterator it = data.lines.begin(); it != data.lines.end(); ++it) {
+        if (*it < -1 || *it >= numNodes)
+            return false;
+    }
+    return true;
+}
+
+}
+
+TYPESYSTEM_SOURCE(PartGui::PropertyTessellation , App::Property)
+
+PropertyTessellation::PropertyTessellation()
+{
+}
+
+PropertyTessellation::~PropertyTessellation()
+{
+}
+
+void PropertyTessellation::setValue(const std::shared_ptr<const ShapeTessellation>& data)
+{
+    _Tessellation = data;
+}
+
+const std::shared_ptr<const ShapeTessellation>& PropertyTessellation::getValue() const
+{
+    return _Tessellation;
+}
+
+bool PropertyTessellation::hasSaveData() const
+{
+    ViewProviderPartExt* vp = dynamic_cast<ViewProviderPartExt*>(getContainer());
+    if (!vp || !vp->isTessellationCached())
+        return false;
+    return _Tessellation || vp->hasTessellation();
+}
+
+std::shared_ptr<const ShapeTessellation> PropertyTessellation::getSaveData() const
+{
+    ViewProviderPartExt* vp = dynamic_cast<ViewProviderPartExt*>(getContainer());
+    if (!vp || !vp->isTessellationCached())
+        return std::shared_ptr<const ShapeTessellation>();
+
+    // a tessellation restored but not used yet is still valid
+    if (_Tessellation)
+        return _Tessellation;
+    return vp->getTessellation();
+}
+
+void PropertyTessellation::Save (Base::Writer &writer) const
+{
+    // the arrays are only copied by SaveDocFile()
+    if (!writer.isForceXML()) {
+        writer.Stream() << writer.ind() << "<Tessellation file=\"" <<
+            (hasSaveData() ? writer.addFile("Tessellation.bin", this) : "") << "\"/>" << std::endl;
+    }
+}
+
+void PropertyTessellation::Restore(Base::XMLReader &reader)
+{
+    reader.readElement("Tessellation");
+    if (reader.hasAttribute("file")) {
+        std::string file (reader.getAttribute("file"));
+        if (!file.empty()) {
+            // initiate a file read
+            reader.addFile(file.c_str(),this);
+        }
+    }
+}
+
+void PropertyTessellation::SaveDocFile (Base::Writer &writer) const
+{
+    std::shared_ptr<const ShapeTessellation> data = getSaveData();
+    if (!data)
+        return;
+
+    Base::OutputStream str(writer.Stream());
+    str << tessellationVersion;
+    str << static_cast<uint32_t>(data->key.size());
+    writer.Stream().write(data->key.c_str(), data->key.size());
+    writePoints(str, data->verts);
+    writePoints(str, data->norms);
+    writeIndexes(str, data->faceIndex);
+    writeIndexes(str, data->parts);
+    writeIndexes(str, data->lines);
+    str << static_cast<int32_t>(data->nodeStart);
+}
+
+void PropertyTessellation::RestoreDocFile(Base::Reader &reader)
+{
+    _Tessellation.reset();
+
+    try {
+        Base::InputStream str(reader);
+        uint32_t version = 0;
+        str >> version;
+        if (version != tessellationVersion)
+            return;
+
+        std::shared_ptr<ShapeTessellation> data = std::make_shared<ShapeTessellation>();
+        uint32_t size = 0;
+        str >> size;
+        data->key.resize(size);
+        if (size > 0)
+            reader.read(&data->key[0], size);
+        readPoints(str, data->verts);
+        readPoints(str, data->norms);
+        readIndexes(str, data->faceIndex);
+        readIndexes(str, data->parts);
+        readIndexes(str, data->lines);
+        int32_t nodeStart = 0;
+        str >> nodeStart;
+        data->nodeStart = nodeStart;
+
+        if (reader.good() && !data->key.empty() && isValid(*data))
+            _Tessellation = data;
+    }
+    catch (const std::exception&) {
+        // an unusable cache only means that the shape gets tessellated again
+        _Tessellation.reset();
+    }
+}
+
+App::Property *PropertyTessellation::Copy(void) const
+{
+    PropertyTessellation *p= new PropertyTessellation();
+    p->_Tessellation = _Tessellation;
+    return p;
+}
+
+void PropertyTessellation::Paste(const App::Property &from)
+{
+    _Tessellation = dynamic_cast<const PropertyTessellation&>(from)._Tessellation;
+}
+
+unsigned int PropertyTessellation::getMemSize (void) const
+{
+    if (!_Tessellation)
+        return 0;
+    return static_cast<unsigned int>(_Tessellation->key.size()
+        + (_Tessellation->verts.size() + _Tessellation->norms.size()) * sizeof(SbVec3f)
+        + (_Tessellation->faceIndex.size() + _Tessellation->parts.size()
+           + _Tessellation->lines.size()) * sizeof(int32_t));
+}
@@ -0,0 +1,95 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef PARTGUI_PROPERTYTESSELLATION_H
+#define PARTGUI_PROPERTYTESSELLATION_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <Inventor/SbVec3f.h>
+#include <App/Property.h>
+
+namespace PartGui {
+
+/// The Inventor arrays of a tessellated shape as built by ViewProviderPartExt
+struct PartGuiExport ShapeTessellation
+{
+    /// identifies the shape and the mesh parameters, empty if not computed
+    std::string key;
+    std::vector<SbVec3f> verts;
+    std::vector<SbVec3f> norms;
+    std::vector<int32_t> faceIndex;
+    std::vector<int32_t> parts;
+    std::vector<int32_t> lines;
+    int nodeStart = 0;
+    int numEdges = 0;
+    double time = 0.0;
+    bool failed = false;
+};
+
+/** Stores the tessellation of a shape in the project file.
+ * When saving, the property takes the current representation from the
+ * ViewProviderPartExt it belongs to. When restoring, it keeps the loaded
+ * tessellation until the view provider has used it.
+ * The value is a cache and thus changes without notifying the container.
+ */
+class PartGuiExport PropertyTessellation : public App::Property
+{
+    TYPESYSTEM_HEADER();
+
+public:
+    PropertyTessellation();
+    ~PropertyTessellation();
+
+    /** @name Getter/setter */
+    //@{
+    void setValue(const std::shared_ptr<const ShapeTessellation>&);
+    const std::shared_ptr<const ShapeTessellation>& getValue() const;
+    //@}
+
+    /** @name Save/restore */
+    //@{
+    void Save (Base::Writer &writer) const;
+    void Restore(Base::XMLReader &reader);
+
+    void SaveDocFile (Base::Writer &writer) const;
+    void RestoreDocFile(Base::Reader &reader);
+
+    App::Property *Copy(void) const;
+    void Paste(const App::Property &from);
+    unsigned int getMemSize (void) const;
+    //@}
+
+private:
+    bool hasSaveData() const;
+    std::shared_ptr<const ShapeTessellation> getSaveData() const;
+
+private:
+    std::shared_ptr<const ShapeTessellation> _Tessellation;
+};
+
+} //namespace PartGui
+
+
+#endif // PARTGUI_PROPERTYTESSELLATION_H
@@ -28,6 +28,8 @@
 # include <Bnd_Box.hxx>
 # include <Poly_Polygon3D.hxx>
 # include <BRepBndLib.hxx>
+# include <BRep_Builder.hxx>
+# include <BRepBuilderAPI_Copy.hxx>
 # include <BRepBuilderAPI_MakeVertex.hxx>
 # include <BRepExtrema_DistShapeShape.hxx>
 # include <BRepMesh_IncrementalMesh.hxx>
@@ -94,10 +96,16 @@
 # include <Inventor/nodes/SoScale.h>
 # include <Inventor/nodes/SoLightModel.h>
 # include <QAction>
+# include <QCryptographicHash>
+# include <QFutureWatcher>
 # include <QMenu>
+# include <QThread>
+# include <QtConcurrentRun>
+# include <atomic>
 #endif
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost_bind_bind.hpp>
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
 #include <Base/Console.h>
@@ -108,6 +116,7 @@
 #include <App/Application.h>
 #include <App/Document.h>
 
+#include <Gui/ActionFunction.h>
 #include <Gui/SoFCUnifiedSelection.h>
 #include <Gui/SoFCSelectionAction.h>
 #include <Gui/Selection.h>
@@ -132,6 +141,79 @@ using namespace PartGui;
 
 PROPERTY_SOURCE(PartGui::ViewProviderPartExt, Gui::ViewProviderGeometryObject)
 
+namespace PartGui {
+
+struct ViewProviderPartExt::TessellationParams
+{
+    double deviation;
+    double angularDeflection;
+    bool normalsFromUV;
+    /// a restored tessellation, reused if its key matches the shape
+    std::shared_ptr<const ShapeTessellation> cached;
+};
+
+/// A tessellation running in the global thread pool
+class ViewProviderPartExt::TessellationJob
+{
+public:
+    TessellationJob()
+      : canceled(std::make_shared<std::atomic<bool> >(false))
+      , watcher(new QFutureWatcher<std::shared_ptr<const ShapeTessellation> >())
+      , notifier(new Gui::TimerFunction())
+    {
+    }
+    ~TessellationJob()
+    {
+        // The worker may still be busy. It only works on its own copy of
+        // the shape, so let it run out and drop its result.
+        *canceled = true;
+        QObject::disconnect(watcher, 0, notifier, 0);
+        watcher->deleteLater();
+        notifier->deleteLater();
+    }
+
+    /// Copies the triangulation of the tessellated copy onto the shape it was made of
+    void transferTriangulation() const
+    {
+        TopTools_IndexedMapOfShape faces, meshedFaces;
+        TopExp::MapShapes(shape, TopAbs_FACE, faces);
+        TopExp::MapShapes(meshed, TopAbs_FACE, meshedFaces);
+        TopTools_IndexedMapOfShape edges, meshedEdges;
+        TopExp::MapShapes(shape, TopAbs_EDGE, edges);
+        TopExp::MapShapes(meshed, TopAbs_EDGE, meshedEdges);
+        // the copy has the same topology, in the same order
+        if (faces.Extent() != meshedFaces.Extent() || edges.Extent() != meshedEdges.Extent())
+            return;
+
+        BRep_Builder builder;
+        for (int i=1; i <= faces.Extent(); i++) {
+            TopLoc_Location loc;
+            Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(TopoDS::Face(meshedFaces(i)), loc);
+            if (!mesh.IsNull())
+                builder.UpdateFace(TopoDS::Face(faces(i)), mesh);
+        }
+        for (int i=1; i <= edges.Extent(); i++) {
+            Handle(Poly_PolygonOnTriangulation) polygon;
+            Handle(Poly_Triangulation) mesh;
+            TopLoc_Location loc;
+            for (int j=1;; j++) {
+                BRep_Tool::PolygonOnTriangulation(TopoDS::Edge(meshedEdges(i)), polygon, mesh, loc, j);
+                if (polygon.IsNull())
+                    break;
+                builder.UpdateEdge(TopoDS::Edge(edges(i)), polygon, mesh, loc);
+            }
+        }
+    }
+
+    std::shared_ptr<std::atomic<bool> > canceled;
+    QFutureWatcher<std::shared_ptr<const ShapeTessellation> >* watcher;
+    Gui::TimerFunction* notifier;
+    /// the shape of the document object and the copy tessellated by the worker
+    TopoDS_Shape shape, meshed;
+};
+
+}
+
 
 void ViewProviderPartExt::getNormals(const TopoDS_Face&  theFace,
                                      const Handle(Poly_Triangulation)& aPolyTri,
@@ -233,6 +315,8 @@ const char* ViewProviderPartExt::DrawStyleEnums[]= {"Solid","Dashed","Dotted","D
 ViewProviderPartExt::ViewProviderPartExt() 
 {
     VisualTouched = true;
+    placeholderVisual = false;
+    tessellatedVisual = false;
     forceUpdateCount = 0;
     NormalsFromUV = true;
 
@@ -288,6 +372,8 @@ ViewProviderPartExt::ViewProviderPartExt()
     Lighting.setEnums(LightingEnums);
     ADD_PROPERTY_TYPE(DrawStyle,((long int)0), osgroup, App::Prop_None, "Defines the style of the edges in the 3D view.");
     DrawStyle.setEnums(DrawStyleEnums);
+    ADD_PROPERTY_TYPE(TessellationCache,(std::shared_ptr<const ShapeTessellation>()), osgroup,
+            App::Prop_Hidden, "Tessellation of the shape stored in the project file.");
 
     coords = new SoCoordinate3();
     coords->ref();
@@ -340,6 +426,7 @@ ViewProviderPartExt::ViewProviderPartExt()
 
 ViewProviderPartExt::~ViewProviderPartExt()
 {
+    cancelVisual();
     pcFaceBind->unref();
     pcLineBind->unref();
     pcPointBind->unref();
@@ -362,13 +449,13 @@ void ViewProviderPartExt::onChanged(const App::Property* prop)
     // to freeze the GUI
     // https://forum.freecadweb.org/viewtopic.php?f=3&t=24912&p=195613
     if (prop == &Deviation) {
-        if(isUpdateForced()||Visibility.getValue()) 
+        if((isUpdateForced()||Visibility.getValue()) && !testStatus(Gui::isRestoring))
             updateVisual();
         else
             VisualTouched = true;
     }
     if (prop == &AngularDeflection) {
-        if(isUpdateForced()||Visibility.getValue()) 
+        if((isUpdateForced()||Visibility.getValue()) && !testStatus(Gui::isRestoring))
             updateVisual();
         else
             VisualTouched = true;
@@ -470,7 +557,9 @@ void ViewProviderPartExt::onChanged(const App::Property* prop)
     }
     else {
         // if the object was invisible and has been changed, recreate the visual
-        if (prop == &Visibility && (isUpdateForced() || Visibility.getValue()) && VisualTouched) {
+        // (when restoring a document this is done by finishRestoring())
+        if (prop == &Visibility && (isUpdateForced() || Visibility.getValue()) && VisualTouched
+                && !testStatus(Gui::isRestoring)) {
             updateVisual();
             // The material has to be checked again (#0001736)
             onChanged(&DiffuseColor);
@@ -591,7 +680,9 @@ std::vector<std::string> ViewProviderPartExt::getDisplayModes(void) const
 std::string ViewProviderPartExt::getElement(const SoDetail* detail) const
 {
     std::stringstream str;
-    if (detail) {
+    // The bounding box shown until the tessellation is done has no sub-elements.
+    // Neither has the previous representation as the indices may have changed.
+    if (detail && !placeholderVisual && !pendingVisual) {
         if (detail->getTypeId() == SoFaceDetail::getClassTypeId()) {
             const SoFaceDetail* face_detail = static_cast<const SoFaceDetail*>(detail);
             int face = face_detail->getPartIndex() + 1;
@@ -625,6 +716,8 @@ SoDetail* ViewProviderPartExt::getDetail(const char* subelement) const
     SoDetail* detail = 0;
     if (index < 0)
         return detail;
+    // the detail is applied to the nodes of the final representation
+    const_cast<ViewProviderPartExt*>(this)->finishVisual();
     if (element == "Face") {
         detail = new SoFaceDetail();
         static_cast<SoFaceDetail*>(detail)->setPartIndex(index - 1);
@@ -693,6 +786,9 @@ std::vector<Base::Vector3d> ViewProviderPartExt::getSelectionShape(const char* /
 
 void ViewProviderPartExt::setHighlightedFaces(const std::vector<App::Color>& colors)
 {
+    if (pendingVisual)
+        return; // applied by finishVisual() to the new representation
+
     Gui::SoUpdateVBOAction action;
     action.apply(this->faceset);
 
@@ -719,6 +815,9 @@ void ViewProviderPartExt::setHighlightedFaces(const std::vector<App::Color>& col
 
 void ViewProviderPartExt::setHighlightedFaces(const std::vector<App::Material>& colors)
 {
+    if (pendingVisual)
+        return; // applied by finishVisual() to the new representation
+
     int size = static_cast<int>(colors.size());
     if (size > 1 && size == this->faceset->partIndex.getNum()) {
         pcFaceBind->value = SoMaterialBinding::PER_PART;
@@ -847,6 +946,9 @@ void ViewProviderPartExt::unsetHighlightedFaces()
 
 void ViewProviderPartExt::setHighlightedEdges(const std::vector<App::Color>& colors)
 {
+    if (pendingVisual)
+        return; // applied by finishVisual() to the new representation
+
     int size = static_cast<int>(colors.size());
     if (size > 1) {
         // Although indexed lineset is used the material binding must be PER_FACE!
@@ -882,6 +984,9 @@ void ViewProviderPartExt::unsetHighlightedEdges()
 
 void ViewProviderPartExt::setHighlightedPoints(const std::vector<App::Color>& colors)
 {
+    if (pendingVisual)
+        return; // applied by finishVisual() to the new representation
+
     int size = static_cast<int>(colors.size());
     if (size > 1) {
 #if 0
@@ -940,8 +1045,15 @@ void ViewProviderPartExt::updateData(const App::Property* prop)
     const char *propName = prop->getName();
     if (propName && (strcmp(propName, "Shape") == 0 || strstr(propName, "Touched") != nullptr)) {
         // calculate the visual only if visible
-        if (isUpdateForced() || Visibility.getValue())
+        if ((isUpdateForced() || Visibility.getValue()) && !testStatus(Gui::isRestoring)) {
             updateVisual();
+#if QT_VERSION >= 0x050500
+            // A script driving the GUI without an event loop would never get the
+            // result, and expects the representation to be up to date anyway
+            if (pendingVisual && QThread::currentThread()->loopLevel() == 0)
+                finishVisual();
+#endif
+        }
         else 
             VisualTouched = true;
 
@@ -955,6 +1067,83 @@ void ViewProviderPartExt::updateData(const App::Property* prop)
     Gui::ViewProviderGeometryObject::updateData(prop);
 }
 
+void ViewProviderPartExt::finishRestoring()
+{
+    Gui::ViewProviderGeometryObject::finishRestoring();
+
+    // the visual has been postponed until the tessellation cache is restored
+    if ((isUpdateForced() || Visibility.getValue()) && VisualTouched) {
+        updateVisual();
+        onChanged(&DiffuseColor);
+    }
+}
+
+namespace {
+
+// Returns a hash of the shape's topology and geometry together with the mesh parameters.
+// The shape is copied first to leave out any triangulation and its location.
+std::string computeTessellationKey(const TopoDS_Shape& shape, double deviation,
+                            double angularDeflection, bool normalsFromUV)
+{
+    BRepBuilderAPI_Copy copy(shape.Located(TopLoc_Location()), Standard_False);
+    std::ostringstream brep;
+    BRepTools::Write(copy.Shape(), brep);
+    std::string data = brep.str();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(data.c_str(), static_cast<int>(data.size()));
+
+    std::ostringstream key;
+    key << hash.result().toHex().constData() << ';' << deviation << ';'
+        << angularDeflection << ';' << (normalsFromUV ? 1 : 0);
+    return key.str();
+}
+
+bool ViewProviderPartExt::isTessellationCached()
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part");
+    return hGrp->GetBool("TessellationCache", false);
+}
+
+bool ViewProviderPartExt::hasTessellation() const
+{
+    return tessellatedVisual && !pendingVisual && !VisualTouched;
+}
+
+std::shared_ptr<const ShapeTessellation> ViewProviderPartExt::getTessellation() const
+{
+    if (!hasTessellation())
+        return std::shared_ptr<const ShapeTessellation>();
+
+    // the key is only computed when needed, i.e. when the document is saved
+    if (tessellationKey.empty()) {
+        try {
+            tessellationKey = computeTessellationKey(Part::Feature::getShape(getObject()),
+                Deviation.getValue(), AngularDeflection.getValue(), NormalsFromUV);
+        }
+        catch (...) {
+            // without a key the tessellation is just not cached
+            return std::shared_ptr<const ShapeTessellation>();
+        }
+    }
+
+    std::shared_ptr<ShapeTessellation> data = std::make_shared<ShapeTessellation>();
+    data->key = tessellationKey;
+    data->verts.assign(coords->point.getValues(0),
+                       coords->point.getValues(0) + coords->point.getNum());
+    data->norms.assign(norm->vector.getValues(0),
+                       norm->vector.getValues(0) + norm->vector.getNum());
+    data->faceIndex.assign(faceset->coordIndex.getValues(0),
+                           faceset->coordIndex.getValues(0) + faceset->coordIndex.getNum());
+    data->parts.assign(faceset->partIndex.getValues(0),
+                       faceset->partIndex.getValues(0) + faceset->partIndex.getNum());
+    data->lines.assign(lineset->coordIndex.getValues(0),
+                       lineset->coordIndex.getValues(0) + lineset->coordIndex.getNum());
+    data->nodeStart = nodeset->startIndex.getValue();
+    return data;
+}
+
 void ViewProviderPartExt::setupContextMenu(QMenu* menu, QObject* receiver, const char* member)
 {
     Gui::ViewProviderGeometryObject::setupContextMenu(menu, receiver, member);
@@ -998,7 +1187,7 @@ void ViewProviderPartExt::unsetEdit(int ModNum)
     }
 }
 
-void ViewProviderPartExt::updateVisual()
+void ViewProviderPartExt::clearHighlight()
 {
     Gui::SoUpdateVBOAction action;
     action.apply(this->faceset);
@@ -1014,22 +1203,224 @@ void ViewProviderPartExt::updateVisual()
     haction.apply(this->faceset);
     haction.apply(this->lineset);
     haction.apply(this->nodeset);
+}
+
+void ViewProviderPartExt::updateVisual()
+{
+    // a pending tessellation of the previous shape is of no use any more
+    cancelVisual();
 
     TopoDS_Shape cShape = Part::Feature::getShape(getObject());
     if (cShape.IsNull()) {
+        clearHighlight();
         coords  ->point      .setNum(0);
         norm    ->vector     .setNum(0);
         faceset ->coordIndex .setNum(0);
         faceset ->partIndex  .setNum(0);
         lineset ->coordIndex .setNum(0);
         nodeset ->startIndex .setValue(0);
+        placeholderVisual = false;
+        tessellatedVisual = false;
+        tessellationKey.clear();
+        VisualTouched = false;
+        return;
+    }
+
+    TessellationParams params;
+    params.deviation = Deviation.getValue();
+    params.angularDeflection = AngularDeflection.getValue();
+    params.normalsFromUV = NormalsFromUV;
+    if (isTessellationCached())
+        params.cached = TessellationCache.getValue();
+
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part");
+    if (!hGrp->GetBool("BackgroundTessellation", true)) {
+        std::shared_ptr<const ShapeTessellation> result = tessellate(cShape, params,
+            std::shared_ptr<std::atomic<bool> >());
+        applyVisual(*result);
+        TessellationCache.setValue(std::shared_ptr<const ShapeTessellation>());
         VisualTouched = false;
         return;
     }
 
+    try {
+        // The worker meshes a copy of the shape because the triangulation is stored
+        // inside the shape, which the GUI thread still uses (e.g. for the next recompute).
+        // The geometry is copied as well, the reference counts of the handles and the
+        // evaluation caches of OCC are not safe to share between threads.
+        BRepBuilderAPI_Copy copy(cShape, Standard_True);
+        if (coords->point.getNum() == 0)
+            showBoundBox(cShape);
+
+        pendingVisual.reset(new TessellationJob());
+        pendingVisual->shape = cShape;
+        pendingVisual->meshed = copy.Shape();
+        pendingVisual->notifier->setFunction(boost::bind(&ViewProviderPartExt::finishVisual, this));
+        QObject::connect(pendingVisual->watcher, SIGNAL(finished()),
+                         pendingVisual->notifier, SLOT(timeout()));
+        pendingVisual->watcher->setFuture(QtConcurrent::run(&ViewProviderPartExt::tessellate,
+            copy.Shape(), params, pendingVisual->canceled));
+    }
+    catch (...) {
+        pendingVisual.reset();
+        FC_ERR("Cannot compute Inventor representation for the shape of " << pcObject->getFullName());
+    }
+
+    VisualTouched = false;
+}
+
+void ViewProviderPartExt::finishVisual()
+{
+    if (!pendingVisual)
+        return;
+
+    std::unique_ptr<TessellationJob> job(std::move(pendingVisual));
+    job->watcher->waitForFinished();
+    std::shared_ptr<const ShapeTessellation> result = job->watcher->result();
+    if (!result)
+        return;
+
+    // like the tessellation on the GUI thread, leave the mesh in the shape of the
+    // document for the code relying on it (e.g. export, measurement)
+    if (!result->failed)
+        job->transferTriangulation();
+
+    applyVisual(*result);
+    // a restored tessellation is either in use now or outdated
+    TessellationCache.setValue(std::shared_ptr<const ShapeTessellation>());
+
+    // colors set in the meantime could not be applied to the outdated nodes
+    setHighlightedFaces(DiffuseColor.getValues());
+    setHighlightedEdges(LineColorArray.getValues());
+    setHighlightedPoints(PointColorArray.getValues());
+    if (this->faceset->partIndex.getNum() > this->pcShapeMaterial->diffuseColor.getNum())
+        this->pcFaceBind->value = SoMaterialBinding::OVERALL;
+}
+
+void ViewProviderPartExt::cancelVisual()
+{
+    pendingVisual.reset();
+}
+
+void ViewProviderPartExt::showBoundBox(const TopoDS_Shape& shape)
+{
+    Bnd_Box bounds;
+    BRepBndLib::Add(shape.Located(TopLoc_Location()), bounds);
+    bounds.SetGap(0.0);
+    if (bounds.IsVoid())
+        return;
+    Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+    bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+
+    clearHighlight();
+
+    coords->point.setNum(8);
+    SbVec3f* verts = coords->point.startEditing();
+    for (int i=0; i<8; i++) {
+        verts[i].setValue((float)(i & 1 ? xMax : xMin),
+                          (float)(i & 2 ? yMax : yMin),
+                          (float)(i & 4 ? zMax : zMin));
+    }
+    coords->point.finishEditing();
+
+    static const int32_t boxLines[] = {
+        0,1,-1, 2,3,-1, 4,5,-1, 6,7,-1,
+        0,2,-1, 1,3,-1, 4,6,-1, 5,7,-1,
+        0,4,-1, 1,5,-1, 2,6,-1, 3,7,-1
+    };
+    lineset ->coordIndex .setNum(sizeof(boxLines)/sizeof(int32_t));
+    lineset ->coordIndex .setValues(0, sizeof(boxLines)/sizeof(int32_t), boxLines);
+    norm    ->vector     .setNum(0);
+    faceset ->coordIndex .setNum(0);
+    faceset ->partIndex  .setNum(0);
+    nodeset ->startIndex .setValue(8);
+    placeholderVisual = true;
+    tessellatedVisual = false;
+    tessellationKey.clear();
+}
+
+void ViewProviderPartExt::applyVisual(const ShapeTessellation& data)
+{
+    clearHighlight();
+
+    if (data.failed) {
+        FC_ERR("Cannot compute Inventor representation for the shape of " << pcObject->getFullName());
+        tessellatedVisual = false;
+        tessellationKey.clear();
+        return;
+    }
+
+    int numNodes = static_cast<int>(data.verts.size());
+    int numNorms = static_cast<int>(data.norms.size());
+    int numIndexes = static_cast<int>(data.faceIndex.size());
+    int numFaces = static_cast<int>(data.parts.size());
+    int numLines = static_cast<int>(data.lines.size());
+
+    // create memory for the nodes and indexes
+    coords  ->point      .setNum(numNodes);
+    norm    ->vector     .setNum(numNorms);
+    faceset ->coordIndex .setNum(numIndexes);
+    faceset ->partIndex  .setNum(numFaces);
+    lineset ->coordIndex .setNum(numLines);
+
+    // get the raw memory for fast fill up
+    std::copy(data.verts.begin(), data.verts.end(), coords->point.startEditing());
+    std::copy(data.norms.begin(), data.norms.end(), norm->vector.startEditing());
+    std::copy(data.faceIndex.begin(), data.faceIndex.end(), faceset->coordIndex.startEditing());
+    std::copy(data.parts.begin(), data.parts.end(), faceset->partIndex.startEditing());
+    std::copy(data.lines.begin(), data.lines.end(), lineset->coordIndex.startEditing());
+    nodeset->startIndex.setValue(data.nodeStart);
+
+    // end the editing of the nodes
+    coords  ->point       .finishEditing();
+    norm    ->vector      .finishEditing();
+    faceset ->coordIndex  .finishEditing();
+    faceset ->partIndex   .finishEditing();
+    lineset ->coordIndex  .finishEditing();
+    placeholderVisual = false;
+    tessellatedVisual = true;
+    // empty unless restored, see getTessellation()
+    tessellationKey = data.key;
+
+#   ifdef FC_DEBUG
+        // printing some information
+        Base::Console().Log("ViewProvider update time: %f s\n",data.time);
+        Base::Console().Log("Shape tria info: Faces:%d Edges:%d Nodes:%d Triangles:%d IdxVec:%d\n",
+                            numFaces,data.numEdges,numNodes,numIndexes/4,numLines);
+#   endif
+}
+
+}
+
+std::shared_ptr<const ShapeTessellation> ViewProviderPartExt::tessellate(TopoDS_Shape cShape,
+        TessellationParams params, std::shared_ptr<std::atomic<bool> > canceled)
+{
+    std::shared_ptr<ShapeTessellation> data = std::make_shared<ShapeTessellation>();
+    auto isCanceled = [&canceled]() {
+        return canceled && canceled->load();
+    };
+
+    if (isCanceled())
+        return std::shared_ptr<ShapeTessellation>();
+
+    const double deviation = params.deviation;
+    const double angularDeflection = params.angularDeflection;
+    const bool normalsFromUV = params.normalsFromUV;
+    if (params.cached) {
+        try {
+            data->key = computeTessellationKey(cShape, deviation, angularDeflection, normalsFromUV);
+        }
+        catch (...) {
+            // without a key the restored tessellation is just not used
+        }
+        if (!data->key.empty() && params.cached->key == data->key)
+            return params.cached;
+    }
+
     // time measurement and book keeping
     Base::TimeInfo start_time;
-    int numTriangles=0,numNodes=0,numNorms=0,numFaces=0,numEdges=0,numLines=0;
+    int numTriangles=0,numNodes=0,numNorms=0,numFaces=0;
     std::set<int> faceEdges;
 
     try {
@@ -1040,16 +1431,20 @@ void ViewProviderPartExt::updateVisual()
         Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
         bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
         Standard_Real deflection = ((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 *
-            Deviation.getValue();
+            deviation;
 
         // create or use the mesh on the data structure
 #if OCC_VERSION_HEX >= 0x060600
-        Standard_Real AngDeflectionRads = AngularDeflection.getValue() / 180.0 * M_PI;
+        Standard_Real AngDeflectionRads = angularDeflection / 180.0 * M_PI;
         BRepMesh_IncrementalMesh(cShape,deflection,Standard_False,
                 AngDeflectionRads,Standard_True);
 #else
+        (void)angularDeflection;
         BRepMesh_IncrementalMesh(cShape,deflection);
 #endif
+        if (isCanceled())
+            return std::shared_ptr<ShapeTessellation>();
+
         // We must reset the location here because the transformation data
         // are set in the placement property
         TopLoc_Location aLoc;
@@ -1085,7 +1480,7 @@ void ViewProviderPartExt::updateVisual()
         // count and index the edges
         for (int i=1; i <= edgeMap.Extent(); i++) {
             edgeIdxSet.insert(i);
-            numEdges++;
+            data->numEdges++;
 
             const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
             TopLoc_Location aLoc;
@@ -1112,23 +1507,21 @@ void ViewProviderPartExt::updateVisual()
         TopExp::MapShapes(cShape, TopAbs_VERTEX, vertexMap);
         numNodes += vertexMap.Extent();
 
-        // create memory for the nodes and indexes
-        coords  ->point      .setNum(numNodes);
-        norm    ->vector     .setNum(numNorms);
-        faceset ->coordIndex .setNum(numTriangles*4);
-        faceset ->partIndex  .setNum(numFaces);
-        // get the raw memory for fast fill up
-        SbVec3f* verts = coords  ->point       .startEditing();
-        SbVec3f* norms = norm    ->vector      .startEditing();
-        int32_t* index = faceset ->coordIndex  .startEditing();
-        int32_t* parts = faceset ->partIndex   .startEditing();
-
-        // preset the normal vector with null vector
-        for (int i=0;i < numNorms;i++)
-            norms[i]= SbVec3f(0.0,0.0,0.0);
+        // create memory for the nodes and indexes, the normals are preset with the null vector
+        data->verts.resize(numNodes);
+        data->norms.resize(numNorms, SbVec3f(0.0,0.0,0.0));
+        data->faceIndex.resize(numTriangles*4);
+        data->parts.resize(numFaces);
+        SbVec3f* verts = data->verts.data();
+        SbVec3f* norms = data->norms.data();
+        int32_t* index = data->faceIndex.data();
+        int32_t* parts = data->parts.data();
 
         int ii = 0,faceNodeOffset=0,faceTriaOffset=0;
         for (int i=1; i <= faceMap.Extent(); i++, ii++) {
+            if (isCanceled())
+                return std::shared_ptr<ShapeTessellation>();
+
             TopLoc_Location aLoc;
             const TopoDS_Face &actFace = TopoDS::Face(faceMap(i));
             // get the mesh of the shape
@@ -1154,9 +1547,9 @@ void ViewProviderPartExt::updateVisual()
             const Poly_Array1OfTriangle& Triangles = mesh->Triangles();
             const TColgp_Array1OfPnt& Nodes = mesh->Nodes();
             TColgp_Array1OfDir Normals (Nodes.Lower(), Nodes.Upper());
-            if (NormalsFromUV)
+            if (normalsFromUV)
                 getNormals(actFace, mesh, Normals);
-            
+
             for (int g=1;g<=nbTriInFace;g++) {
                 // Get the triangle
                 Standard_Integer N1,N2,N3;
@@ -1174,7 +1567,7 @@ void ViewProviderPartExt::updateVisual()
 
                 // get the 3 normals of this triangle
                 gp_Vec NV1, NV2, NV3;
-                if (NormalsFromUV) {
+                if (normalsFromUV) {
                     NV1.SetXYZ(Normals(N1).XYZ());
                     NV2.SetXYZ(Normals(N2).XYZ());
                     NV3.SetXYZ(Normals(N3).XYZ());
@@ -1194,7 +1587,7 @@ void ViewProviderPartExt::updateVisual()
                     V1.Transform(myTransf);
                     V2.Transform(myTransf);
                     V3.Transform(myTransf);
-                    if (NormalsFromUV) {
+                    if (normalsFromUV) {
                         NV1.Transform(myTransf);
                         NV2.Transform(myTransf);
                         NV3.Transform(myTransf);
@@ -1229,12 +1622,12 @@ void ViewProviderPartExt::updateVisual()
                 edgeVector.push_back((int32_t)edgeIndex-1);
                 // already processed this index ?
                 if (edgeIdxSet.find(edgeIndex)!=edgeIdxSet.end()) {
-                    
+
                     // this holds the indices of the edge's triangulation to the current polygon
                     Handle(Poly_PolygonOnTriangulation) aPoly = BRep_Tool::PolygonOnTriangulation(curEdge, mesh, aLoc);
                     if (aPoly.IsNull())
                         continue; // polygon does not exist
-                    
+
                     // getting the indexes of the edge polygon
                     const TColStd_Array1OfInteger& indices = aPoly->Nodes();
                     for (Standard_Integer i=indices.Lower();i <= indices.Upper();i++) {
@@ -1259,7 +1652,7 @@ void ViewProviderPartExt::updateVisual()
             }
 
             edgeVector.push_back(-1);
-            
+
             // counting up the per Face offsets
             faceNodeOffset += nbNodesInFace;
             faceTriaOffset += nbTriInFace;
@@ -1300,50 +1693,30 @@ void ViewProviderPartExt::updateVisual()
             }
         }
 
-        nodeset->startIndex.setValue(faceNodeOffset);
+        data->nodeStart = faceNodeOffset;
         for (int i=0; i<vertexMap.Extent(); i++) {
             const TopoDS_Vertex& aVertex = TopoDS::Vertex(vertexMap(i+1));
             gp_Pnt pnt = BRep_Tool::Pnt(aVertex);
             verts[faceNodeOffset+i].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
         }
 
-        // normalize all normals 
+        // normalize all normals
         for (int i = 0; i< numNorms ;i++)
             norms[i].normalize();
-        
-        std::vector<int32_t> lineSetCoords;
+
         for (std::map<int, std::vector<int32_t> >::iterator it = lineSetMap.begin(); it != lineSetMap.end(); ++it) {
-            lineSetCoords.insert(lineSetCoords.end(), it->second.begin(), it->second.end());
-            lineSetCoords.push_back(-1);
+            data->lines.insert(data->lines.end(), it->second.begin(), it->second.end());
+            data->lines.push_back(-1);
         }
-
-        // preset the index vector size
-        numLines =  lineSetCoords.size();
-        lineset ->coordIndex .setNum(numLines);
-        int32_t* lines = lineset ->coordIndex  .startEditing();
-
-        int l=0;
-        for (std::vector<int32_t>::const_iterator it=lineSetCoords.begin();it!=lineSetCoords.end();++it,l++)
-            lines[l] = *it;
-
-        // end the editing of the nodes
-        coords  ->point       .finishEditing();
-        norm    ->vector      .finishEditing();
-        faceset ->coordIndex  .finishEditing();
-        faceset ->partIndex   .finishEditing();
-        lineset ->coordIndex  .finishEditing();
     }
     catch (...) {
-        FC_ERR("Cannot compute Inventor representation for the shape of " << pcObject->getFullName());
+        data->failed = true;
     }
 
-#   ifdef FC_DEBUG
-        // printing some information
-        Base::Console().Log("ViewProvider update time: %f s\n",Base::TimeInfo::diffTimeF(start_time,Base::TimeInfo()));
-        Base::Console().Log("Shape tria info: Faces:%d Edges:%d Nodes:%d Triangles:%d IdxVec:%d\n",numFaces,numEdges,numNodes,numTriangles,numLines);
-#   endif
-    VisualTouched = false;
+    data->time = Base::TimeInfo::diffTimeF(start_time,Base::TimeInfo());
+    return data;
 }
+
 void ViewProviderPartExt::forceUpdate(bool enable) {
     if(enable) {
         if(++forceUpdateCount == 1) {
@@ -32,8 +32,11 @@
 #include <TColgp_Array1OfDir.hxx>
 #include <App/PropertyUnits.h>
 #include <Gui/ViewProviderGeometryObject.h>
+#include <atomic>
 #include <map>
+#include <memory>
 #include <Mod/Part/App/PartFeature.h>
+#include "PropertyTessellation.h"
 
 class TopoDS_Shape;
 class TopoDS_Edge;
@@ -90,6 +93,8 @@ public:
     App::PropertyColorList LineColorArray;
     // Faces (Gui::ViewProviderGeometryObject::ShapeColor and Gui::ViewProviderGeometryObject::ShapeMaterial apply)
     App::PropertyColorList DiffuseColor;
+    // Tessellation stored in the project file
+    PropertyTessellation TessellationCache;
 
     virtual void attach(App::DocumentObject *) override;
     virtual void setDisplayMode(const char* ModeName) override;
@@ -101,6 +106,21 @@ public:
     bool changeFaceColors();
 
     virtual void updateData(const App::Property*) override;
+    virtual void finishRestoring() override;
+
+    /** @name Tessellation cache
+     * If enabled by the user parameter Mod/Part/TessellationCache the tessellation
+     * is saved with the document and reused when it is opened again, as long as
+     * the shape and the mesh parameters are unchanged.
+     */
+    //@{
+    static bool isTessellationCached();
+    /// checks cheaply whether the nodes hold the tessellation of the current shape
+    bool hasTessellation() const;
+    /// returns the current representation or null if it isn't a valid cache entry,
+    /// the shape's key is only computed here and when a cached entry is checked
+    std::shared_ptr<const ShapeTessellation> getTessellation() const;
+    //@}
 
     /** @name Selection handling
      * This group of methods do the selection handling.
@@ -157,9 +177,19 @@ protected:
     /// get called by the container whenever a property has been changed
     virtual void onChanged(const App::Property* prop) override;
     bool loadParameter();
+    /** Rebuilds the Inventor representation of the shape. Unless disabled by the
+     * user parameter Mod/Part/BackgroundTessellation the shape is tessellated in a
+     * worker thread while the previous representation (or the bounding box) stays
+     * visible. A newer call cancels the pending tessellation, getDetail() and
+     * updateData() without a running event loop wait for it.
+     */
     void updateVisual();
-    void getNormals(const TopoDS_Face&  theFace, const Handle(Poly_Triangulation)& aPolyTri,
-                    TColgp_Array1OfDir& theNormals);
+    /// Waits for the pending tessellation and applies it to the Inventor nodes
+    void finishVisual();
+    /// Drops the pending tessellation
+    void cancelVisual();
+    static void getNormals(const TopoDS_Face&  theFace, const Handle(Poly_Triangulation)& aPolyTri,
+                           TColgp_Array1OfDir& theNormals);
 
     // nodes for the data representation
     SoMaterialBinding * pcFaceBind;
@@ -182,6 +212,20 @@ protected:
     bool NormalsFromUV;
 
 private:
+    class TessellationJob;
+    struct TessellationParams;
+    static std::shared_ptr<const ShapeTessellation> tessellate(TopoDS_Shape, TessellationParams,
+        std::shared_ptr<std::atomic<bool> > canceled);
+    void applyVisual(const ShapeTessellation&);
+    void showBoundBox(const TopoDS_Shape&);
+    void clearHighlight();
+
+    std::unique_ptr<TessellationJob> pendingVisual;
+    bool placeholderVisual;
+    /// true while the nodes hold the tessellation of the shape
+    bool tessellatedVisual;
+    mutable std::string tessellationKey;
+
     // settings stuff
     int forceUpdateCount;
     static App::PropertyFloatConstraint::Constraints sizeRange;
@@ -21,6 +21,7 @@
 
 import FreeCAD, unittest, Part
 import copy 
+import os, tempfile
 from FreeCAD import Units
 App = FreeCAD
 
@@ -40,6 +41,82 @@ class PartTestCases(unittest.TestCase):
         self.Doc.recompute()
         self.failUnless(len(self.Box.Shape.Faces)==6)
 
+    def testLazyLoading(self):
+        self.Doc.addObject("Part::Box","Box")
+        self.Doc.recompute()
+        fileName = tempfile.gettempdir() + os.sep + "PartLazyLoading.FCStd"
+        self.Doc.saveAs(fileName)
+        FreeCAD.closeDocument("PartTest")
+
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+        lazy = param.GetBool("LazyLoading", False)
+        param.SetBool("LazyLoading", True)
+        try:
+            self.Doc = FreeCAD.openDocument(fileName)
+        finally:
+            param.SetBool("LazyLoading", lazy)
+
+        box = self.Doc.getObject("Box")
+        self.assertAlmostEqual(box.Shape.Volume, 1000.0)
+        self.assertFalse(box.isTouched())
+        self.assertFalse("Touched" in self.Doc.State)
+
+        # the data must still be there after overwriting the project file
+        self.Doc.save()
+        FreeCAD.closeDocument(self.Doc.Name)
+        self.Doc = FreeCAD.openDocument(fileName)
+        self.assertAlmostEqual(self.Doc.getObject("Box").Shape.Volume, 1000.0)
+        FreeCAD.closeDocument(self.Doc.Name)
+        self.Doc = FreeCAD.newDocument("PartTest")
+        os.remove(fileName)
+
+    def testLazyLoadingPlacement(self):
+        feature = self.Doc.addObject("Part::Feature","Shape")
+        feature.Shape = Part.makeBox(10, 10, 10)
+        feature.Placement = App.Placement(App.Vector(0, 5, 0), App.Rotation())
+        fileName = tempfile.gettempdir() + os.sep + "PartLazyLoadingPlacement.FCStd"
+        self.Doc.saveAs(fileName)
+        FreeCAD.closeDocument("PartTest")
+
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+        lazy = param.GetBool("LazyLoading", False)
+        param.SetBool("LazyLoading", True)
+        try:
+            self.Doc = FreeCAD.openDocument(fileName)
+        finally:
+            param.SetBool("LazyLoading", lazy)
+
+        # the placement set before the shape is restored must be kept
+        feature = self.Doc.getObject("Shape")
+        feature.Placement = App.Placement(App.Vector(5, 0, 0), App.Rotation())
+        shape = feature.Shape
+        self.assertAlmostEqual(shape.Volume, 1000.0)
+        self.assertAlmostEqual(shape.BoundBox.XMin, 5.0)
+        self.assertAlmostEqual(shape.BoundBox.YMin, 0.0)
+        self.assertEqual(shape.Placement, feature.Placement)
+        FreeCAD.closeDocument(self.Doc.Name)
+        self.Doc = FreeCAD.newDocument("PartTest")
+        os.remove(fileName)
+
+    def testUndoAfterFixTolerance(self):
+        # the undo copy shares the topology with the shape of the feature,
+        # modifying the shape in place must not change the undo copy
+        self.Doc.UndoMode = 1
+        feature = self.Doc.addObject("Part::Feature","Box")
+        feature.Shape = Part.makeBox(1, 1, 1)
+        tolerance = feature.Shape.getTolerance(1)
+
+        self.Doc.openTransaction("Tolerance")
+        feature.Shape = feature.Shape
+        shape = feature.Shape
+        shape.fixTolerance(0.5)
+        feature.Shape = shape
+        self.Doc.commitTransaction()
+        self.assertAlmostEqual(feature.Shape.getTolerance(1), 0.5)
+
+        self.Doc.undo()
+        self.assertAlmostEqual(feature.Shape.getTolerance(1), tolerance)
+
     def testIssue2985(self):
         v1 = App.Vector(0.0,0.0,0.0)
         v2 = App.Vector(10.0,0.0,0.0)
@@ -19,7 +19,7 @@
 #   USA                                                                   *
 #**************************************************************************
 
-import FreeCAD, FreeCADGui, os, sys, unittest, Part, PartGui
+import FreeCAD, FreeCADGui, os, sys, unittest, tempfile, struct, zipfile, Part, PartGui
 
 
 #---------------------------------------------------------------------------
@@ -41,3 +41,74 @@ import FreeCAD, FreeCADGui, os, sys, unittest, Part, PartGui
 #	def tearDown(self):
 #		#closing doc
 #		FreeCAD.closeDocument("PartGuiTest")
+
+
+class PartGuiTessellationCases(unittest.TestCase):
+    def setUp(self):
+        self.Doc = FreeCAD.newDocument("PartGuiTest")
+        self.fileName = tempfile.gettempdir() + os.sep + "PartGuiTessellation.FCStd"
+        self.param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part")
+        self.cache = self.param.GetBool("TessellationCache", False)
+        self.background = self.param.GetBool("BackgroundTessellation", True)
+        self.param.SetBool("TessellationCache", True)
+        self.param.SetBool("BackgroundTessellation", False)
+
+    def maxX(self, obj):
+        from pivy import coin
+        sa = coin.SoSearchAction()
+        sa.setType(coin.SoCoordinate3.getClassTypeId())
+        sa.setInterest(coin.SoSearchAction.FIRST)
+        sa.apply(obj.ViewObject.RootNode)
+        coords = sa.getPath().getTail()
+        return max([v.getValue()[0] for v in coords.point.getValues()])
+
+    def scaleTessellation(self, factor, otherKey=False):
+        # Tessellation.bin: version, key, then the vertices (count, x, y, z...)
+        with zipfile.ZipFile(self.fileName) as zf:
+            files = [(i, zf.read(i.filename)) for i in zf.infolist()]
+        with zipfile.ZipFile(self.fileName, "w", zipfile.ZIP_DEFLATED) as zf:
+            for info, data in files:
+                if info.filename.startswith("Tessellation"):
+                    keylen = struct.unpack_from("<I", data, 4)[0]
+                    offset = 8 + keylen
+                    if otherKey:
+                        data = data[:8] + b"0" * keylen + data[offset:]
+                    count = struct.unpack_from("<I", data, offset)[0]
+                    values = struct.unpack_from("<%df" % (3 * count), data, offset + 4)
+                    values = [v * factor for v in values]
+                    data = data[:offset + 4] + struct.pack("<%df" % (3 * count), *values) \
+                         + data[offset + 4 + 12 * count:]
+                zf.writestr(info, data)
+
+    def testTessellationCache(self):
+        box = self.Doc.addObject("Part::Box","Box")
+        self.Doc.recompute()
+        self.assertAlmostEqual(self.maxX(box), 10.0, 5)
+        self.Doc.saveAs(self.fileName)
+        FreeCAD.closeDocument(self.Doc.Name)
+
+        # the restored tessellation is shown as long as the shape is unchanged
+        self.scaleTessellation(2.0)
+        self.Doc = FreeCAD.openDocument(self.fileName)
+        box = self.Doc.getObject("Box")
+        self.assertAlmostEqual(self.maxX(box), 20.0, 5)
+
+        # and is dropped as soon as the shape changes
+        box.Length = 5
+        self.Doc.recompute()
+        self.assertAlmostEqual(self.maxX(box), 5.0, 5)
+
+        # a tessellation saved for another shape is not used
+        self.Doc.save()
+        FreeCAD.closeDocument(self.Doc.Name)
+        self.scaleTessellation(2.0, True)
+        self.Doc = FreeCAD.openDocument(self.fileName)
+        box = self.Doc.getObject("Box")
+        self.assertAlmostEqual(self.maxX(box), 5.0, 5)
+
+    def tearDown(self):
+        self.param.SetBool("TessellationCache", self.cache)
+        self.param.SetBool("BackgroundTessellation", self.background)
+        FreeCAD.closeDocument(self.Doc.Name)
+        if os.path.exists(self.fileName):
+            os.remove(self.fileName)
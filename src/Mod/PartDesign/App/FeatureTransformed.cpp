@@ -30,6 +30,7 @@
 # include <TopExp.hxx>
 # include <TopExp_Explorer.hxx>
 # include <TopTools_IndexedMapOfShape.hxx>
+# include <TopTools_ListOfShape.hxx>
 # include <Precision.hxx>
 # include <BRepBuilderAPI_Copy.hxx>
 # include <BRepBndLib.hxx>
@@ -250,6 +251,10 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
     typedef std::map<App::DocumentObject*,  trsf_it> rej_it_map;
     rej_it_map nointersect_trsfms;
 
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/PartDesign");
+    bool batched = hGrp->GetBool("BatchedPatternBooleans", true);
+
     // NOTE: It would be possible to build a compound from all original addShapes/subShapes and then
     // transform the compounds as a whole. But we choose to apply the transformations to each
     // Original separately. This way it is easier to discover what feature causes a fuse/cut
@@ -277,6 +282,28 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
             return new App::DocumentObjectExecReturn("Only additive and subtractive features can be transformed");
         }
 
+        // Apply all transformations of this original with one boolean operation. Features that
+        // both add and remove material keep the sequential mode below because the order of
+        // their fuse/cut steps matters
+        if (batched && fuseShape.isNull() != cutShape.isNull()) {
+            std::vector<std::size_t> nointersect;
+            try {
+                if (applyBatched(support, fuseShape.isNull() ? cutShape.getShape() : fuseShape.getShape(),
+                                 !fuseShape.isNull(), transformations, nointersect)) {
+                    for (std::vector<std::size_t>::const_iterator it = nointersect.begin(); it != nointersect.end(); ++it) {
+#ifdef FC_DEBUG // do not write this in release mode because a message appears already in the task view
+                        Base::Console().Warning("Transformed shape does not intersect support %s: Removed\n", (*o)->getNameInDocument());
+#endif
+                        nointersect_trsfms[*o].insert(transformations.begin() + *it);
+                    }
+                    continue;
+                }
+            }
+            catch (Standard_Failure&) {
+                // fall back to the sequential booleans which report what exactly went wrong
+            }
+        }
+
         // Transform the add/subshape and collect the resulting shapes for overlap testing
         /*typedef std::vector<std::vector<gp_Trsf>::const_iterator> trsf_it_vec;
         trsf_it_vec v_transformations;
@@ -422,6 +449,117 @@ TopoDS_Shape Transformed::refineShapeIfActive(const TopoDS_Shape& oldShape) cons
     return oldShape;
 }
 
+bool Transformed::applyBatched(TopoDS_Shape& support, const TopoDS_Shape& tool, bool fuse,
+                               const std::vector<gp_Trsf>& transformations,
+                               std::vector<std::size_t>& nointersect) const
+{
+#if OCC_VERSION_HEX < 0x060900
+    (void)support;
+    (void)tool;
+    (void)fuse;
+    (void)transformations;
+    (void)nointersect;
+    return false;
+#else
+    // Skip first transformation, which is always the identity transformation
+    std::vector<TopoDS_Shape> instances;
+    std::vector<Bnd_Box> bounds;
+    std::vector<std::size_t> indices;
+    instances.reserve(transformations.size());
+    bounds.reserve(transformations.size());
+    indices.reserve(transformations.size());
+    for (std::size_t i = 1; i < transformations.size(); ++i) {
+        // Make an explicit copy of the shape because the "true" parameter to BRepBuilderAPI_Transform
+        // seems to be pretty broken
+        BRepBuilderAPI_Copy copy(tool);
+        if (copy.Shape().IsNull())
+            return false;
+        BRepBuilderAPI_Transform mkTrf(copy.Shape(), transformations[i], false);
+        if (!mkTrf.IsDone())
+            return false;
+
+        TopoDS_Shape shape = mkTrf.Shape();
+        Bnd_Box bound;
+        if (fuse) {
+            BRepBndLib::Add(shape, bound);
+            bound.SetGap(Precision::Confusion());
+        }
+        instances.push_back(shape);
+        bounds.push_back(bound);
+        indices.push_back(i);
+    }
+
+    std::vector<TopoDS_Shape> tools;
+    tools.reserve(instances.size());
+    if (fuse) {
+        // An instance can only be fused if it touches the support or one of the instances
+        // accepted before it. Those that are clearly apart by their bounding boxes are rejected
+        // right away; the solid count of the result below catches the remaining ones
+        Bnd_Box supportBound;
+        BRepBndLib::Add(support, supportBound);
+        supportBound.SetGap(Precision::Confusion());
+
+        std::vector<const Bnd_Box*> accepted;
+        accepted.reserve(instances.size());
+        for (std::size_t i = 0; i < instances.size(); ++i) {
+            bool touches = !bounds[i].IsOut(supportBound);
+            for (std::size_t j = 0; !touches && j < accepted.size(); ++j)
+                touches = !bounds[i].IsOut(*accepted[j]);
+            if (touches) {
+                accepted.push_back(&bounds[i]);
+                tools.push_back(instances[i]);
+            }
+            else {
+                nointersect.push_back(indices[i]);
+            }
+        }
+    }
+    else {
+        tools = instances;
+    }
+
+    if (tools.empty())
+        return true;
+
+    TopTools_ListOfShape shapeArguments, shapeTools;
+    shapeArguments.Append(support);
+    for (std::vector<TopoDS_Shape>::const_iterator it = tools.begin(); it != tools.end(); ++it)
+        shapeTools.Append(*it);
+
+    TopoDS_Shape result;
+    if (fuse) {
+        BRepAlgoAPI_Fuse mkFuse;
+        mkFuse.SetRunParallel(true);
+        mkFuse.SetArguments(shapeArguments);
+        mkFuse.SetTools(shapeTools);
+        mkFuse.Build();
+        if (!mkFuse.IsDone())
+            return false;
+        // An instance that passed the bounding box test but does not touch the support
+        // adds a solid. Let the sequential mode find out which one it is
+        if (countSolids(support) != countSolids(mkFuse.Shape()))
+            return false;
+        // we have to get the solids (fuse sometimes creates compounds)
+        result = getSolid(mkFuse.Shape());
+    }
+    else {
+        BRepAlgoAPI_Cut mkCut;
+        mkCut.SetRunParallel(true);
+        mkCut.SetArguments(shapeArguments);
+        mkCut.SetTools(shapeTools);
+        mkCut.Build();
+        if (!mkCut.IsDone())
+            return false;
+        result = mkCut.Shape();
+    }
+
+    if (result.IsNull())
+        return false;
+    support = result;
+    return true;
+#endif
+}
+
 void Transformed::divideTools(const std::vector<TopoDS_Shape> &toolsIn, std::vector<TopoDS_Shape> &individualsOut,
                               TopoDS_Compound &compoundOut) const
 {
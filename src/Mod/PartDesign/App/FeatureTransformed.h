@@ -92,6 +92,14 @@ protected:
     void Restore(Base::XMLReader &reader);
     virtual void positionBySupport(void);
     TopoDS_Shape refineShapeIfActive(const TopoDS_Shape&) const;
+    /** Fuses or cuts all transformed copies of \a tool with \a support in one multi-argument
+      * boolean operation. The indices of the transformations whose copies do not touch the
+      * support are added to \a nointersect. Returns false without changing \a support if the
+      * caller has to fall back to applying the transformations one by one
+      */
+    bool applyBatched(TopoDS_Shape& support, const TopoDS_Shape& tool, bool fuse,
+                      const std::vector<gp_Trsf>& transformations,
+                      std::vector<std::size_t>& nointersect) const;
     void divideTools(const std::vector<TopoDS_Shape> &toolsIn, std::vector<TopoDS_Shape> &individualsOut,
 		     TopoDS_Compound &compoundOut) const; 
 
@@ -19,6 +19,7 @@
 #   USA                                                                   *
 #**************************************************************************
 import unittest
+from math import pi
 
 import FreeCAD
 import TestSketcherApp
@@ -138,6 +139,29 @@ class TestLinearPattern(unittest.TestCase):
         self.Doc.recompute()
         self.assertAlmostEqual(self.LinearPattern.Shape.Volume, 1e4)
 
+    def testSubtractiveLinearPattern(self):
+        self.Body = self.Doc.addObject('PartDesign::Body','Body')
+        self.Box = self.Doc.addObject('PartDesign::AdditiveBox','Box')
+        self.Body.addObject(self.Box)
+        self.Box.Length=100.00
+        self.Box.Width=10.00
+        self.Box.Height=10.00
+        self.Cylinder = self.Doc.addObject('PartDesign::SubtractiveCylinder','Cylinder')
+        self.Body.addObject(self.Cylinder)
+        self.Cylinder.Radius=1.00
+        self.Cylinder.Height=10.00
+        self.Cylinder.Placement = FreeCAD.Placement(FreeCAD.Vector(5,5,0), FreeCAD.Rotation())
+        self.Doc.recompute()
+        self.LinearPattern = self.Doc.addObject("PartDesign::LinearPattern","LinearPattern")
+        self.LinearPattern.Originals = [self.Cylinder]
+        self.LinearPattern.Direction = (self.Doc.X_Axis,[""])
+        self.LinearPattern.Length = 90.0
+        self.LinearPattern.Occurrences = 10
+        self.Body.addObject(self.LinearPattern)
+        self.Doc.recompute()
+        self.assertAlmostEqual(self.LinearPattern.Shape.Volume, 1e4 - 10 * pi * 10, places=3)
+
+
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument("PartDesignTestLinearPattern")
@@ -28,6 +28,8 @@
 
 #ifndef _PreComp_
 # include <cfloat>
+# include <exception>
+# include <numeric>
 # include <boost/version.hpp>
 # include <boost/config.hpp>
 # if defined(BOOST_MSVC) && (BOOST_VERSION == 105500)
@@ -89,6 +91,8 @@
 # include <TopTools_HSequenceOfShape.hxx>
 #endif
 
+#include <QtConcurrentMap>
+
 #include <Base/Exception.h>
 #include <Base/Tools.h>
 
@@ -180,7 +184,52 @@ CAreaConfig::~CAreaConfig() {
 
 TYPESYSTEM_SOURCE(Path::Area, Base::BaseClass)
 
-bool Area::s_aborting;
+std::atomic<bool> Area::s_aborting(false);
+
+/** Calls func(i) for every section index i < count
+ *
+ * The sections are processed in parallel, unless the intermediate shapes are
+ * shown for debugging. The caller must apply the libarea settings with a
+ * CAreaConfig beforehand. Area::abort() is checked before each section, and
+ * the error of the first failed section is rethrown once all are done.
+ */
+template<class Func>
+static void foreachSection(std::size_t count, Func func) {
+    auto process = [&](std::size_t i) {
+        if(Area::aborting())
+            throw Base::AbortException("Area operation aborted");
+        func(i);
+    };
+
+    if(count<2 || FC_LOG_INSTANCE.level()>FC_LOGLEVEL_TRACE) {
+        for(std::size_t i=0;i<count;++i)
+            process(i);
+        return;
+    }
+
+    // libarea keeps its settings per thread, the workers take over the ones
+    // of the calling thread
+    CAreaParams params;
+#define AREA_CONF_GET(_param) \
+    params.PARAM_FNAME(_param) = BOOST_PP_CAT(CArea::get_,PARAM_FARG(_param))();
+    PARAM_FOREACH(AREA_CONF_GET,AREA_PARAMS_CAREA)
+
+    std::vector<std::size_t> indices(count);
+    std::iota(indices.begin(),indices.end(),0);
+    std::vector<std::exception_ptr> errors(count);
+    QtConcurrent::blockingMap(indices,[&](std::size_t &i) {
+        CAreaConfig conf(params,false);
+        try {
+            process(i);
+        }catch(...) {
+            errors[i] = std::current_exception();
+        }
+    });
+    for(auto &e : errors) {
+        if(e)
+            std::rethrow_exception(e);
+    }
+}
 
 Area::Area(const AreaParams *params)
 :myParams(s_params)
@@ -1332,7 +1381,7 @@ std::vector<shared_ptr<Area> > Area::makeSections(
     if(plane.IsNull())
         throw Base::ValueError("failed to obtain section plane");
 
-    FC_TIME_INIT2(t,t1);
+    FC_TIME_INIT(t);
 
     TopLoc_Location loc(trsf);
 
@@ -1460,7 +1509,12 @@ std::vector<shared_ptr<Area> > Area::makeSections(
     bool can_retry = fabs(tolerance)>Precision::Confusion();
     TopLoc_Location locInverse(loc.Inverted());
 
-    for(size_t i=0;i<heights.size();++i) {
+    // The sections are independent of each other. They are made in parallel,
+    // including the shape of each section, and collected in height order.
+    std::vector<shared_ptr<Area> > results(heights.size());
+    CAreaConfig conf(myParams);
+    foreachSection(heights.size(),[&](std::size_t i) {
+        FC_TIME_INIT(t1);
         double z = heights[i];
         bool retried = !can_retry;
         while(true) {
@@ -1481,7 +1535,7 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                     TopLoc_Location wloc(t);
                     area->add(s.shape.Moved(wloc).Moved(locInverse),s.op);
                 }
-                sections.push_back(area);
+                results[i] = area;
                 break;
             }
 
@@ -1550,7 +1604,7 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                 }
             }
             if(area->myShapes.size()){
-                sections.push_back(area);
+                results[i] = area;
                 FC_TIME_LOG(t1,"makeSection " << z);
                 showShape(area->getShape(),0,"section_%u_final",i);
                 break;
@@ -1564,6 +1618,10 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                 retried = true;
             }
         }
+    });
+    for(auto &area : results) {
+        if(area)
+            sections.push_back(area);
     }
     FC_TIME_LOG(t,"makeSection count: " << sections.size()<<", total");
     return sections;
@@ -1753,11 +1811,17 @@ TopoDS_Shape Area::toShape(CArea &area, short fill, int reorient) {
         if(_index>=(int)mySections.size())\
             return TopoDS_Shape();\
         if(_index<0) {\
+            std::vector<TopoDS_Shape> shapes(mySections.size());\
+            {\
+                CAreaConfig conf(myParams);\
+                foreachSection(mySections.size(),[&](std::size_t i) {\
+                    shapes[i] = mySections[i]->_op(_index, ## __VA_ARGS__);\
+                });\
+            }\
             BRep_Builder builder;\
             TopoDS_Compound compound;\
             builder.MakeCompound(compound);\
-            for(shared_ptr<Area> area : mySections){\
-                const TopoDS_Shape &s = area->_op(_index, ## __VA_ARGS__);\
+            for(const TopoDS_Shape &s : shapes){\
                 if(s.IsNull()) continue;\
                 builder.Add(compound,s);\
             }\
@@ -3113,14 +3177,20 @@ static inline void addParameter(bool verbose, Command &cmd, const char *name,
         cmd.Parameters[name] = relative?d:next;
 }
 
-static inline void addGCode(bool verbose, Toolpath &path, const gp_Pnt &last,
+static inline void setGCode(bool verbose, Command &cmd, const gp_Pnt &last,
         const gp_Pnt &next, const char *name)
 {
-    Command cmd;
     cmd.Name = name;
     addParameter(verbose,cmd,"X",last.X(),next.X());
     addParameter(verbose,cmd,"Y",last.Y(),next.Y());
     addParameter(verbose,cmd,"Z",last.Z(),next.Z());
+}
+
+static inline void addGCode(bool verbose, Toolpath &path, const gp_Pnt &last,
+        const gp_Pnt &next, const char *name)
+{
+    Command cmd;
+    setGCode(verbose,cmd,last,next,name);
     path.addCommand(cmd);
     return;
 }
@@ -3128,12 +3198,13 @@ static inline void addGCode(bool verbose, Toolpath &path, const gp_Pnt &last,
 static inline void addG1(bool verbose,Toolpath &path, const gp_Pnt &last,
         const gp_Pnt &next, double f, double &last_f)
 {
-    addGCode(verbose,path,last,next,"G1");
+    Command cmd;
+    setGCode(verbose,cmd,last,next,"G1");
     if(f>Precision::Confusion()) {
-        Command *cmd = path.getCommands().back();
-        addParameter(verbose,*cmd,"F",last_f,f);
+        addParameter(verbose,cmd,"F",last_f,f);
         last_f = f;
     }
+    path.addCommand(cmd);
     return;
 }
 
@@ -25,7 +25,8 @@
 
 #ifndef _PreComp_
 # include <cinttypes>
-# include <iomanip>
+# include <cmath>
+# include <vector>
 # include <boost/algorithm/string.hpp>
 # include <boost/lexical_cast.hpp>
 #endif
@@ -98,42 +99,76 @@ bool Command::has(const std::string& attr) const
     return Parameters.count(a) > 0;
 }
 
-std::string Command::toGCode (int precision, bool padzero) const
+// same values as std::pow(10.0,precision+1), computed only once
+static double gcodeScale(int precision)
+{
+    static const std::vector<double> scales = []() {
+        std::vector<double> values;
+        for (int i = 0; i < 19; ++i)
+            values.push_back(std::pow(10.0,i+1));
+        return values;
+    }();
+    if (precision < static_cast<int>(scales.size()))
+        return scales[precision];
+    return std::pow(10.0,precision+1);
+}
+
+// appends the decimal digits of v, padded with zeros to at least width digits
+static void appendDigits(std::string &str, std::int64_t v, int width)
+{
+    char buffer[24];
+    char *end = buffer + sizeof(buffer);
+    char *p = end;
+    do {
+        *--p = static_cast<char>('0' + v%10);
+        v /= 10;
+    } while (v);
+    if (end - p < width)
+        str.append(width - (end - p), '0');
+    str.append(p, end);
+}
+
+void Command::appendGCodeValue(std::string &str, double value, int precision, bool padzero)
 {
-    std::stringstream str;
-    str.fill('0');
-    str << Name;
     if(precision<0)
         precision = 0;
-    double scale = std::pow(10.0,precision+1);
+    double scale = gcodeScale(precision);
     std::int64_t iscale = static_cast<std::int64_t>(scale)/10;
-    for(std::map<std::string,double>::const_iterator i = Parameters.begin(); i != Parameters.end(); ++i) {
-        if(i->first == "N") continue;
 
-        str << " " << i->first;
+    std::int64_t v = static_cast<std::int64_t>(value*scale);
+    if(v<0) {
+        v = -v;
+        str += '-'; //shall we allow -0 ?
+    }
+    v+=5;
+    v /= 10;
+    appendDigits(str, v/iscale, 1);
+    if(!precision) return;
 
-        std::int64_t v = static_cast<std::int64_t>(i->second*scale);
-        if(v<0) {
-            v = -v;
-            str << '-'; //shall we allow -0 ?
+    int width = precision;
+    std::int64_t digits = v%iscale;
+    if(!padzero) {
+        if(!digits) return;
+        while(digits%10 == 0) {
+            digits/=10;
+            --width;
         }
-        v+=5;
-        v /= 10;
-        str << (v/iscale);
-        if(!precision) continue;
-
-        int width = precision;
-        std::int64_t digits = v%iscale;
-        if(!padzero) {
-            if(!digits) continue;
-            while(digits%10 == 0) {
-                digits/=10;
-                --width;
-            }
-        }
-        str << '.' << std::setw(width) << std::right << digits;
     }
-    return str.str();
+    str += '.';
+    appendDigits(str, digits, width);
+}
+
+std::string Command::toGCode (int precision, bool padzero) const
+{
+    std::string str(Name);
+    for(std::map<std::string,double>::const_iterator i = Parameters.begin(); i != Parameters.end(); ++i) {
+        if(i->first == "N") continue;
+
+        str += ' ';
+        str += i->first;
+        appendGCodeValue(str, i->second, precision, padzero);
+    }
+    return str;
 }
 
 void Command::setFromGCode (const std::string& str)
@@ -59,6 +59,7 @@ namespace Path
         Command transform(const Base::Placement&); // returns a transformed copy of this command
         double getValue(const std::string &name) const; // returns the value of a given parameter
         void scaleBy(double factor); // scales the receiver - use for imperial/metric conversions
+        static void appendGCodeValue(std::string &str, double value, int precision, bool padzero); // appends a parameter value as toGCode() does
 
         // this assumes the name is upper case
         inline double getParam(const std::string &name, double fallback = 0.0) const {
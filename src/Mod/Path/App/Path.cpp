@@ -24,9 +24,19 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
+# include <bitset>
+# include <cctype>
+# include <cstdlib>
+# include <iterator>
+# include <sstream>
+# include <unordered_map>
 # include <boost/regex.hpp>
 #endif
 
+#include <QThread>
+#include <QtConcurrentMap>
+
 #include <Base/Writer.h>
 #include <Base/Reader.h>
 #include <Base/Stream.h>
@@ -47,21 +57,160 @@ using namespace Base;
 
 TYPESYSTEM_SOURCE(Path::Toolpath , Base::Persistence)
 
+static CommandType getCommandType(const std::string &name)
+{
+    static const std::map<std::string, CommandType> types = {
+        {"G0", CommandType::Rapid},
+        {"G00", CommandType::Rapid},
+        {"G1", CommandType::Feed},
+        {"G01", CommandType::Feed},
+        {"G2", CommandType::ArcCW},
+        {"G02", CommandType::ArcCW},
+        {"G3", CommandType::ArcCCW},
+        {"G03", CommandType::ArcCCW},
+        {"G90", CommandType::Absolute},
+        {"G91", CommandType::Relative},
+        {"G90.1", CommandType::AbsoluteCenter},
+        {"G91.1", CommandType::RelativeCenter},
+        {"G81", CommandType::Drill},
+        {"G82", CommandType::Drill},
+        {"G83", CommandType::Drill},
+        {"G84", CommandType::Drill},
+        {"G85", CommandType::Drill},
+        {"G86", CommandType::Drill},
+        {"G89", CommandType::Drill},
+        {"G38.2", CommandType::Probe},
+        {"G38.3", CommandType::Probe},
+        {"G38.4", CommandType::Probe},
+        {"G38.5", CommandType::Probe},
+        {"G17", CommandType::PlaneXY},
+        {"G18", CommandType::PlaneXZ},
+        {"G19", CommandType::PlaneYZ},
+    };
+    auto it = types.find(name);
+    return it == types.end() ? CommandType::Other : it->second;
+}
+
+// single upper case letters are stored in the packed arrays
+static inline bool isWord(const std::string &key)
+{
+    return key.size() == 1 && key[0] >= 'A' && key[0] <= 'Z';
+}
+
+static inline std::uint32_t wordBit(char word)
+{
+    return std::uint32_t(1) << (word - 'A');
+}
+
+// CommandView
+
+const std::string &CommandView::getName() const
+{
+    return path.vNames[path.vNameIds[pos]];
+}
+
+CommandType CommandView::getType() const
+{
+    return path.vNameTypes[path.vNameIds[pos]];
+}
+
+bool CommandView::has(char word) const
+{
+    return (path.vWordMasks[pos] & wordBit(word)) != 0;
+}
+
+double CommandView::getParam(char word, double fallback) const
+{
+    std::uint32_t mask = path.vWordMasks[pos];
+    std::uint32_t bit = wordBit(word);
+    if (!(mask & bit))
+        return fallback;
+    // the values are ordered by letter, count the words before this one
+    std::size_t index = std::bitset<32>(mask & (bit - 1)).count();
+    return path.vValues[path.vValueOffsets[pos] + index];
+}
+
+Base::Placement CommandView::getPlacement(const Base::Vector3d pos) const
+{
+    Vector3d vec(getParam('X', pos.x),getParam('Y', pos.y),getParam('Z', pos.z));
+    Rotation rot;
+    rot.setYawPitchRoll(getParam('A'),getParam('B'),getParam('C'));
+    return Placement(vec,rot);
+}
+
+Base::Vector3d CommandView::getCenter() const
+{
+    return Vector3d(getParam('I'),getParam('J'),getParam('K'));
+}
+
+std::string CommandView::toGCode(int precision, bool padzero) const
+{
+    std::string str;
+    appendGCode(str, precision, padzero);
+    return str;
+}
+
+void CommandView::appendGCode(std::string &str, int precision, bool padzero) const
+{
+    if (path.mExtraParameters.count(pos)) {
+        str += toCommand().toGCode(precision, padzero);
+        return;
+    }
+
+    str += getName();
+    std::uint32_t mask = path.vWordMasks[pos];
+    const double *value = path.vValues.data() + path.vValueOffsets[pos];
+    for (char word = 'A'; mask; ++word, mask >>= 1) {
+        if (!(mask & 1))
+            continue;
+        double v = *value++;
+        if (word == 'N')
+            continue;
+        str += ' ';
+        str += word;
+        Command::appendGCodeValue(str, v, precision, padzero);
+    }
+}
+
+Command CommandView::toCommand() const
+{
+    Command cmd;
+    cmd.Name = getName();
+    std::uint32_t mask = path.vWordMasks[pos];
+    const double *value = path.vValues.data() + path.vValueOffsets[pos];
+    for (char word = 'A'; mask; ++word, mask >>= 1) {
+        if (mask & 1)
+            cmd.Parameters.emplace_hint(cmd.Parameters.end(), std::string(1, word), *value++);
+    }
+    auto it = path.mExtraParameters.find(pos);
+    if (it != path.mExtraParameters.end())
+        cmd.Parameters.insert(it->second.begin(), it->second.end());
+    return cmd;
+}
+
+// Toolpath
+
 Toolpath::Toolpath()
+    : vValueOffsets(1, 0)
 {
 }
 
 Toolpath::Toolpath(const Toolpath& otherPath)
-    : vpcCommands(otherPath.vpcCommands.size())
+    : vNames(otherPath.vNames)
+    , vNameTypes(otherPath.vNameTypes)
+    , mNameIds(otherPath.mNameIds)
+    , vNameIds(otherPath.vNameIds)
+    , vWordMasks(otherPath.vWordMasks)
+    , vValueOffsets(otherPath.vValueOffsets)
+    , vValues(otherPath.vValues)
+    , mExtraParameters(otherPath.mExtraParameters)
     , center(otherPath.center)
 {
-    *this = otherPath;
     recalculate();
 }
 
 Toolpath::~Toolpath()
 {
-    clear();
 }
 
 Toolpath &Toolpath::operator=(const Toolpath& otherPath)
@@ -69,12 +218,14 @@ Toolpath &Toolpath::operator=(const Toolpath& otherPath)
     if (this == &otherPath)
         return *this;
 
-    clear();
-    vpcCommands.resize(otherPath.vpcCommands.size());
-    int i = 0;
-    for (std::vector<Command*>::const_iterator it=otherPath.vpcCommands.begin();it!=otherPath.vpcCommands.end();++it,i++) {
-        vpcCommands[i] = new Command(**it);
-    }
+    vNames = otherPath.vNames;
+    vNameTypes = otherPath.vNameTypes;
+    mNameIds = otherPath.mNameIds;
+    vNameIds = otherPath.vNameIds;
+    vWordMasks = otherPath.vWordMasks;
+    vValueOffsets = otherPath.vValueOffsets;
+    vValues = otherPath.vValues;
+    mExtraParameters = otherPath.mExtraParameters;
     center = otherPath.center;
     recalculate();
     return *this;
@@ -82,16 +233,92 @@ Toolpath &Toolpath::operator=(const Toolpath& otherPath)
 
 void Toolpath::clear(void)
 {
-    for(std::vector<Command*>::iterator it = vpcCommands.begin();it!=vpcCommands.end();++it)
-        delete ( *it );
-    vpcCommands.clear();
+    vNames.clear();
+    vNameTypes.clear();
+    mNameIds.clear();
+    vNameIds.clear();
+    vWordMasks.clear();
+    vValueOffsets.assign(1, 0);
+    vValues.clear();
+    mExtraParameters.clear();
     recalculate();
 }
 
+std::uint32_t Toolpath::getNameId(const std::string &name)
+{
+    auto res = mNameIds.emplace(name, static_cast<std::uint32_t>(vNames.size()));
+    if (res.second) {
+        vNames.push_back(name);
+        vNameTypes.push_back(getCommandType(name));
+    }
+    return res.first->second;
+}
+
+void Toolpath::shiftExtraParameters(unsigned int pos, int offset)
+{
+    // moves the extra parameters of the commands from pos on by offset
+    auto it = mExtraParameters.lower_bound(pos);
+    if (it == mExtraParameters.end())
+        return;
+    std::map<unsigned int, std::map<std::string,double> > shifted(mExtraParameters.begin(), it);
+    for (; it != mExtraParameters.end(); ++it)
+        shifted.emplace_hint(shifted.end(), it->first + offset, std::move(it->second));
+    mExtraParameters.swap(shifted);
+}
+
+void Toolpath::insertPacked(unsigned int pos, const Command &Cmd)
+{
+    std::uint32_t mask = 0;
+    std::size_t count = 0;
+    for (const auto &param : Cmd.Parameters) {
+        if (isWord(param.first)) {
+            mask |= wordBit(param.first[0]);
+            ++count;
+        }
+    }
+
+    bool append = pos == getSize();
+    if (!append)
+        shiftExtraParameters(pos, 1);
+
+    std::uint32_t offset = vValueOffsets[pos];
+    vNameIds.insert(vNameIds.begin() + pos, getNameId(Cmd.Name));
+    vWordMasks.insert(vWordMasks.begin() + pos, mask);
+    vValueOffsets.insert(vValueOffsets.begin() + pos + 1, offset);
+    for (std::size_t i = pos + 1; i < vValueOffsets.size(); ++i)
+        vValueOffsets[i] += count;
+
+    // the map is ordered, so are the words
+    auto value = vValues.insert(vValues.begin() + offset, count, 0.0);
+    for (const auto &param : Cmd.Parameters) {
+        if (isWord(param.first))
+            *value++ = param.second;
+        else
+            mExtraParameters[pos].insert(param);
+    }
+}
+
 void Toolpath::addCommand(const Command &Cmd)
 {
-    Command *tmp = new Command(Cmd);
-    vpcCommands.push_back(tmp);
+    insertPacked(getSize(), Cmd);
+    recalculate();
+}
+
+void Toolpath::addCommand(const CommandView &Cmd)
+{
+    const Toolpath &other = Cmd.path;
+    unsigned int pos = Cmd.pos;
+    if (&other == this || other.mExtraParameters.count(pos)) {
+        addCommand(Cmd.toCommand());
+        return;
+    }
+
+    vNameIds.push_back(getNameId(Cmd.getName()));
+    vWordMasks.push_back(other.vWordMasks[pos]);
+    vValues.insert(vValues.end(),
+                   other.vValues.begin() + other.vValueOffsets[pos],
+                   other.vValues.begin() + other.vValueOffsets[pos + 1]);
+    vValueOffsets.push_back(vValues.size());
     recalculate();
 }
 
@@ -99,9 +326,8 @@ void Toolpath::insertCommand(const Command &Cmd, int pos)
 {
     if (pos == -1) {
         addCommand(Cmd);
-    } else if (pos <= static_cast<int>(vpcCommands.size())) {
-        Command *tmp = new Command(Cmd);
-        vpcCommands.insert(vpcCommands.begin()+pos,tmp);
+    } else if (pos <= static_cast<int>(getSize())) {
+        insertPacked(pos, Cmd);
     } else {
         throw Base::IndexError("Index not in range");
     }
@@ -111,33 +337,44 @@ void Toolpath::insertCommand(const Command &Cmd, int pos)
 void Toolpath::deleteCommand(int pos)
 {
     if (pos == -1) {
-        //delete(*vpcCommands.rbegin()); // causes crash
-        vpcCommands.pop_back();
-    } else if (pos <= static_cast<int>(vpcCommands.size())) {
-        vpcCommands.erase (vpcCommands.begin()+pos);
-    } else {
+        pos = static_cast<int>(getSize()) - 1;
+    } else if (pos >= static_cast<int>(getSize())) {
         throw Base::IndexError("Index not in range");
     }
+
+    if (pos >= 0) {
+        std::uint32_t begin = vValueOffsets[pos];
+        std::uint32_t count = vValueOffsets[pos + 1] - begin;
+        vValues.erase(vValues.begin() + begin, vValues.begin() + begin + count);
+        vValueOffsets.erase(vValueOffsets.begin() + pos);
+        for (std::size_t i = pos; i < vValueOffsets.size(); ++i)
+            vValueOffsets[i] -= count;
+        vNameIds.erase(vNameIds.begin() + pos);
+        vWordMasks.erase(vWordMasks.begin() + pos);
+        mExtraParameters.erase(pos);
+        shiftExtraParameters(pos, -1);
+    }
     recalculate();
 }
 
 double Toolpath::getLength()
 {
-    if(vpcCommands.size()==0)
+    if(getSize()==0)
         return 0;
     double l = 0;
     Vector3d last(0,0,0);
     Vector3d next;
-    for(std::vector<Command*>::const_iterator it = vpcCommands.begin();it!=vpcCommands.end();++it) {
-        std::string name = (*it)->Name;
-        next = (*it)->getPlacement(last).getPosition();
-        if ( (name == "G0") || (name == "G00") || (name == "G1") || (name == "G01") ) {
+    for(unsigned int i = 0; i < getSize(); i++) {
+        CommandView cmd(*this, i);
+        CommandType type = cmd.getType();
+        next = cmd.getPlacement(last).getPosition();
+        if ( (type == CommandType::Rapid) || (type == CommandType::Feed) ) {
             // straight line
             l += (next - last).Length();
             last = next;
-        } else if ( (name == "G2") || (name == "G02") || (name == "G3") || (name == "G03") ) {
+        } else if ( (type == CommandType::ArcCW) || (type == CommandType::ArcCCW) ) {
             // arc
-            Vector3d center = (*it)->getCenter();
+            Vector3d center = cmd.getCenter();
             double radius = (last - center).Length();
             double angle = (next - center).GetAngle(last - center);
             l += angle * radius;
@@ -163,40 +400,41 @@ double Toolpath::getCycleTime(double hFeed, double vFeed, double hRapid, double
         vRapid = vFeed;
     }
 
-    if(vpcCommands.size()==0)
+    if(getSize()==0)
         return 0;
     double l = 0;
     double time = 0;
     bool verticalMove = false;
     Vector3d last(0,0,0);
     Vector3d next;
-    for(std::vector<Command*>::const_iterator it = vpcCommands.begin();it!=vpcCommands.end();++it) {
-        std::string name = (*it)->Name;
-        float feedrate = (*it)->getParam("F");
+    for(unsigned int i = 0; i < getSize(); i++) {
+        CommandView cmd(*this, i);
+        CommandType type = cmd.getType();
+        float feedrate;
 
         l = 0;
         verticalMove = false;
         feedrate = hFeed;
-        next = (*it)->getPlacement(last).getPosition();
+        next = cmd.getPlacement(last).getPosition();
 
         if (last.z != next.z){
             verticalMove = true;
             feedrate = vFeed;
         }
 
-        if ((name == "G0") || (name == "G00")){
+        if (type == CommandType::Rapid){
             // Rapid Move
             l += (next - last).Length();
             feedrate = hRapid;
             if(verticalMove){
                 feedrate = vRapid;
             }
-        }else if ((name == "G1") || (name == "G01")) {
+        }else if (type == CommandType::Feed) {
             // Feed Move
             l += (next - last).Length();
-        }else if ((name == "G2") || (name == "G02") || (name == "G3") || (name == "G03") ) {
+        }else if ((type == CommandType::ArcCW) || (type == CommandType::ArcCCW)) {
             // Arc Move
-            Vector3d center = (*it)->getCenter();
+            Vector3d center = cmd.getCenter();
             double radius = (last - center).Length();
             double angle = (next - center).GetAngle(last - center);
             l += angle * radius;
@@ -280,83 +518,388 @@ Base::BoundBox3d Toolpath::getBoundBox() const
     return visitor.bb;
 }
 
-static void bulkAddCommand(const std::string &gcodestr, std::vector<Command*> &commands, bool &inches)
+namespace {
+
+const double exactPowersOf10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Gives the same result as std::atof(), used by Command::setFromGCode().
+// A plain decimal number of up to 15 digits is converted with a single
+// division of two exactly representable values, which is correctly rounded.
+// Anything else, e.g. several signs or points, is left to the C library.
+double parseGCodeValue(const std::string &text)
 {
-    Command *cmd = new Command();
-    cmd->setFromGCode(gcodestr);
-    if ("G20" == cmd->Name) {
-        inches = true;
-        delete cmd;
-    } else if ("G21" == cmd->Name) {
-        inches = false;
-        delete cmd;
-    } else {
-        if (inches) {
-            cmd->scaleBy(25.4);
+    const char *p = text.c_str();
+    const char *end = p + text.size();
+    bool negative = false;
+    if (p != end && *p == '-') {
+        negative = true;
+        ++p;
+    }
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int decimals = 0;
+    bool point = false;
+    for (; p != end; ++p) {
+        if (*p >= '0' && *p <= '9') {
+            mantissa = mantissa*10 + (*p - '0');
+            ++digits;
+            if (point)
+                ++decimals;
+        }
+        else if (*p == '.' && !point) {
+            point = true;
         }
-        commands.push_back(cmd);
+        else {
+            break;
+        }
+    }
+    if (p == end && digits > 0 && digits <= 15) {
+        double value = static_cast<double>(mantissa) / exactPowersOf10[decimals];
+        return negative ? -value : value;
     }
+    return std::atof(text.c_str());
 }
 
-void Toolpath::setFromGCode(const std::string instr)
+// name index of the commands left to Command::setFromGCode()
+const std::uint32_t otherCommand = ~std::uint32_t(0);
+
+inline bool isCommandStart(char c)
 {
-    clear();
+    return c == '(' || c == 'g' || c == 'G' || c == 'm' || c == 'M';
+}
+
+inline bool isDigit(char c)
+{
+    return std::isdigit(static_cast<unsigned char>(c)) != 0;
+}
 
-    // remove comments
-    //boost::regex e("\\(.*?\\)");
-    //std::string str = boost::regex_replace(instr, e, "");
-    std::string str(instr);
+inline bool isAlpha(char c)
+{
+    return std::isalpha(static_cast<unsigned char>(c)) != 0;
+}
 
-    // split input string by () or G or M commands
-    std::string mode = "command";
-    std::size_t found = str.find_first_of("(gGmM");
-    int last = -1;
-    bool inches = false;
-    while (found != std::string::npos)
-    {
-        if (str[found] == '(') {
-            // start of comment
-            if ( (last > -1) && (mode == "command") ) {
-                // before opening a comment, add the last found command
-                std::string gcodestr = str.substr(last, found-last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
-            }
-            mode = "comment";
+inline char toUpper(char c)
+{
+    return static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+}
+
+// the words scaled by Command::scaleBy()
+inline bool isLengthWord(char word)
+{
+    switch (word) {
+        case 'X':
+        case 'Y':
+        case 'Z':
+        case 'I':
+        case 'J':
+        case 'R':
+        case 'Q':
+        case 'F':
+            return true;
+    }
+    return false;
+}
+
+/* Parses G-code directly into the packed layout of Toolpath, with the same
+ * rules as Toolpath::setFromGCode() used to apply by creating a Command for
+ * every line with Command::setFromGCode(). The text is processed in a single
+ * pass, and the buffers are reused for every command.
+ */
+class GCodeParser
+{
+public:
+    GCodeParser(const char *begin, const char *end)
+        : begin(begin), end(end)
+    {}
+
+    // parses the text, stops at the first badly formatted command
+    void parse();
+
+    // finds the command starts to split the text into about count pieces
+    static std::vector<const char*> split(const char *begin, const char *end, std::size_t count);
+
+    const char *begin;
+    const char *end;
+    std::vector<std::string> names;
+    std::unordered_map<std::string, std::uint32_t> nameIds;
+    std::vector<std::uint32_t> nameIndices;
+    std::vector<std::uint32_t> wordMasks;
+    std::vector<double> values;
+    std::vector<std::pair<std::size_t, bool> > unitChanges; // number of commands before the change, inches
+    std::vector<std::string> others; // commands with a parameter that is not a letter
+    std::string error;
+
+private:
+    bool parseCommand(const char *first, const char *last);
+    void setWord(char key);
+    bool fail(const char *msg) {
+        error = msg;
+        return false;
+    }
+
+    std::string name;
+    std::string value;
+    double words[26];
+    std::uint32_t mask;
+    bool other;
+};
+
+void GCodeParser::setWord(char key)
+{
+    if (key < 'A' || key > 'Z') {
+        // e.g. a stray ')', left to Command::setFromGCode()
+        other = true;
+        return;
+    }
+    int word = key - 'A';
+    words[word] = parseGCodeValue(value);
+    mask |= std::uint32_t(1) << word;
+}
+
+void GCodeParser::parse()
+{
+    // split into commands at G, M or a comment in parentheses
+    bool comment = false;
+    const char *last = nullptr;
+    const char *found = std::find_if(begin, end, isCommandStart);
+    while (found != end) {
+        if (*found == '(') {
+            // start of comment, add the last found command
+            if (last && !comment && !parseCommand(last, found))
+                return;
+            comment = true;
             last = found;
-            found = str.find_first_of(')', found+1);
-        } else if (str[found] == ')') {
+            found = std::find(found + 1, end, ')');
+        }
+        else if (*found == ')') {
             // end of comment
-            std::string gcodestr = str.substr(last, found-last+1);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
-            last = -1;
-            found = str.find_first_of("(gGmM", found+1);
-            mode = "command";
-        } else if (mode == "command") {
-            // command
-            if (last > -1) {
-                std::string gcodestr = str.substr(last, found-last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
-            }
+            if (!parseCommand(last, found + 1))
+                return;
+            comment = false;
+            last = nullptr;
+            found = std::find_if(found + 1, end, isCommandStart);
+        }
+        else {
+            if (last && !parseCommand(last, found))
+                return;
             last = found;
-            found = str.find_first_of("(gGmM", found+1);
+            found = std::find_if(found + 1, end, isCommandStart);
         }
     }
     // add the last command found, if any
-    if (last > -1) {
-        if (mode == "command") {
-            std::string gcodestr = str.substr(last,std::string::npos);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
+    if (last && !comment)
+        parseCommand(last, end);
+}
+
+std::vector<const char*> GCodeParser::split(const char *begin, const char *end, std::size_t count)
+{
+    // same scan as in parse(), only stopping at commands past the next piece
+    std::vector<const char*> starts;
+    std::size_t size = (end - begin) / count;
+    const char *next = begin;
+    const char *found = std::find_if(begin, end, isCommandStart);
+    while (found != end) {
+        if (found >= next) {
+            starts.push_back(found);
+            next = found + size;
+        }
+        if (*found == '(') {
+            found = std::find(found + 1, end, ')');
+            if (found != end)
+                found = std::find_if(found + 1, end, isCommandStart);
+        }
+        else {
+            found = std::find_if(found + 1, end, isCommandStart);
         }
     }
+    if (starts.empty())
+        starts.push_back(begin);
+    starts.push_back(end);
+    return starts;
+}
+
+bool GCodeParser::parseCommand(const char *first, const char *last)
+{
+    enum Mode { None, Name, Argument, Comment };
+    Mode mode = None;
+    char key = 0;
+    mask = 0;
+    other = false;
+    value.clear();
+
+    for (const char *p = first; p != last; ++p) {
+        char c = *p;
+        if (isDigit(c) || c == '-' || c == '.') {
+            value += c;
+        }
+        else if (isAlpha(c)) {
+            if (mode == Name) {
+                if (!key || value.empty())
+                    return fail("Badly formatted GCode command");
+                name.assign(1, toUpper(key));
+                for (char v : value)
+                    name += toUpper(v);
+                value.clear();
+                mode = Argument;
+            }
+            else if (mode == None) {
+                mode = Name;
+            }
+            else if (mode == Argument) {
+                if (!key || value.empty())
+                    return fail("Badly formatted GCode argument");
+                setWord(toUpper(key));
+                value.clear();
+            }
+            else {
+                value += c;
+            }
+            key = c;
+        }
+        else if (c == '(') {
+            mode = Comment;
+        }
+        else if (c == ')') {
+            key = '(';
+            value += ')';
+        }
+        else if (mode == Comment) {
+            // add non-ascii characters only if this is a comment
+            value += c;
+        }
+    }
+
+    if (!key || value.empty())
+        return fail("Badly formatted GCode argument");
+    if (mode == Name || mode == Comment) {
+        name.assign(1, key);
+        name += value;
+        if (mode == Name) {
+            for (char &v : name)
+                v = toUpper(v);
+        }
+    }
+    else {
+        setWord(toUpper(key));
+    }
+
+    if (name == "G20") {
+        unitChanges.emplace_back(nameIndices.size(), true);
+        return true;
+    }
+    if (name == "G21") {
+        unitChanges.emplace_back(nameIndices.size(), false);
+        return true;
+    }
+    if (other) {
+        nameIndices.push_back(otherCommand);
+        wordMasks.push_back(0);
+        others.emplace_back(first, last);
+        return true;
+    }
+
+    auto it = nameIds.find(name);
+    if (it == nameIds.end()) {
+        it = nameIds.emplace(name, static_cast<std::uint32_t>(names.size())).first;
+        names.push_back(name);
+    }
+    nameIndices.push_back(it->second);
+    wordMasks.push_back(mask);
+    for (int word = 0; mask; ++word, mask >>= 1) {
+        if (mask & 1)
+            values.push_back(words[word]);
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+void Toolpath::setFromGCode(const std::string instr)
+{
+    clear();
+
+    const char *begin = instr.c_str();
+    const char *end = begin + instr.size();
+
+    // large programs are split at command starts and parsed in parallel
+    std::size_t count = 1;
+    if (instr.size() >= 1024 * 1024)
+        count = std::max(1, QThread::idealThreadCount()) * 4;
+
+    std::vector<GCodeParser> parsers;
+    if (count > 1) {
+        std::vector<const char*> starts = GCodeParser::split(begin, end, count);
+        for (std::size_t i = 0; i + 1 < starts.size(); ++i)
+            parsers.emplace_back(starts[i], starts[i + 1]);
+        QtConcurrent::blockingMap(parsers, [](GCodeParser &parser) {
+            parser.parse();
+        });
+    }
+    else {
+        parsers.emplace_back(begin, end);
+        parsers.front().parse();
+    }
+
+    // append the pieces in order, applying the unit changes
+    bool inches = false;
+    for (const auto &parser : parsers) {
+        std::vector<std::uint32_t> ids;
+        ids.reserve(parser.names.size());
+        for (const auto &name : parser.names)
+            ids.push_back(getNameId(name));
+
+        vNameIds.reserve(vNameIds.size() + parser.nameIndices.size());
+        vWordMasks.reserve(vWordMasks.size() + parser.wordMasks.size());
+        vValueOffsets.reserve(vValueOffsets.size() + parser.nameIndices.size());
+        vValues.reserve(vValues.size() + parser.values.size());
+
+        auto unit = parser.unitChanges.begin();
+        auto other = parser.others.begin();
+        const double *value = parser.values.data();
+        for (std::size_t i = 0; i < parser.nameIndices.size(); ++i) {
+            for (; unit != parser.unitChanges.end() && unit->first == i; ++unit)
+                inches = unit->second;
+
+            if (parser.nameIndices[i] == otherCommand) {
+                Command cmd;
+                cmd.setFromGCode(*other++);
+                if (inches)
+                    cmd.scaleBy(25.4);
+                addCommand(cmd);
+                continue;
+            }
+            std::uint32_t mask = parser.wordMasks[i];
+            vNameIds.push_back(ids[parser.nameIndices[i]]);
+            vWordMasks.push_back(mask);
+            for (char word = 'A'; mask; ++word, mask >>= 1) {
+                if (!(mask & 1))
+                    continue;
+                double v = *value++;
+                if (inches && isLengthWord(word))
+                    v *= 25.4;
+                vValues.push_back(v);
+            }
+            vValueOffsets.push_back(vValues.size());
+        }
+        for (; unit != parser.unitChanges.end(); ++unit)
+            inches = unit->second;
+
+        if (!parser.error.empty())
+            throw Base::BadFormatError(parser.error.c_str());
+    }
     recalculate();
 }
 
 std::string Toolpath::toGCode(void) const
 {
     std::string result;
-    for (std::vector<Command*>::const_iterator it=vpcCommands.begin();it!=vpcCommands.end();++it) {
-        result += (*it)->toGCode();
-        result += "\n";
+    result.reserve(vValues.size() * 10 + getSize() * 4);
+    for (unsigned int i = 0; i < getSize(); i++) {
+        CommandView(*this, i).appendGCode(result);
+        result += '\n';
     }
     return result;
 }
@@ -364,7 +907,7 @@ std::string Toolpath::toGCode(void) const
 void Toolpath::recalculate(void) // recalculates the path cache
 {
 
-    if(vpcCommands.size()==0)
+    if(getSize()==0)
         return;
 
     // TODO recalculate the KDL stuff. At the moment, this is unused.
@@ -449,7 +992,7 @@ void Toolpath::Save (Writer &writer) const
         writer.incInd();
         saveCenter(writer, center);
         for(unsigned int i = 0; i < getSize(); i++) {
-            vpcCommands[i]->Save(writer);
+            getCommand(i).Save(writer);
         }
         writer.decInd();
     } else {
@@ -464,9 +1007,10 @@ void Toolpath::Save (Writer &writer) const
 
 void Toolpath::SaveDocFile (Base::Writer &writer) const
 {
-    if (toGCode().empty())
+    std::string gcode = toGCode();
+    if (gcode.empty())
         return;
-    writer.Stream() << toGCode();
+    writer.Stream() << gcode;
 }
 
 void Toolpath::Restore(XMLReader &reader)
@@ -482,14 +1026,8 @@ void Toolpath::Restore(XMLReader &reader)
 
 void Toolpath::RestoreDocFile(Base::Reader &reader)
 {
-    std::string gcode;
-    std::string line;
-    while (reader >> line) {
-        gcode += line;
-        gcode += " ";
-    }
+    std::string gcode((std::istreambuf_iterator<char>(reader)), std::istreambuf_iterator<char>());
     setFromGCode(gcode);
-
 }
 
 
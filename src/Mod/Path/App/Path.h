@@ -24,6 +24,11 @@
 #ifndef PATH_Path_H
 #define PATH_Path_H
 
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include "Command.h"
 //#include "Mod/Robot/App/kdl_cp/path_composite.hpp"
 //#include "Mod/Robot/App/kdl_cp/frames_io.hpp"
@@ -34,7 +39,65 @@
 namespace Path
 {
 
-    /** The representation of a CNC Toolpath */
+    /** Classification of the command names, computed once per distinct name
+     *  of a Toolpath so that walking a path doesn't compare strings */
+    enum class CommandType : std::uint8_t
+    {
+        Other,
+        Rapid,          // G0, G00
+        Feed,           // G1, G01
+        ArcCW,          // G2, G02
+        ArcCCW,         // G3, G03
+        Absolute,       // G90
+        Relative,       // G91
+        AbsoluteCenter, // G90.1
+        RelativeCenter, // G91.1
+        Drill,          // G81 - G86, G89
+        Probe,          // G38.2 - G38.5
+        PlaneXY,        // G17
+        PlaneXZ,        // G18
+        PlaneYZ,        // G19
+    };
+
+    class Toolpath;
+
+    /** Read-only access to a command of a Toolpath
+     *
+     *  The view reads the packed storage of the path, without creating a
+     *  Command. It is invalidated by any change of the path.
+     */
+    class PathExport CommandView
+    {
+        public:
+            CommandView(const Toolpath &path, unsigned int pos)
+                : path(path), pos(pos) {}
+
+            const std::string &getName() const;
+            CommandType getType() const;
+            // the word must be an upper case letter
+            bool has(char word) const;
+            double getParam(char word, double fallback = 0.0) const;
+            Base::Placement getPlacement(const Base::Vector3d pos = Base::Vector3d()) const; // same as Command::getPlacement()
+            Base::Vector3d getCenter() const; // same as Command::getCenter()
+            std::string toGCode(int precision=6, bool padzero=true) const; // same as Command::toGCode()
+            void appendGCode(std::string &str, int precision=6, bool padzero=true) const; // appends toGCode() to the string
+            Command toCommand() const; // returns a copy of the command
+
+        private:
+            const Toolpath &path;
+            unsigned int pos;
+
+            friend class Toolpath;
+    };
+
+    /** The representation of a CNC Toolpath
+     *
+     *  The commands are not stored as Command objects but packed into a few
+     *  contiguous arrays: an index into the table of distinct command names,
+     *  a bit mask of the single letter words given, and the values of these
+     *  words. Any other parameter is kept in a sparse map. Use getCommandView()
+     *  to read a command without copying it.
+     */
     
     class PathExport Toolpath : public Base::Persistence
     {
@@ -57,6 +120,7 @@ namespace Path
             // interface
             void clear(void); // clears the internal data
             void addCommand(const Command &Cmd); // adds a command at the end
+            void addCommand(const CommandView &Cmd); // adds a command of another path at the end
             void insertCommand(const Command &Cmd, int); // inserts a command
             void deleteCommand(int); // deletes a command
             double getLength(void); // return the Length (mm) of the Path
@@ -67,9 +131,9 @@ namespace Path
             Base::BoundBox3d getBoundBox(void) const;
             
             // shortcut functions
-            unsigned int getSize(void) const { return vpcCommands.size(); }
-            const std::vector<Command*> &getCommands(void) const { return vpcCommands; }
-            const Command &getCommand(unsigned int pos)    const { return *vpcCommands[pos]; }
+            unsigned int getSize(void) const { return vNameIds.size(); }
+            CommandView getCommandView(unsigned int pos) const { return CommandView(*this, pos); }
+            Command getCommand(unsigned int pos) const { return getCommandView(pos).toCommand(); }
         
             // support for rotation
             const Base::Vector3d& getCenter() const { return center; }
@@ -78,9 +142,22 @@ namespace Path
             static const int SchemaVersion = 2;
 
         protected:
-            std::vector<Command*> vpcCommands;
+            std::uint32_t getNameId(const std::string &name);
+            void insertPacked(unsigned int pos, const Command &Cmd);
+            void shiftExtraParameters(unsigned int pos, int offset);
+
+            std::vector<std::string> vNames;                   // distinct command names
+            std::vector<CommandType> vNameTypes;               // type of each name
+            std::unordered_map<std::string, std::uint32_t> mNameIds;
+            std::vector<std::uint32_t> vNameIds;               // name of each command
+            std::vector<std::uint32_t> vWordMasks;             // bit i is set if word 'A'+i is given
+            std::vector<std::uint32_t> vValueOffsets;          // first value of each command, plus the end
+            std::vector<double> vValues;                       // word values in alphabetical order
+            std::map<unsigned int, std::map<std::string,double> > mExtraParameters; // any other parameter, by command
             Base::Vector3d center;
             //KDL::Path_Composite *pcPath;
+
+            friend class CommandView;
             
         /*
         inline  KDL::Frame toFrame(const Base::Placement &To){
@@ -141,8 +141,8 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
     for (unsigned int  i = 0; i < tp.getSize(); i++) {
         std::deque<Base::Vector3d> points;
 
-        const Path::Command &cmd = tp.getCommand(i);
-        const std::string &name = cmd.Name;
+        Path::CommandView cmd = tp.getCommandView(i);
+        Path::CommandType type = cmd.getType();
         Base::Vector3d next = cmd.getPlacement().getPosition();
         double a = A;
         double b = B;
@@ -150,18 +150,18 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
 
         if (!absolute)
             next = last + next;
-        if (!cmd.has("X")) next.x = last.x;
-        if (!cmd.has("Y")) next.y = last.y;
-        if (!cmd.has("Z")) next.z = last.z;
-        if ( cmd.has("A")) a = cmd.getValue("A");
-        if ( cmd.has("B")) b = cmd.getValue("B");
-        if ( cmd.has("C")) c = cmd.getValue("C");
+        if (!cmd.has('X')) next.x = last.x;
+        if (!cmd.has('Y')) next.y = last.y;
+        if (!cmd.has('Z')) next.z = last.z;
+        if ( cmd.has('A')) a = cmd.getParam('A');
+        if ( cmd.has('B')) b = cmd.getParam('B');
+        if ( cmd.has('C')) c = cmd.getParam('C');
 
         Base::Rotation nrot = yawPitchRoll(a, b, c);
 
         Base::Vector3d rnext = compensateRotation(next, nrot, rotCenter);
 
-        if ( (name == "G0") || (name == "G00") || (name == "G1") || (name == "G01") ) {
+        if ( (type == Path::CommandType::Rapid) || (type == Path::CommandType::Feed) ) {
             // straight line
             if (nrot != lrot) {
                 double amax = std::max(fmod(fabs(a - A), 360), std::max(fmod(fabs(b - B), 360), fmod(fabs(c - C), 360)));
@@ -184,7 +184,7 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
                 }
             }
 
-            if ("G0" == name || "G00" == name) {
+            if (type == Path::CommandType::Rapid) {
                 cb.g0(i, last, rnext, points);
             } else {
                 cb.g1(i, last, rnext, points);
@@ -196,12 +196,12 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
             C = c;
             lrot = nrot;
 
-        } else if ( (name == "G2") || (name == "G02") || (name == "G3") || (name == "G03") ) {
+        } else if ( (type == Path::CommandType::ArcCW) || (type == Path::CommandType::ArcCCW) ) {
             // arc
             Base::Vector3d norm;
             Base::Vector3d center;
 
-            if ( (name == "G2") || (name == "G02") )
+            if (type == Path::CommandType::ArcCW)
                 norm.*pz = -1.0;
             else
                 norm.*pz = 1.0;
@@ -221,10 +221,10 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
             // GetAngle will always return the minor angle. Switch if needed
             Base::Vector3d anorm = (last0 - center0) % (next0 - center0);
             if (anorm.*pz < 0) {
-                if(name == "G3" || name == "G03")
+                if(type == Path::CommandType::ArcCCW)
                     angle = M_PI * 2 - angle;
             } else if(anorm.*pz > 0) {
-                if(name == "G2" || name == "G02")
+                if(type == Path::CommandType::ArcCW)
                     angle = M_PI * 2 - angle;
             } else if (angle == 0)
                 angle = M_PI * 2;
@@ -259,27 +259,27 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
             C = c;
             lrot = nrot;
 
-        } else if (name == "G90") {
+        } else if (type == Path::CommandType::Absolute) {
             // absolute mode
             absolute = true;
 
-        } else if (name == "G91") {
+        } else if (type == Path::CommandType::Relative) {
             // relative mode
             absolute = false;
 
-        } else if (name == "G90.1") {
+        } else if (type == Path::CommandType::AbsoluteCenter) {
             // absolute mode
             absolutecenter = true;
 
-        } else if (name == "G91.1") {
+        } else if (type == Path::CommandType::RelativeCenter) {
             // relative mode
             absolutecenter = false;
 
-        } else if ((name=="G81")||(name=="G82")||(name=="G83")||(name=="G84")||(name=="G85")||(name=="G86")||(name=="G89")){
+        } else if (type == Path::CommandType::Drill) {
             // drill,tap,bore
             double r = 0;
-            if (cmd.has("R"))
-                r = cmd.getValue("R");
+            if (cmd.has('R'))
+                r = cmd.getParam('R');
 
             std::deque<Base::Vector3d> plist;
             std::deque<Base::Vector3d> qlist;
@@ -314,8 +314,8 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
             Base::Vector3d p2r = compensateRotation(p2, nrot, rotCenter);
 
             double q;
-            if (cmd.has("Q")) {
-                q = cmd.getValue("Q");
+            if (cmd.has('Q')) {
+                q = cmd.getParam('Q');
                 if (q>0) {
                     Base::Vector3d temp(next);
                     for(temp.*pz=r;temp.*pz>next.*pz;temp.*pz-=q) {
@@ -342,14 +342,14 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
             lrot = nrot;
 
 
-        } else if ((name=="G38.2")||(name=="38.3")||(name=="G38.4")||(name=="G38.5")){
+        } else if (type == Path::CommandType::Probe) {
             // Straight probe
             cb.g38(i, last, next);
-        } else if(name=="G17") {
+        } else if(type == Path::CommandType::PlaneXY) {
             pz = &Base::Vector3d::z;
-        } else if(name=="G18") {
+        } else if(type == Path::CommandType::PlaneXZ) {
             pz = &Base::Vector3d::y;
-        } else if(name=="G19") {
+        } else if(type == Path::CommandType::PlaneYZ) {
             pz = &Base::Vector3d::x;
         }
     }
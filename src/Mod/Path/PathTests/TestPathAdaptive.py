@@ -0,0 +1,83 @@
+# -*- coding: utf-8 -*-
+# ***************************************************************************
+# *   Copyright (c) 2021 FreeCAD Developers                                 *
+# *                                                                         *
+# *   This program is free software; you can redistribute it and/or modify  *
+# *   it under the terms of the GNU Lesser General Public License (LGPL)    *
+# *   as published by the Free Software Foundation; either version 2 of     *
+# *   the License, or (at your option) any later version.                   *
+# *   for detail see the LICENCE text file.                                 *
+# *                                                                         *
+# *   This program is distributed in the hope that it will be useful,       *
+# *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+# *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+# *   GNU Library General Public License for more details.                  *
+# *                                                                         *
+# *   You should have received a copy of the GNU Library General Public     *
+# *   License along with this program; if not, write to the Free Software   *
+# *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+# *   USA                                                                   *
+# *                                                                         *
+# ***************************************************************************
+
+import area
+import PathTests.PathTestUtils as PathTestUtils
+
+
+def square(x, y, size):
+    return [(x, y), (x + size, y), (x + size, y + size), (x, y + size), (x, y)]
+
+
+def squareWithHole(x, y, size):
+    hole = square(x + size / 3.0, y + size / 3.0, size / 3.0)
+    hole.reverse()
+    return [square(x, y, size), hole]
+
+
+class TestPathAdaptive(PathTestUtils.PathTestBase):
+
+    def execute(self, paths):
+        a2d = area.Adaptive2d()
+        a2d.stepOverFactor = 0.2
+        a2d.toolDiameter = 2.0
+        a2d.helixRampDiameter = 1.0
+        a2d.keepToolDownDistRatio = 3.0
+        a2d.stockToLeave = 0.0
+        a2d.tolerance = 0.1
+        a2d.forceInsideOut = False
+        a2d.opType = area.AdaptiveOperationType.ClearingInside
+
+        stock = [square(-10, -10, 100)]
+        results = a2d.Execute(stock, paths, lambda tpaths: False)
+        return [self.toList(r) for r in results]
+
+    def toList(self, result):
+        paths = [(int(p[0]), [(round(x, 6), round(y, 6)) for x, y in p[1]]) for p in result.AdaptivePaths]
+        return (result.HelixCenterPoint, result.StartPoint, int(result.ReturnMotionType), paths)
+
+    def test00(self):
+        '''Verify that regions cleared in parallel match the regions cleared one at a time.'''
+        pockets = [[square(0, 0, 20)], squareWithHole(30, 0, 20), [square(0, 30, 15)], squareWithHole(30, 30, 25)]
+
+        # a single region is cleared on the calling thread
+        serial = []
+        for pocket in pockets:
+            results = self.execute(pocket)
+            self.assertEqual(len(results), 1)
+            serial.extend(results)
+
+        paths = []
+        for pocket in pockets:
+            paths.extend(pocket)
+        parallel = self.execute(paths)
+        self.assertEqual(len(parallel), len(pockets))
+
+        # the order of the regions depends on the clipper offset, not on the input
+        self.assertEqual(sorted(parallel), sorted(serial))
+
+    def test01(self):
+        '''Verify that the result of several regions doesn't depend on thread timing.'''
+        paths = [square(0, 0, 20)] + squareWithHole(30, 0, 20) + [square(0, 30, 15)]
+        first = self.execute(paths)
+        for i in range(3):
+            self.assertEqual(self.execute(paths), first)
@@ -0,0 +1,85 @@
+# -*- coding: utf-8 -*-
+# ***************************************************************************
+# *   Copyright (c) 2026 FreeCAD Developers                                 *
+# *                                                                         *
+# *   This program is free software; you can redistribute it and/or modify  *
+# *   it under the terms of the GNU Lesser General Public License (LGPL)    *
+# *   as published by the Free Software Foundation; either version 2 of     *
+# *   the License, or (at your option) any later version.                   *
+# *   for detail see the LICENCE text file.                                 *
+# *                                                                         *
+# *   This program is distributed in the hope that it will be useful,       *
+# *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+# *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+# *   GNU Library General Public License for more details.                  *
+# *                                                                         *
+# *   You should have received a copy of the GNU Library General Public     *
+# *   License along with this program; if not, write to the Free Software   *
+# *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+# *   USA                                                                   *
+# *                                                                         *
+# ***************************************************************************
+
+import FreeCAD
+import Part
+import Path
+import PathTests.PathTestUtils as PathTestUtils
+
+from FreeCAD import Vector
+
+
+class TestPathArea(PathTestUtils.PathTestBase):
+    """Sections of several heights are made and pocketed in parallel, they
+    must not depend on each other nor modify the sectioned shape."""
+
+    def setUp(self):
+        # a cone with an off-center hole, so that every section is different
+        self.solid = Part.makeCone(20, 5, 20).cut(Part.makeCylinder(3, 20, Vector(5, 0, 0)))
+        self.tolerance = self.solid.getTolerance(1)
+        self.heights = [1.0 + 2 * i for i in range(9)]
+
+    def tearDown(self):
+        # the solid is shared by all sections, sectioning must leave it alone
+        self.assertEqual(self.solid.getTolerance(1), self.tolerance)
+
+    def sections(self, heights, **params):
+        area = Path.Area(**params)
+        area.add(self.solid)
+        return [s.getShape() for s in area.makeSections(mode=0, heights=heights)]
+
+    def assertSameShape(self, s1, s2):
+        self.assertEqual(len(s1.Edges), len(s2.Edges))
+        self.assertRoughly(s1.Length, s2.Length)
+        self.assertRoughly(s1.BoundBox.XMin, s2.BoundBox.XMin)
+        self.assertRoughly(s1.BoundBox.XMax, s2.BoundBox.XMax)
+        self.assertRoughly(s1.BoundBox.YMin, s2.BoundBox.YMin)
+        self.assertRoughly(s1.BoundBox.YMax, s2.BoundBox.YMax)
+        self.assertRoughly(s1.BoundBox.ZMin, s2.BoundBox.ZMin)
+
+    def assertSerialSections(self, **params):
+        parallel = self.sections(self.heights, **params)
+        self.assertEqual(len(parallel), len(self.heights))
+        for height, shape in zip(self.heights, parallel):
+            serial = self.sections([height], **params)
+            self.assertEqual(len(serial), 1)
+            self.assertSameShape(shape, serial[0])
+
+    def test00(self):
+        """Verify that parallel sections match the slices of the solid."""
+        for height, shape in zip(self.heights, self.sections(self.heights)):
+            wires = self.solid.slice(Vector(0, 0, 1), height)
+            # the section is approximated by libarea within its accuracy
+            self.assertRoughly(shape.Length, sum(w.Length for w in wires), 0.1)
+            self.assertRoughly(shape.BoundBox.ZMin, height)
+
+    def test01(self):
+        """Verify that zig zag pockets of parallel sections match the serial ones."""
+        self.assertSerialSections(PocketMode=1, ToolRadius=1.0, PocketStepover=0.5)
+
+    def test02(self):
+        """Verify that offset pockets of parallel sections match the serial ones."""
+        self.assertSerialSections(PocketMode=4, ToolRadius=1.0, PocketStepover=0.5)
+
+    def test03(self):
+        """Verify that offsets of parallel sections match the serial ones."""
+        self.assertSerialSections(Offset=-1.0, ExtraPass=3, Stepover=0.5)
@@ -124,6 +124,41 @@ G0 Z0.500000
         p.setFromGCode(lines)
         self.assertEqual (p.toGCode(), output)
 
+    def test11(self):
+        """Test Path Object editing"""
+
+        c1=Path.Command("G1",{"X":1,"Y":2})
+        c2=Path.Command("G0",{"Z":5,"XA":3})
+        c3=Path.Command("G2",{"X":0,"Y":0,"I":0.5,"J":0.5})
+        p=Path.Path([c1,c3])
+        p.insertCommand(c2,1)
+        self.assertEqual(str(p.Commands), '[Command G1 [ X:1 Y:2 ], Command G0 [ XA:3 Z:5 ], Command G2 [ I:0.5 J:0.5 X:0 Y:0 ]]')
+        self.assertEqual(p.toGCode(), 'G1 X1.000000 Y2.000000\nG0 XA3.000000 Z5.000000\nG2 I0.500000 J0.500000 X0.000000 Y0.000000\n')
+
+        p.deleteCommand(0)
+        self.assertEqual(str(p.Commands), '[Command G0 [ XA:3 Z:5 ], Command G2 [ I:0.5 J:0.5 X:0 Y:0 ]]')
+        p.deleteCommand()
+        self.assertEqual(str(p.Commands), '[Command G0 [ XA:3 Z:5 ]]')
+        self.assertEqual(str(p.copy().Commands), '[Command G0 [ XA:3 Z:5 ]]')
+
+    def test12(self):
+        """Test Path Object gcode parsing and output"""
+
+        lines = '(Setup  part 1)\nG20\ng1 x1 y0.5 F10\nG21\nG1 X1 Y-0.25\nM5\n'
+        output = '(Setup  part 1)\nG1 F254.000000 X25.400000 Y12.700000\nG1 X1.000000 Y-0.250000\nM5\n'
+
+        p = Path.Path()
+        p.setFromGCode(lines)
+        self.assertEqual(len(p.Commands), 4)
+        self.assertEqual(p.toGCode(), output)
+
+        # the output parses back to the same path
+        q = Path.Path()
+        q.setFromGCode(p.toGCode())
+        self.assertEqual(q.toGCode(), output)
+
+        self.assertRaises(Exception, p.setFromGCode, 'G1 X1\nG1 XY1\n')
+
     def test20(self):
         """Test Path Tool and ToolTable object core functionality"""
 
@@ -23,6 +23,8 @@
 import TestApp
 
 from PathTests.TestPathLog   import TestPathLog
+from PathTests.TestPathAdaptive import TestPathAdaptive
+from PathTests.TestPathArea import TestPathArea
 from PathTests.TestPathPreferences  import TestPathPreferences
 from PathTests.TestPathCore  import TestPathCore
 #from PathTests.TestPathPost  import PathPostTestCases
@@ -45,6 +47,8 @@ from PathTests.TestPathVoronoi  import TestPathVoronoi
 # dummy usage to get flake8 and lgtm quiet
 False if TestApp.__name__ else True
 False if TestPathLog.__name__ else True
+False if TestPathAdaptive.__name__ else True
+False if TestPathArea.__name__ else True
 False if TestPathCore.__name__ else True
 False if TestPathGeom.__name__ else True
 False if TestPathOpTools.__name__ else True
@@ -26,6 +26,10 @@
 #include <cstring>
 #include <ctime>
 #include <algorithm>
+#include <chrono>
+#include <exception>
+#include <random>
+#include <sstream>
 
 namespace ClipperLib
 {
@@ -1114,7 +1118,8 @@ class Interpolation
 
 	double getRandomAngle()
 	{
-		return MIN_ANGLE + (MAX_ANGLE - MIN_ANGLE) * double(rand()) / double(RAND_MAX);
+		// own generator per instance, to get the same angles regardless of other threads
+		return MIN_ANGLE + (MAX_ANGLE - MIN_ANGLE) * double(randomEngine() - randomEngine.min()) / double(randomEngine.max() - randomEngine.min());
 	}
 	size_t getPointCount()
 	{
@@ -1124,6 +1129,7 @@ class Interpolation
   private:
 	vector<double> angles;
 	vector<double> areas;
+	std::minstd_rand randomEngine;
 };
 
 //***************************************
@@ -1687,7 +1693,6 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths &stockPaths, const DP
 		scaleFactor = maxScaleFactor;
 	//scaleFactor = round(scaleFactor);
 
-	current_region=0;
 	cout << "Tool Diameter: " << toolDiameter << endl;
 	cout << "Accuracy: " << round(10000.0/scaleFactor)/10 << " um" << endl;
 	cout << flush;
@@ -1695,7 +1700,7 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths &stockPaths, const DP
 	toolRadiusScaled = long(toolDiameter * scaleFactor / 2);
 	stepOverScaled = toolRadiusScaled * stepOverFactor;
 	progressCallback = &progressCallbackFn;
-	lastProgressTime = clock();
+	callbackThread = std::this_thread::get_id();
 	stopProcessing = false;
 
 	if(helixRampDiameter<NTOL)
@@ -1777,6 +1782,7 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths &stockPaths, const DP
 	//	Resolve hierarchy and run processing
 	//***************************************
 	double cornerRoundingOffset = 0.15 * toolRadiusScaled / 2;
+	std::vector<std::pair<Paths, Paths>> regions; // bound paths and tool bound paths of each region
 	if (opType == OperationType::otClearingInside || opType == OperationType::otClearingOutside)
 	{
 
@@ -1829,7 +1835,7 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths &stockPaths, const DP
 				clipof.Clear();
 				clipof.AddPaths(toolBoundPaths, JoinType::jtRound, EndType::etClosedPolygon);
 				clipof.Execute(boundPaths, toolRadiusScaled + finishPassOffsetScaled);
-				ProcessPolyNode(boundPaths, toolBoundPaths);
+				regions.emplace_back(boundPaths, toolBoundPaths);
 			}
 		}
 	}
@@ -1888,11 +1894,12 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths &stockPaths, const DP
 					clipof.AddPaths(toolBoundPaths, JoinType::jtRound, EndType::etClosedPolygon);
 					clipof.Execute(boundPaths, toolRadiusScaled + finishPassOffsetScaled);
 
-					ProcessPolyNode(boundPaths, toolBoundPaths);
+					regions.emplace_back(boundPaths, toolBoundPaths);
 				}
 			}
 		}
 	}
+	ProcessRegions(regions);
 	return results;
 }
 
@@ -1990,7 +1997,7 @@ bool Adaptive2d::FindEntryPoint(TPaths &progressPaths, const Paths &toolBoundPat
 	}
 
 	if (!found)
-		cerr << "Start point not found!" << endl;
+		ReportMessage(true, "Start point not found!");
 	if (found)
 	{
 		// visualize/progress for helix
@@ -2178,14 +2185,16 @@ bool Adaptive2d::ResolveLinkPath(const IntPoint &startPoint, const IntPoint &end
 			return false;
 		if (clock() > time_out)
 		{
-			cout << "Unable to resolve tool down linking path (limit reached)." << endl;
+			ReportMessage(false, "Unable to resolve tool down linking path (limit reached).");
 			return false;
 		}
 
 		cnt++;
 		if (cnt > limit)
 		{
-			cout << "Unable to resolve tool down linking path @(" << endPoint.X / scaleFactor << "," << endPoint.Y / scaleFactor << ") (" << limit << " points limit reached)." << endl;
+			std::ostringstream message;
+			message << "Unable to resolve tool down linking path @(" << endPoint.X / scaleFactor << "," << endPoint.Y / scaleFactor << ") (" << limit << " points limit reached).";
+			ReportMessage(false, message.str());
 			return false;
 		}
 		pair<IntPoint, IntPoint> pointPair = queue.back();
@@ -2196,7 +2205,7 @@ bool Adaptive2d::ResolveLinkPath(const IntPoint &startPoint, const IntPoint &end
 		{
 			if (linkPaths[i].front() != pointPair.first && linkPaths[i].back() != pointPair.first && linkPaths[i].front() != pointPair.second && linkPaths[i].back() != pointPair.second && IntersectionPoint(linkPaths[i].front(), linkPaths[i].back(), pointPair.first, pointPair.second, clp))
 			{
-				cout << "Unable to resolve tool down linking path (self-intersects)." << endl;
+				ReportMessage(false, "Unable to resolve tool down linking path (self-intersects).");
 				return false;
 			}
 		}
@@ -2548,16 +2557,20 @@ void Adaptive2d::AppendToolPath(TPaths &progressPaths, AdaptiveOutput &output,
 	Perf_AppendToolPath.Stop();
 }
 
-void Adaptive2d::CheckReportProgress(TPaths &progressPaths, bool force)
+void Adaptive2d::CheckReportProgress(TPaths &progressPaths, clock_t &lastProgressTime, bool force)
 {
 	if (!force && (clock() - lastProgressTime < PROGRESS_TICKS))
 		return; // not yet
 	lastProgressTime = clock();
 	if (progressPaths.size() == 0)
 		return;
-	if (progressCallback)
-		if ((*progressCallback)(progressPaths))
-			stopProcessing = true; // call python function, if returns true signal stop processing
+	{
+		std::lock_guard<std::mutex> lock(progressMutex);
+		pendingProgress.insert(pendingProgress.end(), progressPaths.begin(), progressPaths.end());
+	}
+	// worker threads leave the callback to the thread waiting for them in ProcessRegions
+	if (std::this_thread::get_id() == callbackThread)
+		ReportProgress();
 	// clean the paths - keep the last point
 	if (progressPaths.back().second.size() == 0)
 		return;
@@ -2572,6 +2585,43 @@ void Adaptive2d::CheckReportProgress(TPaths &progressPaths, bool force)
 	progressPaths.front().second.push_back(next);
 }
 
+void Adaptive2d::ReportMessage(bool error, const std::string &message)
+{
+	{
+		std::lock_guard<std::mutex> lock(progressMutex);
+		pendingMessages.emplace_back(error, message);
+	}
+	// the messages of worker threads are printed along with their progress, so that they don't get mixed
+	if (std::this_thread::get_id() == callbackThread)
+		FlushMessages();
+}
+
+void Adaptive2d::FlushMessages()
+{
+	std::vector<std::pair<bool, std::string>> messages;
+	{
+		std::lock_guard<std::mutex> lock(progressMutex);
+		messages.swap(pendingMessages);
+	}
+	for (const auto &message : messages)
+		(message.first ? cerr : cout) << message.second << endl;
+}
+
+void Adaptive2d::ReportProgress()
+{
+	FlushMessages();
+	TPaths progressPaths;
+	{
+		std::lock_guard<std::mutex> lock(progressMutex);
+		progressPaths.swap(pendingProgress);
+	}
+	if (progressPaths.size() == 0)
+		return;
+	if (progressCallback)
+		if ((*progressCallback)(progressPaths))
+			stopProcessing = true; // call python function, if returns true signal stop processing
+}
+
 void Adaptive2d::AddPathsToProgress(TPaths &progressPaths, Paths paths, MotionType mt)
 {
 	for (const auto &pth : paths)
@@ -2598,11 +2648,77 @@ void Adaptive2d::AddPathToProgress(TPaths &progressPaths, const Path pth, Motion
 	}
 }
 
-void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
+void Adaptive2d::ProcessRegions(const std::vector<std::pair<Paths, Paths>> &regions)
+{
+	// the regions are independent, so they are processed by a number of worker threads,
+	// while this thread reports their progress. Results are kept in the order of the regions.
+	std::vector<AdaptiveOutput> outputs(regions.size());
+	std::vector<char> done(regions.size(), 0);
+	std::vector<std::exception_ptr> errors(regions.size());
+	std::atomic<size_t> nextRegion(0);
+
+	auto worker = [&]() {
+		for (size_t i = nextRegion++; i < regions.size(); i = nextRegion++)
+		{
+			try
+			{
+				done[i] = ProcessPolyNode(i, regions[i].first, regions[i].second, outputs[i]);
+			}
+			catch (...)
+			{
+				errors[i] = std::current_exception();
+				stopProcessing = true;
+			}
+		}
+		std::lock_guard<std::mutex> lock(progressMutex);
+		runningWorkers--;
+		progressCondition.notify_all();
+	};
+
+	size_t threadCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), regions.size());
+#ifdef DEV_MODE
+	threadCount = 0; // drawing functions must be called from this thread
+#endif
+	if (threadCount <= 1)
+	{
+		runningWorkers = 1;
+		worker();
+	}
+	else
+	{
+		runningWorkers = threadCount;
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < threadCount; i++)
+			threads.emplace_back(worker);
+
+		const auto interval = std::chrono::milliseconds(1000 * PROGRESS_TICKS / CLOCKS_PER_SEC);
+		std::unique_lock<std::mutex> lock(progressMutex);
+		while (runningWorkers > 0)
+		{
+			progressCondition.wait_for(lock, interval);
+			lock.unlock();
+			ReportProgress();
+			lock.lock();
+		}
+		lock.unlock();
+		for (auto &thread : threads)
+			thread.join();
+		ReportProgress();
+	}
+
+	for (size_t i = 0; i < regions.size(); i++)
+	{
+		if (errors[i])
+			std::rethrow_exception(errors[i]);
+		if (done[i])
+			results.push_back(outputs[i]);
+	}
+}
+
+bool Adaptive2d::ProcessPolyNode(size_t region, Paths boundPaths, Paths toolBoundPaths, AdaptiveOutput &output)
 {
 	Perf_ProcessPolyNode.Start();
-	current_region++;
-	cout << "** Processing region: " << current_region << endl;
+	ReportMessage(false, "** Processing region: " + std::to_string(region + 1));
 
 	// node paths are already constrained to tool boundary path for adaptive path before finishing pass
 	Clipper clip;
@@ -2611,6 +2727,7 @@ void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
 	IntPoint entryPoint;
 	TPaths progressPaths;
 	progressPaths.reserve(10000);
+	clock_t lastProgressTime = clock();
 
 	CleanPolygons(toolBoundPaths);
 	SimplifyPolygons(toolBoundPaths);
@@ -2647,7 +2764,7 @@ void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
 		if (!FindEntryPoint(progressPaths, toolBoundPaths, boundPaths, cleared, entryPoint, toolPos, toolDir))
 		{
 			Perf_ProcessPolyNode.Stop();
-			return;
+			return false;
 		}
 	}
 
@@ -2664,7 +2781,6 @@ void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
 
 	//cout << "Entry point:" << double(entryPoint.X)/scaleFactor << "," << double(entryPoint.Y)/scaleFactor << endl;
 
-	AdaptiveOutput output;
 	output.HelixCenterPoint.first = double(entryPoint.X) / scaleFactor;
 	output.HelixCenterPoint.second = double(entryPoint.Y) / scaleFactor;
 
@@ -2674,7 +2790,7 @@ void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
 	IntPoint newToolPos;
 	DoublePoint newToolDir;
 
-	CheckReportProgress(progressPaths, true);
+	CheckReportProgress(progressPaths, lastProgressTime, true);
 
 	IntPoint startPoint = toolPos;
 	output.StartPoint = DPoint(double(startPoint.X) / scaleFactor, double(startPoint.Y) / scaleFactor);
@@ -2928,7 +3044,7 @@ void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
 				// append gyro
 				gyro.push_back(newToolDir);
 				gyro.erase(gyro.begin());
-				CheckReportProgress(progressPaths);
+				CheckReportProgress(progressPaths, lastProgressTime);
 			}
 			else
 			{
@@ -2955,7 +3071,7 @@ void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
 			CleanPath(passToolPath, cleaned, CLEAN_PATH_TOLERANCE);
 			total_output_points += long(cleaned.size());
 			AppendToolPath(progressPaths, output, cleaned, clearedBeforePass, cleared, toolBoundPaths);
-			CheckReportProgress(progressPaths);
+			CheckReportProgress(progressPaths, lastProgressTime);
 			bad_engage_count = 0;
 			engage.ResetPasses();
 		}
@@ -2966,7 +3082,7 @@ void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
 
 		if (bad_engage_count > 10000)
 		{
-			cerr << "Break (next valid engage point not found)." << endl;
+			ReportMessage(true, "Break (next valid engage point not found).");
 			break;
 		}
 
@@ -2995,12 +3111,12 @@ void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
 				};
 				if (remaining.empty())
 				{
-					cout << "All cleared." << endl;
+					ReportMessage(false, "All cleared.");
 					break;
 				}
 				else
 				{
-					cout << "Clearing " << remaining.size() << " remaining internal path(s)." << endl;
+					ReportMessage(false, "Clearing " + std::to_string(remaining.size()) + " remaining internal path(s).");
 				}
 
 				// try to find new engage point along the remaining
@@ -3120,7 +3236,7 @@ void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
 	Perf_IsAllowedToCutTrough.DumpResults();
 	Perf_IsClearPath.DumpResults();
 #endif
-	CheckReportProgress(progressPaths, true);
+	CheckReportProgress(progressPaths, lastProgressTime, true);
 #ifdef DEV_MODE
 	double duration = ((double)(clock() - start_clock)) / CLOCKS_PER_SEC;
 	cout << "PolyNode perf:" << perf_total_len / double(scaleFactor) / duration << " mm/sec"
@@ -3135,11 +3251,11 @@ void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
 	// warn about invalid paths being detected
 	if (!allCutsAllowed)
 	{
-		cerr << "Warning: some cuts may be above optimal step-over. Please double check the results." << endl
-			 << "Hint: try to modify accuracy and/or step-over." << endl;
+		ReportMessage(true, "Warning: some cuts may be above optimal step-over. Please double check the results.\n"
+							"Hint: try to modify accuracy and/or step-over.");
 	}
 
-	results.push_back(output);
+	return true;
 }
 
 } // namespace AdaptivePath
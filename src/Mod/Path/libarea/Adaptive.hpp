@@ -21,6 +21,12 @@
 ***************************************************************************/
 
 #include "clipper.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 #include <list>
 #include <time.h>
@@ -81,7 +87,7 @@ struct AdaptiveOutput
 	int ReturnMotionType; // MotionType enum, problem with serialization if enum is used
 };
 
-// used to isolate state -> enable potential adding of multi-threaded processing of separate regions
+// used to isolate state -> separate regions are processed by multiple threads
 
 class Adaptive2d
 {
@@ -117,14 +123,19 @@ class Adaptive2d
 	long helixRampRadiusScaled = 0;
 	double referenceCutArea = 0;
 	double optimalCutAreaPD = 0;
-	bool stopProcessing = false;
-	int current_region=0;
-	clock_t lastProgressTime = 0;
+	std::atomic<bool> stopProcessing{false};
 
 	std::function<bool(TPaths)> *progressCallback = NULL;
+	std::thread::id callbackThread; // the progress callback is only called from this thread
+	std::mutex progressMutex;
+	std::condition_variable progressCondition;
+	TPaths pendingProgress; // progress paths not yet passed to the callback, guarded by progressMutex
+	std::vector<std::pair<bool, std::string>> pendingMessages; // messages of the worker threads (error flag, text), guarded by progressMutex
+	size_t runningWorkers = 0; // guarded by progressMutex
 	Path toolGeometry; // tool geometry at coord 0,0, should not be modified
 
-	void ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths);
+	void ProcessRegions(const std::vector<std::pair<Paths, Paths>> &regions);
+	bool ProcessPolyNode(size_t region, Paths boundPaths, Paths toolBoundPaths, AdaptiveOutput &output /*output*/);
 	bool FindEntryPoint(TPaths &progressPaths, const Paths &toolBoundPaths, const Paths &bound, ClearedArea &cleared /*output*/,
 						IntPoint &entryPoint /*output*/, IntPoint &toolPos, DoublePoint &toolDir);
 	bool FindEntryPointOutside(TPaths &progressPaths, const Paths &toolBoundPaths, const Paths &bound, ClearedArea &cleared /*output*/,
@@ -141,7 +152,10 @@ class Adaptive2d
 
 	friend class EngagePoint; // for CalcCutArea
 
-	void CheckReportProgress(TPaths &progressPaths, bool force = false);
+	void CheckReportProgress(TPaths &progressPaths, clock_t &lastProgressTime, bool force = false);
+	void ReportProgress();
+	void ReportMessage(bool error, const std::string &message);
+	void FlushMessages();
 	void AddPathsToProgress(TPaths &progressPaths, const Paths paths, MotionType mt = MotionType::mtCutting);
 	void AddPathToProgress(TPaths &progressPaths, const Path pth, MotionType mt = MotionType::mtCutting);
 	void ApplyStockToLeave(Paths &inputPaths);
@@ -8,20 +8,20 @@
 
 #include <map>
 
-double CArea::m_accuracy = 0.01;
-double CArea::m_units = 1.0;
-bool CArea::m_clipper_simple = false;
-double CArea::m_clipper_clean_distance = 0.0;
-bool CArea::m_fit_arcs = true;
-int CArea::m_min_arc_points = 4;
-int CArea::m_max_arc_points = 100;
-double CArea::m_single_area_processing_length = 0.0;
-double CArea::m_processing_done = 0.0;
-bool CArea::m_please_abort = false;
-double CArea::m_MakeOffsets_increment = 0.0;
-double CArea::m_split_processing_length = 0.0;
-bool CArea::m_set_processing_length_in_split = false;
-double CArea::m_after_MakeOffsets_length = 0.0;
+thread_local double CArea::m_accuracy = 0.01;
+thread_local double CArea::m_units = 1.0;
+thread_local bool CArea::m_clipper_simple = false;
+thread_local double CArea::m_clipper_clean_distance = 0.0;
+thread_local bool CArea::m_fit_arcs = true;
+thread_local int CArea::m_min_arc_points = 4;
+thread_local int CArea::m_max_arc_points = 100;
+thread_local double CArea::m_single_area_processing_length = 0.0;
+thread_local double CArea::m_processing_done = 0.0;
+std::atomic<bool> CArea::m_please_abort(false);
+thread_local double CArea::m_MakeOffsets_increment = 0.0;
+thread_local double CArea::m_split_processing_length = 0.0;
+thread_local bool CArea::m_set_processing_length_in_split = false;
+thread_local double CArea::m_after_MakeOffsets_length = 0.0;
 //static const double PI = 3.1415926535897932;
 
 #define _CAREA_PARAM_DEFINE(_class,_type,_name) \
@@ -192,15 +192,16 @@ public:
 	ZigZag(const CCurve& Zig, const CCurve& Zag):zig(Zig), zag(Zag){}
 };
 
-static double stepover_for_pocket = 0.0;
-static std::list<ZigZag> zigzag_list_for_zigs;
-static std::list<CCurve> *curve_list_for_zigs = NULL;
-static bool rightward_for_zigs = true;
-static double sin_angle_for_zigs = 0.0;
-static double cos_angle_for_zigs = 0.0;
-static double sin_minus_angle_for_zigs = 0.0;
-static double cos_minus_angle_for_zigs = 0.0;
-static double one_over_units = 0.0;
+// state of the zig zag pocket, per thread to pocket several areas at once
+static thread_local double stepover_for_pocket = 0.0;
+static thread_local std::list<ZigZag> zigzag_list_for_zigs;
+static thread_local std::list<CCurve> *curve_list_for_zigs = NULL;
+static thread_local bool rightward_for_zigs = true;
+static thread_local double sin_angle_for_zigs = 0.0;
+static thread_local double cos_angle_for_zigs = 0.0;
+static thread_local double sin_minus_angle_for_zigs = 0.0;
+static thread_local double cos_minus_angle_for_zigs = 0.0;
+static thread_local double one_over_units = 0.0;
 
 static Point rotated_point(const Point &p)
 {
@@ -404,7 +405,7 @@ void make_zig(const CArea &a, double y0, double y)
 	}
 }
         
-std::list< std::list<ZigZag> > reorder_zig_list_list;
+static thread_local std::list< std::list<ZigZag> > reorder_zig_list_list;
         
 void add_reorder_zig(ZigZag &zigzag)
 {
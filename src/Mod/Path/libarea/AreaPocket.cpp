@@ -9,7 +9,8 @@
 #include <map>
 #include <set>
 
-static const CAreaPocketParams* pocket_params = NULL;
+// the pocket state is kept per thread, so that several areas can be pocketed at once
+static thread_local const CAreaPocketParams* pocket_params = NULL;
 
 class IslandAndOffset
 {
@@ -44,9 +45,9 @@ public:
 
 class CurveTree
 {
-	static std::list<CurveTree*> to_do_list_for_MakeOffsets;
+	static thread_local std::list<CurveTree*> to_do_list_for_MakeOffsets;
 	void MakeOffsets2();
-	static std::list<CurveTree*> islands_added;
+	static thread_local std::list<CurveTree*> islands_added;
 
 public:
 	Point point_on_parent;
@@ -61,14 +62,14 @@ public:
 
 	void MakeOffsets();
 };
-std::list<CurveTree*> CurveTree::islands_added;
+thread_local std::list<CurveTree*> CurveTree::islands_added;
 
 class GetCurveItem
 {
 public:
 	CurveTree* curve_tree;
 	std::list<CVertex>::iterator EndIt;
-	static std::list<GetCurveItem> to_do_list;
+	static thread_local std::list<GetCurveItem> to_do_list;
 
 	GetCurveItem(CurveTree* ct, std::list<CVertex>::iterator EIt):curve_tree(ct), EndIt(EIt){}
 
@@ -76,8 +77,8 @@ public:
 	CVertex& back(){std::list<CVertex>::iterator It = EndIt; It--; return *It;}
 };
 
-std::list<GetCurveItem> GetCurveItem::to_do_list;
-std::list<CurveTree*> CurveTree::to_do_list_for_MakeOffsets;
+thread_local std::list<GetCurveItem> GetCurveItem::to_do_list;
+thread_local std::list<CurveTree*> CurveTree::to_do_list_for_MakeOffsets;
 
 void GetCurveItem::GetCurve(CCurve& output)
 {
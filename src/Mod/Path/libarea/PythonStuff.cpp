@@ -524,7 +524,7 @@ BOOST_PYTHON_MODULE(area) {
 		.add_property("AdaptivePaths", &AdaptiveOutput_AdaptivePaths)
 		.def_readonly("ReturnMotionType",&AdaptiveOutput::ReturnMotionType);
 
-	bp::class_<Adaptive2d>("Adaptive2d")
+	bp::class_<Adaptive2d, boost::noncopyable>("Adaptive2d")
 		.def(bp::init<>())
 		.def("Execute",&AdaptiveExecute)
 	 	.def_readwrite("stepOverFactor", &Adaptive2d::stepOverFactor)
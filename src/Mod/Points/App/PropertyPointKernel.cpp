@@ -31,6 +31,7 @@
 
 #include <Base/Exception.h>
 #include <Base/Matrix.h>
+#include <Base/Reader.h>
 #include <Base/Stream.h>
 #include <Base/Writer.h>
 
@@ -54,27 +55,32 @@ PropertyPointKernel::~PropertyPointKernel()
 void PropertyPointKernel::setValue(const PointKernel& m)
 {
     aboutToSetValue();
+    discardDeferred();
     *_cPoints = m;
     hasSetValue();
 }
 
 const PointKernel& PropertyPointKernel::getValue(void) const 
 {
+    restoreDeferred();
     return *_cPoints;
 }
 
 const Data::ComplexGeoData* PropertyPointKernel::getComplexData() const
 {
+    restoreDeferred();
     return _cPoints;
 }
 
 Base::BoundBox3d PropertyPointKernel::getBoundingBox() const
 {
+    restoreDeferred();
     return _cPoints->getBoundBox();
 }
 
 PyObject *PropertyPointKernel::getPyObject(void)
 {
+    restoreDeferred();
     PointsPy* points = new PointsPy(&*_cPoints);
     points->setConst(); // set immutable
     return points;
@@ -95,6 +101,7 @@ void PropertyPointKernel::setPyObject(PyObject *value)
 
 void PropertyPointKernel::Save (Base::Writer &writer) const
 {
+    restoreDeferred();
     _cPoints->Save(writer);
 }
 
@@ -103,10 +110,6 @@ void PropertyPointKernel::Restore(Base::XMLReader &reader)
     reader.readElement("Points");
     std::string file (reader.getAttribute("file") );
 
-    if (!file.empty()) {
-        // initiate a file read
-        reader.addFile(file.c_str(),this);
-    }
     if(reader.DocumentSchema > 3)
     {
         std::string Matrix (reader.getAttribute("mtrx") );
@@ -117,6 +120,12 @@ void PropertyPointKernel::Restore(Base::XMLReader &reader)
         _cPoints->setTransform(mtrx);
         hasSetValue();
     }
+    // the file is registered after the transformation has been set because
+    // the notification would otherwise restore deferred points immediately
+    if (!file.empty()) {
+        // initiate a file read, which may be deferred until the points are needed
+        addDeferredFile(reader, file.c_str());
+    }
 }
 
 void PropertyPointKernel::SaveDocFile (Base::Writer &writer) const
@@ -127,13 +136,18 @@ void PropertyPointKernel::SaveDocFile (Base::Writer &writer) const
 
 void PropertyPointKernel::RestoreDocFile(Base::Reader &reader)
 {
-    aboutToSetValue();
+    // deferred points complete the restored document and thus aren't a change
+    bool notify = !reader.isDeferred();
+    if (notify)
+        aboutToSetValue();
     _cPoints->RestoreDocFile(reader);
-    hasSetValue();
+    if (notify)
+        hasSetValue();
 }
 
 App::Property *PropertyPointKernel::Copy(void) const 
 {
+    restoreDeferred();
     PropertyPointKernel* prop = new PropertyPointKernel();
     (*prop->_cPoints) = (*this->_cPoints);
     return prop;
@@ -142,6 +156,7 @@ App::Property *PropertyPointKernel::Copy(void) const
 void PropertyPointKernel::Paste(const App::Property &from)
 {
     aboutToSetValue();
+    discardDeferred();
     const PropertyPointKernel& prop = dynamic_cast<const PropertyPointKernel&>(from);
     *(this->_cPoints) = *(prop._cPoints);
     hasSetValue();
@@ -149,11 +164,13 @@ void PropertyPointKernel::Paste(const App::Property &from)
 
 unsigned int PropertyPointKernel::getMemSize (void) const
 {
-    return sizeof(Base::Vector3f) * this->_cPoints->size();
+    // points not restored yet are estimated by the size of their data file
+    return sizeof(Base::Vector3f) * this->_cPoints->size() + getDeferredSize();
 }
 
 PointKernel* PropertyPointKernel::startEditing()
 {
+    restoreDeferred();
     aboutToSetValue();
     return static_cast<PointKernel*>(_cPoints);
 }
@@ -165,6 +182,7 @@ void PropertyPointKernel::finishEditing()
 
 void PropertyPointKernel::removeIndices( const std::vector<unsigned long>& uIndices )
 {
+    restoreDeferred();
     // We need a sorted array
     std::vector<unsigned long> uSortedInds = uIndices;
     std::sort(uSortedInds.begin(), uSortedInds.end());
@@ -191,8 +209,16 @@ void PropertyPointKernel::removeIndices( const std::vector<unsigned long>& uIndi
     setValue(kernel);
 }
 
+void PropertyPointKernel::setTransform(const Base::Matrix4D &rclTrf)
+{
+    // The placement doesn't need the points. Pending points are read
+    // into the same kernel later on and keep the transformation.
+    _cPoints->setTransform(rclTrf);
+}
+
 void PropertyPointKernel::transformGeometry(const Base::Matrix4D &rclMat)
 {
+    restoreDeferred();
     aboutToSetValue();
     _cPoints->transformGeometry(rclMat);
     hasSetValue();
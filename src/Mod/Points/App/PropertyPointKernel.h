@@ -83,6 +83,8 @@ public:
     void finishEditing();
     /// Transform the real 3d point kernel
     void transformGeometry(const Base::Matrix4D &rclMat);
+    /// Set the placement of the points without notification
+    void setTransform(const Base::Matrix4D &rclTrf);
     void removeIndices( const std::vector<unsigned long>& );
     //@}
 
@@ -1701,8 +1701,9 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         return Success;
 
     Eigen::VectorXd e(csize), e_new(csize); // vector of all function errors (every constraint is one function)
-    Eigen::MatrixXd J(csize, xsize);        // Jacobi of the subsystem
-    Eigen::MatrixXd A(xsize, xsize);
+    Eigen::SparseMatrix<double> J(csize, xsize); // Jacobi of the subsystem
+    Eigen::SparseMatrix<double> A(xsize, xsize);
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double> > ldltA;
     Eigen::VectorXd x(xsize), h(xsize), x_new(xsize), g(xsize), diag_A(xsize);
 
     subsys->redirectParams();
@@ -1775,10 +1776,16 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         while (k < 50) {
             // augment normal equations A = A+uI
             for (int i=0; i < xsize; ++i)
-                A(i,i) += mu;
+                A.coeffRef(i,i) += mu;
 
             //solve augmented functions A*h=-g
-            h = A.fullPivLu().solve(g);
+            // A is symmetric and positive definite for mu > 0, so a sparse
+            // Cholesky factorization is used unless it fails numerically
+            ldltA.compute(A);
+            if (ldltA.info() == Eigen::Success)
+                h = ldltA.solve(g);
+            else
+                h = Eigen::MatrixXd(A).fullPivLu().solve(g);
             double rel_error = (A*h - g).norm() / g.norm();
 
             // check if solving works
@@ -1827,7 +1834,7 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
             mu*=nu;
             nu*=2.0;
             for (int i=0; i < xsize; ++i) // restore diagonal J^T J entries
-                A(i,i) = diag_A(i);
+                A.coeffRef(i,i) = diag_A(i);
 
             k++;
         }
@@ -1895,7 +1902,7 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
 
     Eigen::VectorXd x(xsize), x_new(xsize);
     Eigen::VectorXd fx(csize), fx_new(csize);
-    Eigen::MatrixXd Jx(csize, xsize), Jx_new(csize, xsize);
+    Eigen::SparseMatrix<double> Jx(csize, xsize), Jx_new(csize, xsize);
     Eigen::VectorXd g(xsize), h_sd(xsize), h_gn(xsize), h_dl(xsize);
 
     subsys->redirectParams();
@@ -1940,15 +1947,39 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
             // http://forum.freecadweb.org/viewtopic.php?f=10&t=12769&start=50#p106220
             // https://forum.kde.org/viewtopic.php?f=74&t=129439#p346104
             switch (dogLegGaussStep){
-                case FullPivLU:
-                    h_gn = Jx.fullPivLu().solve(-fx);
-                    break;
+                case FullPivLU: {
+                    // The sparse QR gives a basic solution of J*h = -f like the LU does. If
+                    // the system is inconsistent, e.g. for conflicting constraints, the
+                    // dense full pivoting LU is kept.
+                    bool solved = false;
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+                    Jx.makeCompressed();
+                    Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> > qrJx(Jx);
+                    if (qrJx.info() == Eigen::Success) {
+                        h_gn = qrJx.solve(-fx);
+                        solved = qrJx.info() == Eigen::Success && h_gn.size() == xsize && h_gn.allFinite()
+                                 && (Jx*h_gn + fx).norm() <= 1e-8 * fx.norm();
+                    }
+#endif
+                    if (!solved)
+                        h_gn = Eigen::MatrixXd(Jx).fullPivLu().solve(-fx);
+                    } break;
                 case LeastNormFullPivLU:
-                    h_gn = Jx.adjoint()*(Jx*Jx.adjoint()).fullPivLu().solve(-fx);
-                    break;
-                case LeastNormLdlt:
-                    h_gn = Jx.adjoint()*(Jx*Jx.adjoint()).ldlt().solve(-fx);
+                    h_gn = Jx.adjoint()*Eigen::MatrixXd(Jx*Jx.adjoint()).fullPivLu().solve(-fx);
                     break;
+                case LeastNormLdlt: {
+                    // J*J^T is singular for redundant constraints. A component of the
+                    // solution in its kernel is removed by J^T, but if the sparse
+                    // factorization fails the pivoting dense LDLT is used.
+                    Eigen::SparseMatrix<double> JJt = Jx*Jx.adjoint();
+                    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double> > ldltJJt(JJt);
+                    Eigen::VectorXd y;
+                    if (ldltJJt.info() == Eigen::Success)
+                        y = ldltJJt.solve(-fx);
+                    if (y.size() != csize || !y.allFinite() || (JJt*y + fx).norm() > 1e-8 * fx.norm())
+                        y = Eigen::MatrixXd(JJt).ldlt().solve(-fx);
+                    h_gn = Jx.adjoint()*y;
+                    } break;
             }
 
             double rel_error = (Jx*h_gn + fx).norm() / fx.norm();
@@ -3779,22 +3810,24 @@ void System::undoSolution()
     resetToReference();
 }
 
-void System::makeReducedJacobian(Eigen::MatrixXd &J,
+void System::makeReducedJacobian(std::vector<Eigen::Triplet<double> > &J,
                                  std::map<int,int> &jacobianconstraintmap,
                                  GCS::VEC_pD &pdiagnoselist,
                                  std::map< int , int> &tagmultiplicity)
 {
     // construct specific parameter list for diagonose ignoring driven constraint parameters
+    SET_pD pdrivenset(pdrivenlist.begin(), pdrivenlist.end());
+    MAP_pD_I pdiagnoseindex;
     for (int j=0; j < int(plist.size()); j++) {
-        auto result1 = std::find(std::begin(pdrivenlist), std::end(pdrivenlist), plist[j]);
-
-        if (result1 == std::end(pdrivenlist)) {
+        if (pdrivenset.find(plist[j]) == pdrivenset.end()) {
+            pdiagnoseindex[plist[j]] = static_cast<int>(pdiagnoselist.size());
             pdiagnoselist.push_back(plist[j]);
         }
     }
 
-
-    J = Eigen::MatrixXd::Zero(clist.size(), pdiagnoselist.size());
+    // only the non-zero entries are collected: the gradient of a constraint
+    // is evaluated for its own parameters only
+    J.clear();
 
     int jacobianconstraintcount=0;
     int allcount=0;
@@ -3803,8 +3836,12 @@ void System::makeReducedJacobian(Eigen::MatrixXd &J,
         ++allcount;
         if ((*constr)->getTag() >= 0 && (*constr)->isDriving()) {
             jacobianconstraintcount++;
-            for (int j=0; j < int(pdiagnoselist.size()); j++) {
-                J(jacobianconstraintcount-1,j) = (*constr)->grad(pdiagnoselist[j]);
+            VEC_pD constr_params = (*constr)->params();
+            SET_pD constr_paramset(constr_params.begin(), constr_params.end());
+            for (SET_pD::const_iterator p=constr_paramset.begin(); p != constr_paramset.end(); ++p) {
+                MAP_pD_I::const_iterator it = pdiagnoseindex.find(*p);
+                if (it != pdiagnoseindex.end())
+                    J.push_back(Eigen::Triplet<double>(jacobianconstraintcount-1, it->second, (*constr)->grad(*p)));
             }
 
             // parallel processing: create tag multiplicity map
@@ -3864,6 +3901,8 @@ SolverReportingManager::Manager().LogToFile("GCS::System::diagnose()\n");
     // The Jacobian has been reduced to:
     // 1. only contain driving constraints, but keep a full size (zero padded).
     // 2. remove the parameters of the values of driven constraints.
+    // It is assembled from its non-zero entries and only made dense for the dense QR.
+    std::vector<Eigen::Triplet<double> > jacobianentries;
     Eigen::MatrixXd J;
 
     // maps the index of the rows of the reduced jacobian matrix (solver constraints) to
@@ -3878,7 +3917,9 @@ SolverReportingManager::Manager().LogToFile("GCS::System::diagnose()\n");
     std::map< int , int> tagmultiplicity;
 
 
-    makeReducedJacobian(J, jacobianconstraintmap, pdiagnoselist, tagmultiplicity);
+    makeReducedJacobian(jacobianentries, jacobianconstraintmap, pdiagnoselist, tagmultiplicity);
+    int jacobianrows = static_cast<int>(clist.size());
+    int jacobiancols = static_cast<int>(pdiagnoselist.size());
 
     // QR decomposition method selection: SparseQR vs DenseQR
 
@@ -3886,10 +3927,8 @@ SolverReportingManager::Manager().LogToFile("GCS::System::diagnose()\n");
     Eigen::SparseMatrix<double> SJ;
 
     if(qrAlgorithm==EigenSparseQR){
-        // this creation is not optimized (done using triplets)
-        // however the time this takes is negligible compared to the
-        // time the QR decomposition itself takes
-        SJ = J.sparseView();
+        SJ.resize(jacobianrows, jacobiancols);
+        SJ.setFromTriplets(jacobianentries.begin(), jacobianentries.end());
         SJ.makeCompressed();
     }
 
@@ -3901,7 +3940,15 @@ SolverReportingManager::Manager().LogToFile("GCS::System::diagnose()\n");
     }
 #endif
 
-
+#ifndef _GCS_DEBUG
+    if(qrAlgorithm==EigenDenseQR)
+#endif
+    {
+        J.setZero(jacobianrows, jacobiancols);
+        for (std::vector<Eigen::Triplet<double> >::const_iterator it=jacobianentries.begin();
+             it != jacobianentries.end(); ++it)
+            J(it->row(), it->col()) = it->value();
+    }
 
 #ifdef _GCS_DEBUG
     SolverReportingManager::Manager().LogMatrix("J",J);
@@ -3921,7 +3968,7 @@ SolverReportingManager::Manager().LogToFile("GCS::System::diagnose()\n");
     Eigen::FullPivHouseholderQR<Eigen::MatrixXd> qrJT;
 
     if(qrAlgorithm==EigenDenseQR){
-        if (J.rows() > 0) {
+        if (jacobianrows > 0) {
             qrJT.compute(J.topRows(jacobianconstraintmap.size()).transpose());
             //Eigen::MatrixXd Q = qrJT.matrixQ ();
 
@@ -3983,7 +4030,7 @@ SolverReportingManager::Manager().LogToFile("GCS::System::diagnose()\n");
         SolverReportingManager::Manager().LogQRSystemInformation(*this, paramsNum, constrNum, rank);
     }
 
-    if (J.rows() > 0) {
+    if (jacobianrows > 0) {
 #ifdef _GCS_DEBUG_SOLVER_JACOBIAN_QR_DECOMPOSITION_TRIANGULAR_MATRIX
         SolverReportingManager::Manager().LogMatrix("R", R);
 
@@ -258,23 +258,71 @@ void SubSystem::calcJacobi()
 }
 */
 
-void SubSystem::calcJacobi(VEC_pD &params, Eigen::MatrixXd &jacobi)
+void SubSystem::calcJacobi(VEC_pD &params, std::vector<Eigen::Triplet<double> > &jacobi)
 {
-    jacobi.setZero(csize, params.size());
-    for (int j=0; j < int(params.size()); j++) {
+    // Each constraint depends on a few parameters only, so the gradient is only
+    // evaluated for the parameters of the c2p adjacency list. The columns of a
+    // parameter in pvals are chained because the reduction map can redirect
+    // several parameters to the same value.
+    std::vector<int> column(psize, -1), nextcolumn(params.size(), -1);
+    for (int j=int(params.size())-1; j >= 0; j--) {
         MAP_pD_pD::const_iterator
           pmapfind = pmap.find(params[j]);
-        if (pmapfind != pmap.end())
-            for (int i=0; i < csize; i++)
-                jacobi(i,j) = clist[i]->grad(pmapfind->second);
+        if (pmapfind != pmap.end()) {
+            int k = static_cast<int>(pmapfind->second - pvals.data());
+            nextcolumn[j] = column[k];
+            column[k] = j;
+        }
+    }
+
+    jacobi.clear();
+    for (int i=0; i < csize; i++) {
+        std::map<Constraint *,VEC_pD >::const_iterator
+          c2pfind = c2p.find(clist[i]);
+        if (c2pfind == c2p.end())
+            continue;
+        for (VEC_pD::const_iterator p=c2pfind->second.begin();
+             p != c2pfind->second.end(); ++p) {
+            int k = static_cast<int>(*p - pvals.data());
+            if (column[k] < 0)
+                continue;
+            double value = clist[i]->grad(*p);
+            for (int j=column[k]; j >= 0; j=nextcolumn[j])
+                jacobi.push_back(Eigen::Triplet<double>(i, j, value));
+        }
     }
 }
 
+void SubSystem::calcJacobi(VEC_pD &params, Eigen::MatrixXd &jacobi)
+{
+    std::vector<Eigen::Triplet<double> > entries;
+    calcJacobi(params, entries);
+
+    jacobi.setZero(csize, params.size());
+    for (std::vector<Eigen::Triplet<double> >::const_iterator it=entries.begin();
+         it != entries.end(); ++it)
+        jacobi(it->row(), it->col()) = it->value();
+}
+
 void SubSystem::calcJacobi(Eigen::MatrixXd &jacobi)
 {
     calcJacobi(plist, jacobi);
 }
 
+void SubSystem::calcJacobi(VEC_pD &params, Eigen::SparseMatrix<double> &jacobi)
+{
+    std::vector<Eigen::Triplet<double> > entries;
+    calcJacobi(params, entries);
+
+    jacobi.resize(csize, params.size());
+    jacobi.setFromTriplets(entries.begin(), entries.end());
+}
+
+void SubSystem::calcJacobi(Eigen::SparseMatrix<double> &jacobi)
+{
+    calcJacobi(plist, jacobi);
+}
+
 void SubSystem::calcGrad(VEC_pD &params, Eigen::VectorXd &grad)
 {
     assert(grad.size() == int(params.size()));
@@ -285,7 +333,7 @@ void SubSystem::calcGrad(VEC_pD &params, Eigen::VectorXd &grad)
           pmapfind = pmap.find(params[j]);
         if (pmapfind != pmap.end()) {
             // assert(p2c.find(pmapfind->second) != p2c.end());
-            std::vector<Constraint *> constrs=p2c[pmapfind->second];
+            const std::vector<Constraint *> &constrs=p2c[pmapfind->second];
             for (std::vector<Constraint *>::const_iterator constr = constrs.begin();
                  constr != constrs.end(); ++constr)
                 grad[j] += (*constr)->error() * (*constr)->grad(pmapfind->second);
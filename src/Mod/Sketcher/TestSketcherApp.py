@@ -209,6 +209,32 @@ class SketcherSolverTestCases(unittest.TestCase):
 		self.Doc2.recompute()
 		self.failUnless(len(values) == 0)
 		FreeCAD.closeDocument("Issue3245")
+
+	def testGaussStepRectangles(self):
+		# A fully constrained sketch has a unique solution, so the sparse QR Gauss-Newton
+		# step of DogLeg must end where the dense LU did. Every rectangle has 12 constraints,
+		# the last two are its height and width as none of them is a square.
+		sketch = self.Doc.addObject('Sketcher::SketchObject','SketchGauss')
+		for i in range(10):
+			CreateRectangleSketch(sketch, [i*20, 0], [16, 3+i])
+		self.Doc.recompute()
+		for i in range(10):
+			sketch.setDatum(i*12+10, App.Units.Quantity('{} mm'.format(8+i)))
+			sketch.setDatum(i*12+11, App.Units.Quantity('15 mm'))
+		self.assertEqual(sketch.solve(), 0)
+		for i in range(10):
+			self.assertTrue(sketch.getPoint(i*4, 1).isEqual(App.Vector(i*20, 8+i, 0), 1e-7))
+			self.assertTrue(sketch.getPoint(i*4, 2).isEqual(App.Vector(i*20+15, 8+i, 0), 1e-7))
+
+	def testGaussStepTangentCircle(self):
+		sketch = self.Doc.addObject('Sketcher::SketchObject','SketchGauss')
+		CreateRectangleSketch(sketch, [0, 0], [30, 20])
+		sketch.addGeometry(Part.Circle(App.Vector(24,7,0), App.Vector(0,0,1), 4), False)
+		sketch.addConstraint(Sketcher.Constraint('Tangent', 4, 1))
+		sketch.addConstraint(Sketcher.Constraint('Tangent', 4, 2))
+		sketch.addConstraint(Sketcher.Constraint('Radius', 4, 5))
+		self.assertEqual(sketch.solve(), 0)
+		self.assertTrue(sketch.getPoint(4, 3).isEqual(App.Vector(25, 5, 0), 1e-7))
 	
 	def tearDown(self):
 		#closing doc
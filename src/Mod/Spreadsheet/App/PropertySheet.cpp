@@ -73,6 +73,8 @@ void PropertySheet::clear()
     cellToPropertyNameMap.clear();
     documentObjectToCellMap.clear();
     cellToDocumentObjectMap.clear();
+    cellToDependantCellMap.clear();
+    dependantCellToCellMap.clear();
     aliasProp.clear();
     revAliasProp.clear();
 
@@ -200,6 +202,8 @@ PropertySheet::PropertySheet(const PropertySheet &other)
     , cellToPropertyNameMap(other.cellToPropertyNameMap)
     , documentObjectToCellMap(other.documentObjectToCellMap)
     , cellToDocumentObjectMap(other.cellToDocumentObjectMap)
+    , cellToDependantCellMap(other.cellToDependantCellMap)
+    , dependantCellToCellMap(other.dependantCellToCellMap)
     , aliasProp(other.aliasProp)
     , revAliasProp(other.revAliasProp)
     , updateCount(other.updateCount)
@@ -1040,6 +1044,17 @@ void PropertySheet::addDependencies(CellAddress key)
                     // Insert into maps
                     propertyNameToCellMap[propName].insert(key);
                     cellToPropertyNameMap[key].insert(propName);
+
+                    cellToDependantCellMap[j->second].insert(key);
+                    dependantCellToCellMap[key].insert(j->second);
+                }
+                else {
+                    CellAddress addr = stringToAddress(props.first.c_str(), true);
+                    if (addr.isValid()) {
+                        addr = CellAddress(addr.row(), addr.col());
+                        cellToDependantCellMap[addr].insert(key);
+                        dependantCellToCellMap[key].insert(addr);
+                    }
                 }
             }
         }
@@ -1075,6 +1090,25 @@ void PropertySheet::removeDependencies(CellAddress key)
         cellToPropertyNameMap.erase(i1);
     }
 
+    /* Remove from Cell <-> Cell maps */
+
+    std::map<CellAddress, std::set< CellAddress > >::iterator i3 = dependantCellToCellMap.find(key);
+
+    if (i3 != dependantCellToCellMap.end()) {
+        for (const auto &addr : i3->second) {
+            std::map<CellAddress, std::set< CellAddress > >::iterator k = cellToDependantCellMap.find(addr);
+
+            if (k != cellToDependantCellMap.end()) {
+                k->second.erase(key);
+
+                if (k->second.size() == 0)
+                    cellToDependantCellMap.erase(k);
+            }
+        }
+
+        dependantCellToCellMap.erase(i3);
+    }
+
     /* Remove from DocumentObject <-> Key maps */
 
     std::map<CellAddress, std::set< std::string > >::iterator i2 = cellToDocumentObjectMap.find(key);
@@ -1265,6 +1299,17 @@ const std::set<std::string> &PropertySheet::getDeps(CellAddress pos) const
         return empty;
 }
 
+const std::set<CellAddress> &PropertySheet::getCellDependants(CellAddress pos) const
+{
+    static std::set<CellAddress> empty;
+    std::map<CellAddress, std::set< CellAddress > >::const_iterator i = cellToDependantCellMap.find(pos);
+
+    if (i != cellToDependantCellMap.end())
+        return i->second;
+    else
+        return empty;
+}
+
 void PropertySheet::recomputeDependencies(CellAddress key)
 {
     AtomicPropertyChange signaller(*this);
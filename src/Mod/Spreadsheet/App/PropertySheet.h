@@ -152,6 +152,9 @@ public:
 
     const std::set<std::string> &getDeps(App::CellAddress pos) const;
 
+    /// Returns the cells of this sheet that directly depend on the cell at \a pos
+    const std::set<App::CellAddress> &getCellDependants(App::CellAddress pos) const;
+
     void recomputeDependencies(App::CellAddress key);
 
     PyObject *getPyObject(void) override;
@@ -247,6 +250,16 @@ private:
     /*! DocumentObject this cell depends on */
     std::map<App::CellAddress, std::set< std::string > > cellToDocumentObjectMap;
 
+    /*! Cell dependency graph of this sheet, i.e. when the cell given in key
+      changes, the set of addresses needs to be recomputed. It is kept up to date
+      together with the maps above, so that the owner doesn't have to look up
+      cells by property name when recomputing.
+      */
+    std::map<App::CellAddress, std::set< App::CellAddress > > cellToDependantCellMap;
+
+    /*! Cells of this sheet a cell depends on */
+    std::map<App::CellAddress, std::set< App::CellAddress > > dependantCellToCellMap;
+
     /*! Mapping of cell position to alias property */
     std::map<App::CellAddress, std::string> aliasProp;
 
@@ -30,7 +30,8 @@
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm/copy.hpp>
 #include <boost/assign.hpp>
-#include <boost/graph/topological_sort.hpp>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/strong_components.hpp>
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/DynamicProperty.h>
@@ -53,7 +54,12 @@
 #include <string>
 #include <iomanip>
 #include <boost/regex.hpp>
-#include <deque>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <QRunnable>
+#include <QThreadPool>
 
 FC_LOG_LEVEL_INIT("Spreadsheet",true,true)
 
@@ -662,10 +668,11 @@ struct CurrentAddressLock {
   * Update the Property given by \a key. This will also eventually trigger recomputations of cells depending on \a key.
   *
   * @param key The address of the cell we want to recompute.
+  * @param value The already evaluated numeric value of the cell expression, or 0.
   *
   */
 
-void Sheet::updateProperty(CellAddress key)
+void Sheet::updateProperty(CellAddress key, const Expression::NativeValue *value)
 {
     Cell * cell = getCell(key);
 
@@ -673,7 +680,10 @@ void Sheet::updateProperty(CellAddress key)
         std::unique_ptr<Expression> output;
         const Expression * input = cell->getExpression();
 
-        if (input) {
+        if (input && value) {
+            output.reset(new NumberExpression(this, value->quantity));
+        }
+        else if (input) {
             CurrentAddressLock lock(currentRow,currentCol,key);
             output.reset(input->eval());
         }
@@ -755,9 +765,10 @@ void Sheet::touchCells(Range range) {
 /**
  * @brief Recompute cell at address \a p.
  * @param p Address of cell.
+ * @param value Already evaluated numeric value of the cell, or 0.
  */
 
-void Sheet::recomputeCell(CellAddress p)
+void Sheet::recomputeCell(CellAddress p, const Expression::NativeValue *value)
 {
     Cell * cell = cells.getValue(p);
 
@@ -768,7 +779,7 @@ void Sheet::recomputeCell(CellAddress p)
             cell->setContent(content.c_str());
         }
 
-        updateProperty(p);
+        updateProperty(p, value);
 
         if(!cell || !cell->hasException()) {
             cells.clearDirty(p);
@@ -798,9 +809,147 @@ void Sheet::recomputeCell(CellAddress p)
         cellSpanChanged(p);
 }
 
+namespace {
+
+// Runs the native evaluation of a level of cells inside QThreadPool
+class NativeEvalTask : public QRunnable
+{
+public:
+    explicit NativeEvalTask(std::function<void()> &&func)
+        :func(std::move(func))
+    {}
+
+    void run() override {
+        func();
+    }
+
+private:
+    std::function<void()> func;
+};
+
+// Shared by the calling thread and the pool tasks evaluating one level of
+// cells. Each participant grabs chunks of expressions until none is left.
+struct NativeEvalState {
+    std::vector<const Expression*> expressions;
+    std::vector<Expression::NativeValue> values;
+    std::vector<char> valid;
+    std::atomic<std::size_t> next;
+    std::mutex mutex;
+    std::condition_variable cond;
+    int running = 0;
+    bool closed = false;
+
+    explicit NativeEvalState(std::vector<const Expression*> &&exprs)
+        :expressions(std::move(exprs))
+        ,values(expressions.size())
+        ,valid(expressions.size(),0)
+        ,next(0)
+    {}
+
+    void evaluate() {
+        const std::size_t chunk = 64;
+        for(;;) {
+            std::size_t begin = next.fetch_add(chunk);
+            if(begin >= expressions.size())
+                break;
+            std::size_t end = std::min(begin+chunk, expressions.size());
+            for(std::size_t i=begin; i<end; ++i) {
+                try {
+                    // Boolean results are stored as Python objects, leave
+                    // them to the serial evaluation
+                    valid[i] = expressions[i]->getNativeValue(values[i])
+                        && values[i].type != Expression::NativeValue::TypeBool;
+                } catch (...) {
+                    valid[i] = 0;
+                }
+            }
+        }
+    }
+};
+
+// Evaluates the expressions of the state without Python, using the global
+// thread pool for large levels. The calling thread takes part in the
+// evaluation, and only waits for the tasks that have already started. So it
+// is safe to call from a pool thread, e.g. during a parallel recompute.
+void evaluateNative(const std::shared_ptr<NativeEvalState> &state)
+{
+    QThreadPool *pool = QThreadPool::globalInstance();
+    int threads = std::min<int>(pool->maxThreadCount(), state->expressions.size()/256);
+    for(int i=1; i<threads; ++i) {
+        std::shared_ptr<NativeEvalState> s(state);
+        pool->start(new NativeEvalTask([s]() {
+            {
+                std::lock_guard<std::mutex> lock(s->mutex);
+                if(s->closed)
+                    return;
+                ++s->running;
+            }
+            s->evaluate();
+            std::lock_guard<std::mutex> lock(s->mutex);
+            --s->running;
+            s->cond.notify_all();
+        }));
+    }
+
+    state->evaluate();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->closed = true;
+    state->cond.wait(lock, [&]() {return state->running == 0;});
+}
+
+} // anonymous namespace
+
+/**
+ * @brief Recompute the cells at \a addresses, which must not depend on each other.
+ *
+ * Purely numeric cell expressions are evaluated first, in parallel and without
+ * Python. All properties are then updated in the calling thread, in the given
+ * order. Any other cell is evaluated as usual by recomputeCell().
+ *
+ * @param addresses Addresses of the cells.
+ */
+
+void Sheet::recomputeCells(const std::vector<CellAddress> &addresses)
+{
+    std::vector<const Expression*> exprs;
+    std::vector<int> exprIndex(addresses.size(), -1);
+
+    for(std::size_t i=0; i<addresses.size(); ++i) {
+        Cell * cell = cells.getValue(addresses[i]);
+        // Cells with an exception must be parsed again, see recomputeCell()
+        if(cell && !cell->hasException() && cell->getExpression()) {
+            exprIndex[i] = static_cast<int>(exprs.size());
+            exprs.push_back(cell->getExpression());
+        }
+    }
+
+    std::shared_ptr<NativeEvalState> state;
+    if(exprs.size()) {
+        state = std::make_shared<NativeEvalState>(std::move(exprs));
+        evaluateNative(state);
+    }
+
+    for(std::size_t i=0; i<addresses.size(); ++i) {
+        const auto &addr = addresses[i];
+        FC_LOG(addr.toString());
+        int idx = exprIndex[i];
+        if(idx >= 0 && state->valid[idx])
+            recomputeCell(addr, &state->values[idx]);
+        else
+            recomputeCell(addr);
+    }
+}
+
 /**
   * Update the document properties.
   *
+  * The dirty cells and all cells depending on them are recomputed level by
+  * level, using the cell dependency graph maintained by PropertySheet. Cells
+  * of the same level don't depend on each other, and are evaluated together
+  * by recomputeCells(). Cells that are part of, or depend on, a dependency
+  * cycle are flagged with an error instead.
+  *
   */
 
 DocumentObjectExecReturn *Sheet::execute(void)
@@ -817,116 +966,117 @@ DocumentObjectExecReturn *Sheet::execute(void)
          dirtyCells.insert(*i);
     }
 
-    DependencyList graph;
-    std::map<CellAddress, Vertex> VertexList;
-    std::map<Vertex, CellAddress> VertexIndexList;
-    std::deque<CellAddress> workQueue(dirtyCells.begin(),dirtyCells.end());
-    while(workQueue.size()) {
-        CellAddress currPos = workQueue.front();
-        workQueue.pop_front();
-
-        // Insert into map of CellPos -> Index, if it doesn't exist already
-        auto res = VertexList.emplace(currPos,Vertex());
-        if(res.second) {
-            res.first->second = add_vertex(graph);
-            VertexIndexList[res.first->second] = currPos;
+    // Collect the cells depending on the dirty cells, and number all of them
+    std::vector<CellAddress> affected(dirtyCells.begin(), dirtyCells.end());
+    std::map<CellAddress, int> cellIndex;
+    for(std::size_t i=0; i<affected.size(); ++i)
+        cellIndex.emplace(affected[i], static_cast<int>(i));
+
+    std::vector<std::vector<int> > dependants;
+    for(std::size_t i=0; i<affected.size(); ++i) {
+        std::vector<int> edges;
+        for(auto &dep : cells.getCellDependants(affected[i])) {
+            auto res = cellIndex.emplace(dep, static_cast<int>(affected.size()));
+            if(res.second)
+                affected.push_back(dep);
+            edges.push_back(res.first->second);
         }
+        dependants.push_back(std::move(edges));
+    }
+
+    // Recompute the cells in levels, a cell is ready as soon as all the cells
+    // it depends on are done
+    std::vector<int> pending(affected.size(), 0);
+    for(auto &edges : dependants) {
+        for(int dep : edges)
+            ++pending[dep];
+    }
 
-        // Process cells that depend on the current cell
-        for(auto &dep : providesTo(currPos)) {
-            auto resDep = VertexList.emplace(dep,Vertex());
-            if(resDep.second) {
-                resDep.first->second = add_vertex(graph);
-                VertexIndexList[resDep.first->second] = dep;
-                if(dirtyCells.insert(dep).second)
-                    workQueue.push_back(dep);
+    std::vector<int> level;
+    for(std::size_t i=0; i<affected.size(); ++i) {
+        if(pending[i] == 0)
+            level.push_back(static_cast<int>(i));
+    }
+
+    FC_LOG("recomputing " << getFullName());
+    std::size_t done = 0;
+    std::vector<CellAddress> addresses;
+    while(level.size()) {
+        addresses.clear();
+        for(int i : level)
+            addresses.push_back(affected[i]);
+        recomputeCells(addresses);
+        done += level.size();
+
+        std::vector<int> next;
+        for(int i : level) {
+            for(int dep : dependants[i]) {
+                if(--pending[dep] == 0)
+                    next.push_back(dep);
             }
-            // Add edge to graph to signal dependency
-            add_edge(res.first->second, resDep.first->second, graph);
         }
+        level.swap(next);
     }
-    // Compute cells
-    std::list<Vertex> make_order;
-    // Sort graph topologically to find evaluation order
-    try {
-        boost::topological_sort(graph, std::front_inserter(make_order));
-        // Recompute cells
-        FC_LOG("recomputing " << getFullName());
-        for(auto &pos : make_order) {
-            const auto &addr = VertexIndexList[pos];
-            FC_LOG(addr.toString());
-            recomputeCell(addr);
-        }
-    } catch (std::exception &) {
-        for(auto &v : VertexList) {
-            Cell * cell = cells.getValue(v.first);
-            // Mark as erroneous
-            if(cell)  {
-                cellErrors.insert(v.first);
-                cell->setException("Pending computation due to cyclic dependency",true);
-                cellUpdated(v.first);
+
+    if(done < affected.size()) {
+        // The remaining cells are part of a cycle, or depend on one. Find the
+        // individual cycles to be more user friendly.
+        std::vector<int> remaining;
+        std::vector<int> vertexIndex(affected.size(), -1);
+        for(std::size_t i=0; i<affected.size(); ++i) {
+            if(pending[i]) {
+                vertexIndex[i] = static_cast<int>(remaining.size());
+                remaining.push_back(static_cast<int>(i));
             }
         }
 
-        // Try to be more user friendly by finding individual loops
-        while(dirtyCells.size()) {
-
-            std::deque<CellAddress> workQueue;
-            DependencyList graph;
-            std::map<CellAddress, Vertex> VertexList;
-            std::map<Vertex, CellAddress> VertexIndexList;
-
-            CellAddress currentAddr = *dirtyCells.begin();
-            workQueue.push_back(currentAddr);
-            dirtyCells.erase(dirtyCells.begin());
-
-            while (workQueue.size() > 0) {
-                CellAddress currPos = workQueue.front();
-                workQueue.pop_front();
+        DependencyList graph(remaining.size());
+        std::vector<bool> selfDependant(remaining.size(), false);
+        for(std::size_t v=0; v<remaining.size(); ++v) {
+            for(int dep : dependants[remaining[v]]) {
+                add_edge(v, vertexIndex[dep], graph);
+                if(vertexIndex[dep] == static_cast<int>(v))
+                    selfDependant[v] = true;
+            }
+        }
 
-                // Insert into map of CellPos -> Index, if it doesn't exist already
-                auto res = VertexList.emplace(currPos,Vertex());
-                if(res.second) {
-                    res.first->second = add_vertex(graph);
-                    VertexIndexList[res.first->second] = currPos;
-                }
+        std::vector<int> component(remaining.size());
+        int count = boost::strong_components(graph, boost::make_iterator_property_map(
+                    component.begin(), boost::get(boost::vertex_index, graph)));
 
-                // Process cells that depend on the current cell
-                for(auto &dep : providesTo(currPos)) {
-                    auto resDep = VertexList.emplace(dep,Vertex());
-                    if(resDep.second) {
-                        resDep.first->second = add_vertex(graph);
-                        VertexIndexList[resDep.first->second] = dep;
-                        workQueue.push_back(dep);
-                        dirtyCells.erase(dep);
-                    }
-                    // Add edge to graph to signal dependency
-                    add_edge(res.first->second, resDep.first->second, graph);
-                }
-            }
+        std::vector<std::vector<int> > members(count);
+        for(std::size_t v=0; v<remaining.size(); ++v)
+            members[component[v]].push_back(static_cast<int>(v));
 
-            std::list<Vertex> make_order;
-            try {
-                boost::topological_sort(graph, std::front_inserter(make_order));
-            } catch (std::exception&) {
+        for(auto &vertices : members) {
+            std::string msg("Pending computation due to cyclic dependency");
+            if(vertices.size() > 1 || selfDependant[vertices.front()]) {
                 // Cycle detected; flag all with errors
                 std::ostringstream ss;
                 ss << "Cyclic dependency";
-                int count = 0;
-                for(auto &v : VertexList) {
-                    if(count++%20 == 0)
+                std::vector<CellAddress> cycle;
+                for(int v : vertices)
+                    cycle.push_back(affected[remaining[v]]);
+                std::sort(cycle.begin(), cycle.end());
+                int n = 0;
+                for(auto &addr : cycle) {
+                    if(n++%20 == 0)
                         ss << std::endl;
                     else
                         ss << ", ";
-                    ss << v.first.toString();
+                    ss << addr.toString();
                 }
-                std::string msg = ss.str();
-                for(auto &v : VertexList) {
-                    Cell * cell = cells.getValue(v.first);
-                    if (cell) {
-                        cell->setException(msg.c_str(),true);
-                        cellUpdated(v.first);
-                    }
+                msg = ss.str();
+            }
+
+            for(int v : vertices) {
+                const auto &addr = affected[remaining[v]];
+                Cell * cell = cells.getValue(addr);
+                // Mark as erroneous
+                if(cell) {
+                    cellErrors.insert(addr);
+                    cell->setException(msg.c_str(),true);
+                    cellUpdated(addr);
                 }
             }
         }
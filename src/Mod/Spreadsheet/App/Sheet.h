@@ -197,7 +197,9 @@ protected:
 
     void onDocumentRestored();
 
-    void recomputeCell(App::CellAddress p);
+    void recomputeCell(App::CellAddress p, const App::Expression::NativeValue *value = 0);
+
+    void recomputeCells(const std::vector<App::CellAddress> &addresses);
 
     App::Property *getProperty(App::CellAddress key) const;
 
@@ -205,7 +207,7 @@ protected:
 
     void updateAlias(App::CellAddress key);
 
-    void updateProperty(App::CellAddress key);
+    void updateProperty(App::CellAddress key, const App::Expression::NativeValue *value = 0);
 
     App::Property *setStringProperty(App::CellAddress key, const std::string & value) ;
 
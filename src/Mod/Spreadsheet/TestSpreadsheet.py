@@ -1069,6 +1069,30 @@ class SpreadsheetCases(unittest.TestCase):
         self.doc.recompute()
         self.assertEqual(sheet.C1, 3)
 
+    def testDependencyOrder(self):
+        """ Cells are recomputed after the cells they depend on; a cycle only blocks the cells depending on it """
+        sheet = self.doc.addObject('Spreadsheet::Sheet','Spreadsheet')
+        sheet.set('A1', '1')
+        for i in range(2, 1001):
+            sheet.set('A%d' % i, '=A%d + 1' % (i - 1))
+            sheet.set('B%d' % i, '=A1 * %d mm' % i)
+        sheet.set('C1', '=C2 + 1')
+        sheet.set('C2', '=C1 + 1')
+        sheet.set('C3', '=C2 + A1')
+        self.doc.recompute()
+        self.assertEqual(sheet.A1000, 1000)
+        self.assertEqual(sheet.B500, Units.Quantity('500 mm'))
+        self.assertIn('Invalid', sheet.State)
+
+        sheet.set('A1', '2')
+        sheet.set('C2', '1')
+        self.doc.recompute()
+        self.assertEqual(sheet.A1000, 1001)
+        self.assertEqual(sheet.B500, Units.Quantity('1000 mm'))
+        self.assertEqual(sheet.C1, 2)
+        self.assertEqual(sheet.C3, 3)
+        self.assertNotIn('Invalid', sheet.State)
+
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument(self.doc.Name)
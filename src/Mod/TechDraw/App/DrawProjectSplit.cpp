@@ -65,8 +65,17 @@
 #include <limits>
 #include <algorithm>
 #include <cmath>
+#include <exception>
+#include <iomanip>
+#include <numeric>
+#include <string>
+#include <utility>
 #include <GeomLib_Tool.hxx>
 
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <QtConcurrentMap>
+
 #include <App/Application.h>
 #include <Base/BoundBox.h>
 #include <Base/Console.h>
@@ -170,63 +179,7 @@ std::vector<TopoDS_Edge> DrawProjectSplit::getEdges(TechDraw::GeometryObject* ge
 
     //HLR algo does not provide all edge intersections for edge endpoints.
     //need to split long edges touched by Vertex of another edge
-    std::vector<splitPoint> splits;
-    std::vector<TopoDS_Edge>::iterator itOuter = origEdges.begin();
-    int iOuter = 0;
-    for (; itOuter != origEdges.end(); ++itOuter, iOuter++) {
-        TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
-        TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::Add(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
-            Base::Console().Message("DPS::Extract Faces - outer Bnd_Box is void\n");
-            continue;
-        }
-        if (DrawUtil::isZeroEdge(*itOuter)) {
-            Base::Console().Message("DPS::extractFaces - outerEdge: %d is ZeroEdge\n",iOuter);   //this is not finding ZeroEdges
-            continue;  //skip zero length edges. shouldn't happen ;)
-        }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = faceEdges.begin();
-        for (; itInner != faceEdges.end(); ++itInner,iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
-                continue;  //skip zero length edges. shouldn't happen ;)
-            }
-
-            Bnd_Box sInner;
-            BRepBndLib::Add(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
-                Base::Console().Log("INFO - DPS::Extract Faces - inner Bnd_Box is void\n");
-                continue;
-            }
-            if (sOuter.IsOut(sInner)) {      //bboxes of edges don't intersect, don't bother
-                continue;
-            }
-
-            double param = -1;
-            if (isOnEdge((*itInner),v1,param,false)) {
-                gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
-                splitPoint s1;
-                s1.i = iInner;
-                s1.v = Base::Vector3d(pnt1.X(),pnt1.Y(),pnt1.Z());
-                s1.param = param;
-                splits.push_back(s1);
-            }
-            if (isOnEdge((*itInner),v2,param,false)) {
-                gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
-                splitPoint s2;
-                s2.i = iInner;
-                s2.v = Base::Vector3d(pnt2.X(),pnt2.Y(),pnt2.Z());
-                s2.param = param;
-                splits.push_back(s2);
-            }
-        } //inner loop
-    }   //outer loop
+    std::vector<splitPoint> splits = findSplitPoints(origEdges);
 
     std::vector<splitPoint> sorted = sortSplits(splits,true);
     auto last = std::unique(sorted.begin(), sorted.end(), DrawProjectSplit::splitEqual);  //duplicates to back
@@ -241,12 +194,83 @@ std::vector<TopoDS_Edge> DrawProjectSplit::getEdges(TechDraw::GeometryObject* ge
 }
 
 
+namespace {
+
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+typedef bg::model::point<double, 3, bg::cs::cartesian> RPoint;
+typedef bg::model::box<RPoint> RBox;
+typedef std::pair<RBox, int> RValue;
+typedef bgi::rtree<RValue, bgi::linear<16> > RTree;
+
+//console output of the workers, printed once they are done. true for errors
+typedef std::vector<std::pair<bool, std::string> > Messages;
+
+void printMessages(const Messages& messages)
+{
+    for (auto& m : messages) {
+        if (m.first) {
+            Base::Console().Error("%s", m.second.c_str());
+        } else {
+            Base::Console().Message("%s", m.second.c_str());
+        }
+    }
+}
+
+//DrawUtil::simpleMinDist without printing to the console
+double minDist(const TopoDS_Shape& s1, const TopoDS_Shape& s2, Messages& messages)
+{
+    BRepExtrema_DistShapeShape extss(s1, s2);
+    if (!extss.IsDone()) {
+        messages.emplace_back(false, "DU::simpleMinDist - BRepExtrema_DistShapeShape failed");
+        return -1;
+    }
+    if (extss.NbSolution() == 0) {
+        return -1;
+    }
+    return extss.Value();
+}
+
+//the part of isOnEdge that runs after the bounding box test
+//note param gets modified here
+bool isOnCurve(const TopoDS_Edge& e, const TopoDS_Vertex& v, double& param, bool allowEnds,
+               Messages& messages)
+{
+    bool result = false;
+    double dist = minDist(v,e,messages);
+    if (dist < 0.0) {
+        std::stringstream ss;
+        ss << "DPS::isOnEdge - simpleMinDist failed: " << std::fixed << std::setprecision(3) << dist << "\n";
+        messages.emplace_back(true, ss.str());
+        result = false;
+    } else if (dist < Precision::Confusion()) {
+        const gp_Pnt pt = BRep_Tool::Pnt(v);                         //have to duplicate method 3 to get param
+        BRepAdaptor_Curve adapt(e);
+        const Handle(Geom_Curve) c = adapt.Curve().Curve();
+        double maxDist = 0.000001;     //magic number.  less than this gives false positives.
+        //bool found =
+        (void) GeomLib_Tool::Parameter(c,pt,maxDist,param);  //already know point it on curve
+        result = true;
+    }
+    if (result) {
+        TopoDS_Vertex v1 = TopExp::FirstVertex(e);
+        TopoDS_Vertex v2 = TopExp::LastVertex(e);
+        if (DrawUtil::isSamePoint(v,v1) || DrawUtil::isSamePoint(v,v2)) {
+            if (!allowEnds) {
+                result = false;
+            }
+        }
+    }
+    return result;
+}
+
+}
+
 //this routine is the big time consumer.  gets called many times (and is slow?))
 //note param gets modified here
 bool DrawProjectSplit::isOnEdge(TopoDS_Edge e, TopoDS_Vertex v, double& param, bool allowEnds)
 {
-    bool result = false;
-    bool outOfBox = false;
     param = -2;
 
     //eliminate obvious cases
@@ -258,33 +282,103 @@ bool DrawProjectSplit::isOnEdge(TopoDS_Edge e, TopoDS_Vertex v, double& param, b
     } else {
         gp_Pnt pt = BRep_Tool::Pnt(v);
         if (sBox.IsOut(pt)) {
-            outOfBox = true;
+            return false;
         }
     }
-    if (!outOfBox) {
-            double dist = DrawUtil::simpleMinDist(v,e);
-            if (dist < 0.0) {
-                Base::Console().Error("DPS::isOnEdge - simpleMinDist failed: %.3f\n",dist);
-                result = false;
-            } else if (dist < Precision::Confusion()) {
-                const gp_Pnt pt = BRep_Tool::Pnt(v);                         //have to duplicate method 3 to get param
-                BRepAdaptor_Curve adapt(e);
-                const Handle(Geom_Curve) c = adapt.Curve().Curve();
-                double maxDist = 0.000001;     //magic number.  less than this gives false positives.
-                //bool found =
-                (void) GeomLib_Tool::Parameter(c,pt,maxDist,param);  //already know point it on curve
-                result = true;
+    Messages messages;
+    bool result = isOnCurve(e, v, param, allowEnds, messages);
+    printMessages(messages);
+    return result;
+}
+
+//find the points where a vertex of one edge lies on another edge.
+//the bounding boxes are computed once and kept in an R-tree, so each edge is
+//only tested against the edges whose boxes touch its own box. The edges are
+//processed in parallel and the result is in the same order as that of a
+//nested loop over all edges. The console output of the workers is collected
+//per edge and printed afterwards in the same order.
+std::vector<splitPoint> DrawProjectSplit::findSplitPoints(const std::vector<TopoDS_Edge>& edges)
+{
+    int count = static_cast<int>(edges.size());
+    std::vector<Bnd_Box> boxes(count);
+    std::vector<RValue> values;
+    values.reserve(count);
+    for (int i = 0; i < count; i++) {
+        if (DrawUtil::isZeroEdge(edges[i])) {
+            Base::Console().Log("DPS::findSplitPoints - edge: %d is ZeroEdge\n",i);
+            continue;  //skip zero length edges. shouldn't happen ;)
+        }
+        BRepBndLib::Add(edges[i], boxes[i]);
+        boxes[i].SetGap(0.1);
+        if (boxes[i].IsVoid()) {
+            Base::Console().Log("DPS::findSplitPoints - Bnd_Box is void for edge: %d\n",i);
+            continue;
+        }
+        double xMin, yMin, zMin, xMax, yMax, zMax;
+        boxes[i].Get(xMin, yMin, zMin, xMax, yMax, zMax);
+        values.push_back(RValue(RBox(RPoint(xMin, yMin, zMin), RPoint(xMax, yMax, zMax)), i));
+    }
+
+    //the packing constructor gives a better tree than inserting one by one
+    const RTree rtree(values.begin(), values.end());
+
+    std::vector<std::vector<splitPoint> > edgeSplits(values.size());
+    std::vector<Messages> edgeMessages(values.size());
+    std::vector<std::exception_ptr> errors(values.size());
+    std::vector<std::size_t> indices(values.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    QtConcurrent::blockingMap(indices, [&](std::size_t& index) {
+        try {
+            int iOuter = values[index].second;
+            std::vector<int> candidates;
+            for (auto it = rtree.qbegin(bgi::intersects(values[index].first)); it != rtree.qend(); ++it) {
+                if (it->second != iOuter) {
+                    candidates.push_back(it->second);
+                }
             }
-            if (result) {
-                TopoDS_Vertex v1 = TopExp::FirstVertex(e);
-                TopoDS_Vertex v2 = TopExp::LastVertex(e);
-                if (DrawUtil::isSamePoint(v,v1) || DrawUtil::isSamePoint(v,v2)) {
-                    if (!allowEnds) {
-                        result = false;
-                    }
+            std::sort(candidates.begin(), candidates.end());
+
+            TopoDS_Vertex v1 = TopExp::FirstVertex(edges[iOuter]);
+            TopoDS_Vertex v2 = TopExp::LastVertex(edges[iOuter]);
+            gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
+            gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
+            std::vector<splitPoint>& splits = edgeSplits[index];
+            Messages& messages = edgeMessages[index];
+            for (int iInner : candidates) {
+                double param = -1;
+                if (!boxes[iInner].IsOut(pnt1) && isOnCurve(edges[iInner],v1,param,false,messages)) {
+                    splitPoint s1;
+                    s1.i = iInner;
+                    s1.v = Base::Vector3d(pnt1.X(),pnt1.Y(),pnt1.Z());
+                    s1.param = param;
+                    splits.push_back(s1);
+                }
+                if (!boxes[iInner].IsOut(pnt2) && isOnCurve(edges[iInner],v2,param,false,messages)) {
+                    splitPoint s2;
+                    s2.i = iInner;
+                    s2.v = Base::Vector3d(pnt2.X(),pnt2.Y(),pnt2.Z());
+                    s2.param = param;
+                    splits.push_back(s2);
                 }
             }
-    } //!outofbox
+        }
+        catch (...) {
+            errors[index] = std::current_exception();
+        }
+    });
+    for (auto& m : edgeMessages) {
+        printMessages(m);
+    }
+    for (auto& e : errors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+
+    std::vector<splitPoint> result;
+    for (auto& s : edgeSplits) {
+        result.insert(result.end(), s.begin(), s.end());
+    }
     return result;
 }
 
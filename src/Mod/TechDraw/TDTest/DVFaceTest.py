@@ -0,0 +1,61 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# test script for TechDraw module
+# creates two boxes side by side, where a corner of the smaller box lies
+# on an edge of the larger one in the top view
+# creates a page and a view with face detection (HandleFaces)
+# checks the outline, which is only closed if that edge gets split
+from __future__ import print_function
+
+import FreeCAD
+import Part
+import TechDraw
+import os
+
+def DVFaceTest():
+    path = os.path.dirname(os.path.abspath(__file__))
+    print ('TDFace path: ' + path)
+    templateFileSpec = path + '/TestTemplate.svg'
+
+    param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/TechDraw/General")
+    handleFaces = param.GetBool("HandleFaces", True)
+    param.SetBool("HandleFaces", True)
+
+    FreeCAD.newDocument("TDFace")
+    FreeCAD.setActiveDocument("TDFace")
+    FreeCAD.ActiveDocument=FreeCAD.getDocument("TDFace")
+
+    big = Part.makeBox(10, 10, 10)
+    small = Part.makeBox(10, 5, 5, FreeCAD.Vector(10, 0, 0))
+    shape = Part.makeCompound([big, small])
+    feature = FreeCAD.ActiveDocument.addObject("Part::Feature","Boxes")
+    feature.Shape = shape
+
+    page = FreeCAD.ActiveDocument.addObject('TechDraw::DrawPage','Page')
+    FreeCAD.ActiveDocument.addObject('TechDraw::DrawSVGTemplate','Template')
+    FreeCAD.ActiveDocument.Template.Template = templateFileSpec
+    FreeCAD.ActiveDocument.Page.Template = FreeCAD.ActiveDocument.Template
+    print("page created")
+
+    view = FreeCAD.ActiveDocument.addObject('TechDraw::DrawViewPart','View')
+    rc = page.addView(view)
+    view.Source = [feature]
+    view.Direction = FreeCAD.Vector(0, 0, 1)
+
+    FreeCAD.ActiveDocument.recompute()
+
+    rc = "Up-to-date" in view.State
+
+    # the outline runs around both boxes: 20 + 5 + 10 + 5 + 10 + 10
+    outline = TechDraw.findShapeOutline(shape, 1.0, FreeCAD.Vector(0, 0, 1))
+    if outline is None or abs(outline.Length - 60.0) > 1e-6:
+        print("outline not found or of wrong length")
+        rc = False
+
+    FreeCAD.closeDocument("TDFace")
+    param.SetBool("HandleFaces", handleFaces)
+    return rc
+
+if __name__ == '__main__':
+    DVFaceTest()
@@ -32,6 +32,7 @@ from TDTest.DVDimensionTest    import DVDimensionTest
 from TDTest.DVPartTest         import DVPartTest
 from TDTest.DVSectionTest      import DVSectionTest
 from TDTest.DVBalloonTest      import DVBalloonTest
+from TDTest.DVFaceTest         import DVFaceTest
 
 #---------------------------------------------------------------------------
 # define the test cases to test the FreeCAD TechDraw module
@@ -94,3 +95,12 @@ class TechDrawTestCases(unittest.TestCase):
             print("TD DrawViewBalloon test passed")
         else:
             print("TD DrawViewBalloon test failed")
+
+    def testFaceCase(self):
+        print("starting TD DrawViewPart face test")
+        rc = DVFaceTest()
+        if rc:
+            print("TD DrawViewPart face test passed")
+        else:
+            print("TD DrawViewPart face test failed")
+        self.assertTrue(rc)
@@ -157,6 +157,23 @@ class ParameterTestCase(unittest.TestCase):
         self.TestPar.RemString("44")
         self.failUnless(self.TestPar.GetString("44","hallo") == "hallo","Deletion error at String")
 
+    def testCachedValues(self):
+        # values read once must follow later changes, removals and clearing
+        Temp = self.TestPar.GetGroup("45")
+        Temp.SetInt("a",1)
+        Temp.SetFloat("a",1.5)
+        self.failUnless(Temp.GetInt("a") == 1 and Temp.GetFloat("a") == 1.5,"Type mix-up in cached values")
+        Temp.SetInt("a",2)
+        self.failUnless(Temp.GetInt("a") == 2,"Stale cached Int")
+        Temp.RemInt("a")
+        self.failUnless(Temp.GetInt("a",3) == 3,"Removed Int still cached")
+        Temp.SetString("b","abc")
+        self.failUnless(Temp.GetString("b") == "abc","In and out error at cached String")
+        Temp.Clear()
+        self.failUnless(Temp.GetString("b","x") == "x","Cleared String still cached")
+        self.failUnless(Temp.GetFloat("a",2.5) == 2.5,"Cleared Float still cached")
+        self.TestPar.RemGroup("45")
+
     def testMatrix(self):
         m=FreeCAD.Matrix(4,2,1,0,1,1,1,0,0,0,1,0,0,0,0,1)
         u=m.multiply(m.inverse())
@@ -608,6 +608,60 @@ class DocumentRecomputeCases(unittest.TestCase):
     self.Doc.removeObject(L7.Name)
     self.Doc.removeObject(L8.Name)
 
+  def testDependencyOrder(self):
+    L1 = self.Doc.addObject("App::FeatureTest","Label_1")
+    L2 = self.Doc.addObject("App::FeatureTest","Label_2")
+    L3 = self.Doc.addObject("App::FeatureTest","Label_3")
+    L4 = self.Doc.addObject("App::FeatureTest","Label_4")
+
+    # link against creation order to force reordering
+    L1.Link = L2
+    L2.Link = L3
+    L3.LinkList = [L4]
+    deps = FreeCAD.getDependentObjects(L1, 1)
+    self.assertEqual(deps, (L4, L3, L2, L1))
+
+    L3.LinkList = []
+    L4.Link = L1
+    deps = FreeCAD.getDependentObjects(L4, 1)
+    self.assertEqual(deps, (L3, L2, L1, L4))
+    self.assertEqual(FreeCAD.getDependentObjects([L2, L1], 1), (L3, L2, L1))
+
+  def testParallelRecompute(self):
+    param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+    parallel = param.GetBool("ParallelRecompute", False)
+    param.SetBool("ParallelRecompute", True)
+    try:
+      # same dependencies as in testRecompute
+      L1 = self.Doc.addObject("App::FeatureTest","Label_1")
+      L2 = self.Doc.addObject("App::FeatureTest","Label_2")
+      L3 = self.Doc.addObject("App::FeatureTest","Label_3")
+      L4 = self.Doc.addObject("App::FeatureTest","Label_4")
+      L5 = self.Doc.addObject("App::FeatureTest","Label_5")
+      L6 = self.Doc.addObject("App::FeatureTest","Label_6")
+      L1.LinkList = [L2,L3,L6]
+      L2.Link = L4
+      L2.LinkList = [L5]
+      L3.LinkList = [L5,L6]
+
+      self.Doc.recompute()
+      L5.enforceRecompute()
+      self.Doc.recompute()
+      self.assertEqual((2, 2, 2, 0, 1, 0), (L1.ExecCount,L2.ExecCount,L3.ExecCount,L4.ExecCount,L5.ExecCount,L6.ExecCount))
+      L4.enforceRecompute()
+      self.assertEqual(self.Doc.recompute(), 3)
+      self.assertEqual((3, 3, 2, 1, 1, 0), (L1.ExecCount,L2.ExecCount,L3.ExecCount,L4.ExecCount,L5.ExecCount,L6.ExecCount))
+
+      # an error must stop the recompute of all dependent objects
+      L3.ExceptionType = 2
+      L5.enforceRecompute()
+      self.Doc.recompute()
+      self.assertEqual((3, 4, 2, 1, 2, 0), (L1.ExecCount,L2.ExecCount,L3.ExecCount,L4.ExecCount,L5.ExecCount,L6.ExecCount))
+      self.assertTrue("Invalid" in L3.State)
+      self.assertTrue("Touched" in L1.State)
+    finally:
+      param.SetBool("ParallelRecompute", parallel)
+
   def tearDown(self):
     #closing doc
     FreeCAD.closeDocument("RecomputeTests")
@@ -1172,6 +1226,29 @@ class DocumentPlatformCases(unittest.TestCase):
     except:
       pass
 
+  def testManyFiles(self):
+    # the files of the project are compressed in parallel but must keep their order
+    names = []
+    for i in range(20):
+      obj = self.Doc.addObject("App::FeatureTest", "Test")
+      obj.FloatList = [float(i * 1000 + j) for j in range(1000)]
+      names.append(obj.Name)
+
+    # saving and restoring
+    self.Doc.saveAs(self.DocName)
+    FreeCAD.closeDocument("PlatformTests")
+    self.Doc = FreeCAD.open(self.DocName)
+
+    for i, name in enumerate(names):
+      floats = self.Doc.getObject(name).FloatList
+      self.failUnless(len(floats) == 1000)
+      self.failUnless(floats[0] == i * 1000 and floats[-1] == i * 1000 + 999)
+
+    import zipfile
+    with zipfile.ZipFile(self.DocName) as archive:
+      self.failUnless(archive.testzip() is None)
+      self.failUnless(archive.namelist()[0] == "Document.xml")
+
   def tearDown(self):
     #closing doc
     FreeCAD.closeDocument("PlatformTests")
@@ -1408,6 +1485,24 @@ class DocumentExpressionCases(unittest.TestCase):
     # must not raise a topological error
     self.assertEqual(self.Doc.recompute(), 2)
 
+  def testNumericExpression(self):
+    # purely numeric expressions are evaluated natively, check that they
+    # follow the same rules as the Python evaluation
+    self.Obj1.Integer = 7
+    self.Obj1.Float = 2.5
+    self.Obj1.Bool = True
+    self.Obj1.Distance = 10
+    name = self.Obj1.Name
+    self.Obj2.setExpression('Integer', u'%s.Integer %% -3' % name)
+    self.Obj2.setExpression('Float', u'abs(-%s.Float) * 2 ^ 3 + (%s.Bool ? 1 : 0)' % (name,name))
+    self.Obj2.setExpression('Distance', u'%s.Distance * 2 + 1 mm' % name)
+    self.Obj2.setExpression('Bool', u'%s.Integer / 2 > 3' % name)
+    self.Doc.recompute()
+    self.assertEqual(self.Obj2.Integer, -2)
+    self.assertAlmostEqual(self.Obj2.Float, 21.0)
+    self.assertAlmostEqual(self.Obj2.Distance.Value, 21.0)
+    self.assertTrue(self.Obj2.Bool)
+
   def tearDown(self):
     #closing doc
     FreeCAD.closeDocument(self.Doc.Name)
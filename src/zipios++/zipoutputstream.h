@@ -54,6 +54,13 @@ public:
   */
   void putNextEntry(const std::string& entryName);
 
+  /** Writes a complete entry whose data has already been compressed
+      with a raw deflate stream (no zlib header).
+      @see ZipOutputStreambuf::putDeflatedEntry()
+  */
+  void putDeflatedEntry( const std::string &entryName, const char *data,
+                         uint32 compressed_size, uint32 crc, uint32 size ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const std::string& comment ) ;
 